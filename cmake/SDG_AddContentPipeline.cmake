@@ -1,7 +1,17 @@
 # Sets up content pipeline program to build
 # @param AssetDir the relative path to the asset directory from the current CMakeLists's folder
 # @param Key encryption key
+# @param PACK (optional) also packs the processed assets into this .sdgpack file, written in the asset directory
+# @param DAEMON (optional) builds through the content pipeline daemon when one is running, rather than checking
+#   every asset in a new process. Start it with the <project>_ContentWatch target, and leave it running.
 function(AddContentPipeline AssetDir Key)
+    cmake_parse_arguments(ContentPipe "DAEMON" "PACK" "" ${ARGN})
+    if (ContentPipe_PACK)
+        set(ContentPipe_PackArgs --pack ${ContentPipe_PACK})
+    endif()
+    if (ContentPipe_DAEMON)
+        set(ContentPipe_DaemonArgs --connect)
+    endif()
 
     if (EMSCRIPTEN)
         set_target_properties(${PROJECT_NAME} PROPERTIES LINK_FLAGS "--preload-file ${CMAKE_CURRENT_BINARY_DIR}/${AssetDir}@${AssetDir}")
@@ -16,13 +26,21 @@ function(AddContentPipeline AssetDir Key)
 
     set(ContentPipe_AssetDir ${Project_BinaryDir}/${AssetDir})
 
+    set(ContentPipe_Args ${CMAKE_CURRENT_SOURCE_DIR}/${AssetDir} ${ContentPipe_AssetDir} ${Key}
+            ${CMAKE_CURRENT_SOURCE_DIR}/${AssetDir}/assets.json ${ContentPipe_PackArgs})
+
     add_custom_target("${PROJECT_NAME}_Content"
-            COMMAND "${ContentPipe_BinaryDir}/SDG_ContentPipe"
-            ${CMAKE_CURRENT_SOURCE_DIR}/${AssetDir} ${ContentPipe_AssetDir} ${Key} ${CMAKE_CURRENT_SOURCE_DIR}/${AssetDir}/assets.json)
+            COMMAND "${ContentPipe_BinaryDir}/SDG_ContentPipe" ${ContentPipe_Args} ${ContentPipe_DaemonArgs})
     add_dependencies(${PROJECT_NAME} "${PROJECT_NAME}_Content")
 
+    # Runs the daemon in the foreground, processing assets as they change, until interrupted
+    add_custom_target("${PROJECT_NAME}_ContentWatch"
+            COMMAND "${ContentPipe_BinaryDir}/SDG_ContentPipe" ${ContentPipe_Args} --watch
+            USES_TERMINAL)
+
     if (NOT EMSCRIPTEN)
         add_dependencies("${PROJECT_NAME}_Content" SDG_ContentPipe)
+        add_dependencies("${PROJECT_NAME}_ContentWatch" SDG_ContentPipe)
     endif()
 
 endfunction()
@@ -0,0 +1,581 @@
+#include "AtlasPacker.h"
+#include "ContentHash.h"
+#include "MaxRectsBin.h"
+#include "ParallelFor.h"
+#include <Engine/Game/Graphics/AtlasFormat.h>
+#include <lodepng.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace SDG::ContentPipe
+{
+    /// A source image, from reading its file through packing it
+    struct AtlasSource
+    {
+        std::string name;                  ///< relative to the source folder, without extension
+        fs::path path;
+        std::string cacheKey;
+        ContentEntry entry;
+        std::vector<char> bytes;           ///< file content, if it was read to hash it
+
+        std::vector<unsigned char> pixels; ///< RGBA, trimmed
+        unsigned width = 0, height = 0;    ///< trimmed size
+        unsigned trimX = 0, trimY = 0, origWidth = 0, origHeight = 0;
+        size_t rect = 0;                   ///< index of the packed rectangle holding its pixels
+        std::string error;
+    };
+
+    /// Space in a page holding the pixels of one or more identical images
+    struct AtlasRect
+    {
+        size_t source;                     ///< first source with these pixels
+        unsigned width, height;            ///< unrotated
+        unsigned page = 0, x = 0, y = 0;
+        bool rotated = false;
+    };
+
+    /// Places rectangles into square pages, in order, each into the first page with room. Each rectangle takes its
+    /// padding on the right and bottom, so pages are that much larger than their usable size.
+    /// @param maxPages - fails once more pages than this are needed
+    /// @return the size of each page's used area, or nothing if the rectangles did not fit
+    static auto PlaceRects(std::vector<AtlasRect> &rects, const std::vector<size_t> &order, unsigned pageSize,
+        unsigned padding, bool rotate, size_t maxPages) -> std::optional<std::vector<std::pair<unsigned, unsigned>>>
+    {
+        std::vector<MaxRectsBin> bins;
+        std::vector<std::pair<unsigned, unsigned>> pageSizes;
+        for (size_t index : order)
+        {
+            AtlasRect &rect = rects[index];
+            MaxRectsBin::Box placed{};
+            bool rotated = false;
+            size_t page = 0;
+            while (page < bins.size() &&
+                !bins[page].Insert(rect.width + padding, rect.height + padding, rotate, &placed, &rotated))
+                ++page;
+
+            if (page == bins.size())
+            {
+                if (bins.size() == maxPages)
+                    return std::nullopt;
+
+                bins.emplace_back(pageSize, pageSize);
+                pageSizes.emplace_back(0, 0);
+                if (!bins.back().Insert(rect.width + padding, rect.height + padding, rotate, &placed, &rotated))
+                    return std::nullopt;
+            }
+
+            rect.page = (unsigned)page;
+            rect.x = placed.x;
+            rect.y = placed.y;
+            rect.rotated = rotated;
+            pageSizes[page].first = std::max(pageSizes[page].first, placed.x + placed.width - padding);
+            pageSizes[page].second = std::max(pageSizes[page].second, placed.y + placed.height - padding);
+        }
+
+        return pageSizes;
+    }
+
+    /// What a previous pack left in a .sdgatlas file
+    struct AtlasFileInfo
+    {
+        uint64_t inputHash;
+        std::vector<std::string> pages; ///< page file names, in the same folder
+    };
+
+    static auto ReadAtlasInfo(const fs::path &path) -> std::optional<AtlasFileInfo>
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return std::nullopt;
+        std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        AtlasFormat::Header header;
+        if (data.size() < sizeof(header))
+            return std::nullopt;
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        const size_t namesOffset = sizeof(header) + (size_t)header.pageCount * sizeof(AtlasFormat::Page) +
+            (size_t)header.imageCount * sizeof(AtlasFormat::Image);
+        if (std::memcmp(header.magic, AtlasFormat::Magic, sizeof(header.magic)) != 0 ||
+            header.version != AtlasFormat::Version || namesOffset + header.namesSize != data.size())
+            return std::nullopt;
+
+        AtlasFileInfo info{ header.inputHash, {} };
+        for (uint32_t i = 0; i < header.pageCount; ++i)
+        {
+            AtlasFormat::Page page;
+            std::memcpy(&page, data.data() + sizeof(header) + i * sizeof(page), sizeof(page));
+            if ((size_t)page.nameOffset + page.nameLength > header.namesSize)
+                return std::nullopt;
+            info.pages.emplace_back(data.data() + namesOffset + page.nameOffset, page.nameLength);
+        }
+
+        return info;
+    }
+
+    /// Writes a file through a temporary one, so an interrupted write leaves any previous file intact
+    static auto WriteFileAtomic(const fs::path &path, const void *data, size_t size) -> bool
+    {
+        fs::path tempPath = path;
+        tempPath += ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open() || !out.write(static_cast<const char *>(data), (std::streamsize)size))
+            {
+                out.close();
+                std::error_code ec;
+                fs::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, path, ec);
+        if (ec)
+            fs::remove(tempPath, ec);
+        return !ec;
+    }
+
+    static auto ReadFile(const fs::path &path, std::vector<char> *data) -> bool
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in.is_open())
+            return false;
+
+        data->resize((size_t)in.tellg());
+        in.seekg(0);
+        return (bool)in.read(data->data(), (std::streamsize)data->size());
+    }
+
+    /// Decodes a source image, and crops it to its visible pixels if trimming
+    static auto Decode(AtlasSource &source, bool trim) -> bool
+    {
+        if (source.bytes.empty() && !ReadFile(source.path, &source.bytes))
+        {
+            source.error = "failed to read image";
+            return false;
+        }
+
+        std::vector<unsigned char> image;
+        unsigned width, height;
+        unsigned code = lodepng::decode(image, width, height,
+            reinterpret_cast<const unsigned char *>(source.bytes.data()), source.bytes.size());
+        source.bytes = std::vector<char>();
+        if (code != 0)
+        {
+            source.error = std::string("failed to decode image: ") + lodepng_error_text(code);
+            return false;
+        }
+
+        unsigned minX = 0, minY = 0, maxX = width, maxY = height;
+        if (trim)
+        {
+            minX = width; minY = height; maxX = 0; maxY = 0;
+            for (unsigned y = 0; y < height; ++y)
+            {
+                for (unsigned x = 0; x < width; ++x)
+                {
+                    if (image[((size_t)y * width + x) * 4 + 3] == 0)
+                        continue;
+                    minX = std::min(minX, x);
+                    minY = std::min(minY, y);
+                    maxX = std::max(maxX, x + 1);
+                    maxY = std::max(maxY, y + 1);
+                }
+            }
+
+            // Fully transparent: keep one pixel, so the image still has a frame
+            if (minX >= maxX)
+            {
+                minX = minY = 0;
+                maxX = std::min(width, 1u);
+                maxY = std::min(height, 1u);
+            }
+        }
+
+        source.origWidth = width;
+        source.origHeight = height;
+        source.trimX = minX;
+        source.trimY = minY;
+        source.width = maxX - minX;
+        source.height = maxY - minY;
+        source.pixels.resize((size_t)source.width * source.height * 4);
+        for (unsigned y = 0; y < source.height; ++y)
+        {
+            std::memcpy(source.pixels.data() + (size_t)y * source.width * 4,
+                image.data() + ((size_t)(minY + y) * width + minX) * 4, (size_t)source.width * 4);
+        }
+
+        return true;
+    }
+
+    /// Copies a source's pixels into its place in a page, turning them 90 degrees clockwise if rotated
+    static auto Blit(const AtlasSource &source, const AtlasRect &rect, std::vector<unsigned char> &page,
+        unsigned pageWidth) -> void
+    {
+        for (unsigned y = 0; y < source.height; ++y)
+        {
+            const unsigned char *row = source.pixels.data() + (size_t)y * source.width * 4;
+            if (!rect.rotated)
+            {
+                std::memcpy(page.data() + ((size_t)(rect.y + y) * pageWidth + rect.x) * 4, row,
+                    (size_t)source.width * 4);
+                continue;
+            }
+
+            // (x, y) goes to (height - 1 - y, x)
+            for (unsigned x = 0; x < source.width; ++x)
+            {
+                std::memcpy(page.data() + ((size_t)(rect.y + x) * pageWidth + rect.x + source.height - 1 - y) * 4,
+                    row + (size_t)x * 4, 4);
+            }
+        }
+    }
+
+    static auto IsPng(const fs::path &path) -> bool
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return (char)std::tolower(c); });
+        return extension == ".png";
+    }
+
+    auto PackAtlas(const std::string &sourceFolder, const std::string &dest, const AtlasSettings &settings,
+        const ContentCache &cache, const std::string &cacheKey, unsigned threadCount) -> AtlasResult
+    {
+        AtlasResult result;
+        result.status = AtlasStatus::Failed;
+
+        if (!fs::is_directory(sourceFolder))
+        {
+            result.error = "source folder does not exist (" + sourceFolder + ")";
+            return result;
+        }
+        if (settings.maxSize == 0 || settings.maxSize > UINT16_MAX || settings.padding >= settings.maxSize)
+        {
+            result.error = "maxSize must be from 1 to 65535, and larger than padding";
+            return result;
+        }
+
+        // Find the images, in the order the atlas lists them
+        std::vector<AtlasSource> sources;
+        try {
+            for (const auto &file : fs::recursive_directory_iterator(sourceFolder))
+            {
+                if (!file.is_regular_file() || !IsPng(file.path()))
+                    continue;
+
+                const fs::path relative = file.path().lexically_relative(sourceFolder);
+                AtlasSource source;
+                source.name = fs::path(relative).replace_extension().generic_string();
+                source.path = file.path();
+                source.cacheKey = cacheKey + "/" + relative.generic_string();
+                sources.push_back(std::move(source));
+            }
+        }
+        catch (const fs::filesystem_error &e)
+        {
+            result.error = e.what();
+            return result;
+        }
+
+        if (sources.empty())
+        {
+            result.error = "no .png images in source folder (" + sourceFolder + ")";
+            return result;
+        }
+
+        std::sort(sources.begin(), sources.end(), [](const AtlasSource &a, const AtlasSource &b) {
+            return AtlasFormat::NameLess(a.name, b.name);
+        });
+
+        for (size_t i = 1; i < sources.size(); ++i)
+        {
+            if (sources[i].name == sources[i - 1].name)
+            {
+                result.error = "two images named \"" + sources[i].name + "\" differ only by extension";
+                return result;
+            }
+        }
+
+        // Hash each image, unless the cache shows it is unchanged
+        ParallelFor(sources.size(), threadCount, [&](size_t i) {
+            AtlasSource &source = sources[i];
+            std::error_code ec;
+            source.entry.size = fs::file_size(source.path, ec);
+            if (!ec)
+                source.entry.writeTime = fs::last_write_time(source.path, ec).time_since_epoch().count();
+            if (ec)
+            {
+                source.error = ec.message();
+                return;
+            }
+
+            if (cache.IsUnchanged(source.cacheKey, source.entry.size, source.entry.writeTime))
+            {
+                source.entry = *cache.Find(source.cacheKey);
+                return;
+            }
+
+            if (!ReadFile(source.path, &source.bytes))
+            {
+                source.error = "failed to read image";
+                return;
+            }
+            source.entry.size = source.bytes.size();
+            source.entry.hash = HashContent(source.bytes.data(), source.bytes.size());
+            source.entry.hasHash = true;
+        });
+
+        for (const AtlasSource &source : sources)
+        {
+            if (!source.error.empty())
+            {
+                result.error = source.error + " (" + source.path.string() + ")";
+                return result;
+            }
+            result.sources.emplace_back(source.cacheKey, source.entry);
+        }
+        result.imageCount = sources.size();
+
+        // Identify the images and settings, so an unchanged atlas is left alone
+        std::string input = "SDGA" + std::to_string(AtlasFormat::Version);
+        for (unsigned value : { settings.maxSize, settings.padding, (unsigned)settings.trim,
+            (unsigned)settings.rotate, (unsigned)settings.unique })
+            input.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        for (const AtlasSource &source : sources)
+        {
+            input.append(source.name).push_back('\0');
+            input.append(reinterpret_cast<const char *>(&source.entry.size), sizeof(source.entry.size));
+            input.append(reinterpret_cast<const char *>(&source.entry.hash), sizeof(source.entry.hash));
+        }
+        const uint64_t inputHash = HashContent(input.data(), input.size());
+
+        const fs::path metaPath = dest + ".sdgatlas";
+        const fs::path destDir = fs::path(dest).parent_path();
+        const auto previous = ReadAtlasInfo(metaPath);
+        if (previous && previous->inputHash == inputHash &&
+            std::all_of(previous->pages.begin(), previous->pages.end(),
+                [&](const std::string &page) { return fs::exists(destDir / page); }))
+        {
+            result.pageCount = previous->pages.size();
+            result.status = AtlasStatus::UpToDate;
+            return result;
+        }
+
+        ParallelFor(sources.size(), threadCount, [&](size_t i) {
+            Decode(sources[i], settings.trim);
+        });
+
+        for (const AtlasSource &source : sources)
+        {
+            if (!source.error.empty())
+            {
+                result.error = source.error + " (" + source.path.string() + ")";
+                return result;
+            }
+            if (source.origWidth > UINT16_MAX || source.origHeight > UINT16_MAX ||
+                std::max(source.width, source.height) > settings.maxSize)
+            {
+                result.error = "image is larger than the atlas maxSize of " + std::to_string(settings.maxSize) +
+                    " (" + source.path.string() + ")";
+                return result;
+            }
+        }
+
+        // One rectangle per distinct image
+        std::vector<AtlasRect> rects;
+        std::unordered_map<uint64_t, std::vector<size_t>> rectsByPixels;
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            AtlasSource &source = sources[i];
+            if (settings.unique)
+            {
+                const uint64_t pixelHash = HashContent(source.pixels.data(), source.pixels.size(),
+                    ((uint64_t)source.width << 32) | source.height);
+                auto &candidates = rectsByPixels[pixelHash];
+                auto same = std::find_if(candidates.begin(), candidates.end(), [&](size_t rect) {
+                    const AtlasSource &other = sources[rects[rect].source];
+                    return other.width == source.width && other.height == source.height &&
+                        other.pixels == source.pixels;
+                });
+
+                if (same != candidates.end())
+                {
+                    source.rect = *same;
+                    continue;
+                }
+                candidates.push_back(rects.size());
+            }
+
+            source.rect = rects.size();
+            rects.push_back({ i, source.width, source.height });
+        }
+
+        // Largest first, which packs tightest
+        std::vector<size_t> order(rects.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            const unsigned aLong = std::max(rects[a].width, rects[a].height);
+            const unsigned bLong = std::max(rects[b].width, rects[b].height);
+            if (aLong != bLong)
+                return aLong > bLong;
+            const unsigned aShort = std::min(rects[a].width, rects[a].height);
+            const unsigned bShort = std::min(rects[b].width, rects[b].height);
+            return aShort != bShort ? aShort > bShort : a < b;
+        });
+
+        // Pages are square. Try the smallest that may hold every image, growing it until it does; images that do
+        // not fit in one page of maxSize go on more pages.
+        const unsigned binSize = settings.maxSize + settings.padding;
+        uint64_t area = 0;
+        unsigned longest = 0;
+        for (const AtlasRect &rect : rects)
+        {
+            area += (uint64_t)(rect.width + settings.padding) * (rect.height + settings.padding);
+            longest = std::max(longest, std::max(rect.width, rect.height) + settings.padding);
+        }
+
+        std::optional<std::vector<std::pair<unsigned, unsigned>>> pageSizes;
+        for (unsigned size = std::max(longest, (unsigned)std::ceil(std::sqrt((double)area))); size < binSize;
+            size += std::max(size / 8, 1u))
+        {
+            if ((pageSizes = PlaceRects(rects, order, size, settings.padding, settings.rotate, 1)))
+                break;
+        }
+
+        if (!pageSizes)
+            pageSizes = PlaceRects(rects, order, binSize, settings.padding, settings.rotate, SIZE_MAX);
+        if (!pageSizes)
+        {
+            result.error = "images do not fit in pages of maxSize " + std::to_string(settings.maxSize);
+            return result;
+        }
+        const size_t pageCount = pageSizes->size();
+
+        // Draw and encode each page
+        std::error_code ec;
+        fs::create_directories(destDir, ec);
+
+        const std::string stem = fs::path(dest).filename().string();
+        std::vector<std::string> pageNames(pageCount);
+        std::vector<std::string> pageErrors(pageCount);
+        ParallelFor(pageCount, threadCount, [&](size_t page) {
+            const auto [width, height] = (*pageSizes)[page];
+            std::vector<unsigned char> pixels((size_t)width * height * 4, 0);
+            for (const AtlasRect &rect : rects)
+            {
+                if (rect.page == page)
+                    Blit(sources[rect.source], rect, pixels, width);
+            }
+
+            std::vector<unsigned char> png;
+            unsigned code = lodepng::encode(png, pixels, width, height);
+            pageNames[page] = stem + std::to_string(page) + ".png";
+            if (code != 0)
+                pageErrors[page] = std::string("failed to encode page: ") + lodepng_error_text(code);
+            else if (!WriteFileAtomic(destDir / pageNames[page], png.data(), png.size()))
+                pageErrors[page] = "failed to write page (" + (destDir / pageNames[page]).string() + ")";
+        });
+
+        for (const std::string &error : pageErrors)
+        {
+            if (!error.empty())
+            {
+                result.error = error;
+                return result;
+            }
+        }
+
+        // Metadata goes last, so it only describes pages that were written
+        std::string names;
+        std::vector<char> file(sizeof(AtlasFormat::Header) + pageCount * sizeof(AtlasFormat::Page) +
+            sources.size() * sizeof(AtlasFormat::Image));
+        char *write = file.data() + sizeof(AtlasFormat::Header);
+        for (size_t i = 0; i < pageCount; ++i)
+        {
+            AtlasFormat::Page page{};
+            page.nameOffset = (uint32_t)names.size();
+            page.nameLength = (uint16_t)pageNames[i].size();
+            page.width = (uint16_t)(*pageSizes)[i].first;
+            page.height = (uint16_t)(*pageSizes)[i].second;
+            names += pageNames[i];
+            std::memcpy(write, &page, sizeof(page));
+            write += sizeof(page);
+        }
+
+        for (const AtlasSource &source : sources)
+        {
+            const AtlasRect &rect = rects[source.rect];
+            AtlasFormat::Image image{};
+            image.nameOffset = (uint32_t)names.size();
+            image.nameLength = (uint16_t)std::min<size_t>(source.name.size(), UINT16_MAX);
+            image.page = (uint16_t)rect.page;
+            image.x = (uint16_t)rect.x;
+            image.y = (uint16_t)rect.y;
+            image.width = (uint16_t)(rect.rotated ? source.height : source.width);
+            image.height = (uint16_t)(rect.rotated ? source.width : source.height);
+            image.trimX = (uint16_t)source.trimX;
+            image.trimY = (uint16_t)source.trimY;
+            image.origWidth = (uint16_t)source.origWidth;
+            image.origHeight = (uint16_t)source.origHeight;
+            image.flags = rect.rotated ? AtlasFormat::Rotated : 0;
+            names.append(source.name, 0, image.nameLength);
+            std::memcpy(write, &image, sizeof(image));
+            write += sizeof(image);
+        }
+        file.insert(file.end(), names.begin(), names.end());
+
+        AtlasFormat::Header header{};
+        std::memcpy(header.magic, AtlasFormat::Magic, sizeof(header.magic));
+        header.version = AtlasFormat::Version;
+        header.pageCount = (uint32_t)pageCount;
+        header.imageCount = (uint32_t)sources.size();
+        header.namesSize = (uint32_t)names.size();
+        header.inputHash = inputHash;
+        std::memcpy(file.data(), &header, sizeof(header));
+
+        if (!WriteFileAtomic(metaPath, file.data(), file.size()))
+        {
+            result.error = "failed to write atlas file (" + metaPath.string() + ")";
+            return result;
+        }
+
+        // Pages the previous pack had beyond this one's
+        if (previous)
+        {
+            for (const std::string &page : previous->pages)
+            {
+                if (std::find(pageNames.begin(), pageNames.end(), page) == pageNames.end())
+                    fs::remove(destDir / page, ec);
+            }
+        }
+
+        result.pageCount = pageCount;
+        result.status = AtlasStatus::Packed;
+        return result;
+    }
+
+    auto AtlasFiles(const std::string &dest) -> std::vector<fs::path>
+    {
+        const fs::path metaPath = dest + ".sdgatlas";
+        const auto info = ReadAtlasInfo(metaPath);
+        if (!info)
+            return {};
+
+        std::vector<fs::path> files{ metaPath };
+        for (const std::string &page : info->pages)
+            files.push_back(fs::path(dest).parent_path() / page);
+        return files;
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "ContentCache.h"
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SDG::ContentPipe
+{
+    /// How an atlas is packed, from its entry in the asset config
+    struct AtlasSettings
+    {
+        unsigned maxSize = 4096;  ///< largest width and height of a page
+        unsigned padding = 1;     ///< transparent pixels between images
+        bool     trim = true;     ///< crop transparent borders
+        bool     rotate = true;   ///< allow turning images 90 degrees to fit
+        bool     unique = true;   ///< store identical images once
+    };
+
+    enum class AtlasStatus
+    {
+        NotBuilt,  ///< not marked in any build so far
+        UpToDate,  ///< already packed from the same images and settings
+        Packed,
+        Failed
+    };
+
+    struct AtlasResult
+    {
+        AtlasStatus status = AtlasStatus::NotBuilt;
+        size_t imageCount = 0, pageCount = 0;
+        /// Cache entries of the source images, by cache key, so the next build need not hash unchanged images
+        std::vector<std::pair<std::string, ContentEntry>> sources;
+        std::string error;
+    };
+
+    /// Packs the .png images in a folder and its subfolders into pages "<dest>0.png", "<dest>1.png", etc., which
+    /// "<dest>.sdgatlas" describes, as laid out in Engine/Game/Graphics/AtlasFormat.h. Images are read, decoded and
+    /// encoded across threads. Does nothing if the atlas was packed from the same images and settings already.
+    /// @param cacheKey - prefix of the source images' keys in the cache
+    auto PackAtlas(const std::string &sourceFolder, const std::string &dest, const AtlasSettings &settings,
+        const ContentCache &cache, const std::string &cacheKey, unsigned threadCount) -> AtlasResult;
+
+    /// Gets the files of a packed atlas: its .sdgatlas file, then its pages
+    auto AtlasFiles(const std::string &dest) -> std::vector<std::filesystem::path>;
+}
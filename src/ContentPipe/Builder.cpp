@@ -0,0 +1,484 @@
+#include "Builder.h"
+#include "AtlasPacker.h"
+#include "ContentHash.h"
+#include "Encryption.h"
+#include "PackWriter.h"
+#include "ParallelFor.h"
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace SDG::ContentPipe
+{
+    using Clock = std::chrono::steady_clock;
+
+    const std::string CacheFilename = "SDG_ContentCache.bin";
+    const std::string LegacyCacheFilename = "SDG_ContentCache.txt"; ///< text cache written by older versions
+
+    static auto SecondsSince(Clock::time_point start) -> double
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    static const char *OpenJson(const std::string &path, nlohmann::json *json)
+    {
+        std::ifstream configFile;
+        configFile.open(path, std::ios::binary);
+        if (!configFile.is_open())
+        {
+            return "failed to open file";
+        }
+
+        nlohmann::json j;
+        try {
+            j = nlohmann::json::parse(configFile);
+        }
+        catch (const nlohmann::detail::exception &e)
+        {
+            return e.what();
+        }
+        catch (...)
+        {
+            return "unknown error";
+        }
+
+        if (json)
+            *json = std::move(j);
+
+        return nullptr;
+    }
+
+    /// Identifies the current version of an output file by its size and write time, or 0 if it does not exist.
+    /// An output that was deleted, or left truncated by an interrupted build, no longer matches its cache entry.
+    static auto OutputFingerprint(const std::string &path) -> uint64_t
+    {
+        std::error_code ec;
+        const uint64_t size = fs::file_size(path, ec);
+        if (ec)
+            return 0;
+
+        const auto writeTime = fs::last_write_time(path, ec).time_since_epoch().count();
+        if (ec)
+            return 0;
+
+        const uint64_t fields[2] = { size, (uint64_t)writeTime };
+        return HashContent(fields, sizeof(fields));
+    }
+
+    /// Encrypts one file if its content changed since it was cached. Safe to call from several threads at once,
+    /// since the cache is only read, and each job writes its own output file.
+    static auto ProcessFile(const FileJob &job, const ContentCache &cache, const std::string &key) -> FileResult
+    {
+        auto start = Clock::now();
+        FileResult result;
+        result.status = FileStatus::Failed;
+
+        try {
+            result.entry.size = fs::file_size(job.source);
+            result.entry.writeTime = fs::last_write_time(job.source).time_since_epoch().count();
+
+            // Output may have been deleted or changed since; then it is rebuilt whatever the cache says.
+            // Entries converted from the text cache have no fingerprint, so any existing output is trusted once.
+            const uint64_t outputFingerprint = OutputFingerprint(job.outFilePath);
+            const auto cached = cache.Find(job.relativePath);
+            const bool outputCurrent = outputFingerprint != 0 && cached &&
+                (cached->outputFingerprint == 0 || cached->outputFingerprint == outputFingerprint);
+            if (outputCurrent && cache.IsUnchanged(job.relativePath, result.entry.size, result.entry.writeTime))
+            {
+                result.entry = *cached;
+                result.entry.outputFingerprint = outputFingerprint;
+                result.status = FileStatus::UpToDate;
+                result.seconds = SecondsSince(start);
+                return result;
+            }
+
+            // Read the whole file once, both to hash and to encrypt
+            std::vector<char> data(result.entry.size);
+            std::ifstream inFile(job.source, std::ios::binary);
+            if (!inFile.is_open() || !inFile.read(data.data(), (std::streamsize)data.size()))
+            {
+                result.error = "There was a problem opening file at path: " + job.source.string();
+                return result;
+            }
+            inFile.close();
+
+            result.entry.hash = HashContent(data.data(), data.size());
+            result.entry.hasHash = true;
+            if (outputCurrent && cache.ContentMatches(job.relativePath, result.entry.size, result.entry.hash))
+            {
+                result.entry.outputFingerprint = outputFingerprint;
+                result.status = FileStatus::ContentUnchanged;
+                result.seconds = SecondsSince(start);
+                return result;
+            }
+
+            EncryptData(data.data(), data.size(), key);
+
+            std::ofstream outFile(job.outFilePath, std::ios::trunc | std::ios::binary);
+            if (!outFile.is_open() || !outFile.write(data.data(), (std::streamsize)data.size()))
+            {
+                result.error = "There was a problem writing a file at path: " + job.outFilePath;
+                return result;
+            }
+            outFile.close();
+            if (!outFile)
+            {
+                result.error = "There was a problem writing a file at path: " + job.outFilePath;
+                return result;
+            }
+
+            result.entry.outputFingerprint = OutputFingerprint(job.outFilePath);
+
+            result.status = FileStatus::Processed;
+        }
+        catch (const fs::filesystem_error &e)
+        {
+            result.error = e.what();
+        }
+
+        result.seconds = SecondsSince(start);
+        return result;
+    }
+
+    /// Name of an output file inside a pack: its path relative to the output directory
+    static auto PackName(const fs::path &outFile, const fs::path &outDir) -> std::string
+    {
+        return outFile.lexically_relative(outDir).generic_string();
+    }
+
+    /// Adds the .sdgatlas file and pages of an atlas to a pack
+    static auto AddAtlasToPack(PackWriter &pack, const std::string &dest, const fs::path &outDir) -> void
+    {
+        for (const fs::path &file : AtlasFiles(dest))
+        {
+            std::ifstream in(file, std::ios::binary);
+            std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            pack.Add(PackName(file, outDir), file, HashContent(data.data(), data.size()));
+        }
+    }
+
+    /// Whether a config entry's path is the file, or a folder containing it, such as an atlas source folder.
+    /// Both paths are normalized and relative to the asset directory.
+    static auto EntryContains(const std::string &entryPath, const std::string &file) -> bool
+    {
+        return file == entryPath ||
+            (file.size() > entryPath.size() && file.compare(0, entryPath.size(), entryPath) == 0 &&
+                file[entryPath.size()] == '/');
+    }
+
+    auto NormalizeRelative(const std::string &path) -> std::string
+    {
+        std::string result = fs::path(path).lexically_normal().generic_string();
+        result.erase(0, result.find_first_not_of("/"));
+        while (!result.empty() && result.back() == '/')
+            result.pop_back();
+        return result;
+    }
+
+    Builder::Builder(BuildOptions options) : options(std::move(options))
+    {
+
+    }
+
+    auto Builder::Load(std::ostream &out, std::ostream &err) -> bool
+    {
+        if (!loaded && !cache.Load(CacheFilename) && cache.LoadText(LegacyCacheFilename))
+            out << "[ContentPipe] Converting content cache (" << LegacyCacheFilename << ") to binary ("
+                << CacheFilename << ")\n";
+
+        // Open asset config
+        nlohmann::json j;
+        {
+            std::error_code ec;
+            configTime = fs::last_write_time(options.configPath, ec);
+
+            const char *result = OpenJson(options.configPath, &j);
+            if (result != 0)
+            {
+                err << "Failed to open or parse asset config json (" << options.configPath << "): " << result
+                    << '\n';
+                return false;
+            }
+        }
+
+        fileJobs.clear();
+        atlases.clear();
+        fileByPath.clear();
+        markedFiles.clear();
+        markedAtlases.clear();
+
+        const std::string &assetDir = options.assetDir;
+        fs::directory_entry assetFolder(options.outDir);
+
+        // For each asset in config
+        for (auto &assetInfo : j)
+        {
+            // Get info from json
+            auto type = std::string{ assetInfo.value("type", "") };
+            auto path = assetInfo.value("path", "");
+            auto entry = fs::directory_entry(assetDir + "/" + path);
+
+            // Validate info
+            {
+                bool pathExists = fs::exists(entry.path());
+                if (type.empty() || path.empty() || !pathExists)
+                {
+                    out << "Warning: skipping asset entry: \n";
+                    if (type.empty())
+                    {
+                        out << " (!) missing \"type\" field\n";
+                        if (!path.empty())
+                            out << " -> contains path \"" << path << "\"\n";
+                    }
+                    if (path.empty())
+                    {
+                        out << " (!) missing \"path\" field.\n";
+                        if (!type.empty())
+                            out << " -> contains type \"" << type << "\"\n";
+                    }
+                    if (!path.empty() && !pathExists)
+                    {
+                        out << " (!) file at path \"" << path << "\" does not exist.\n";
+                    }
+                    continue;
+                }
+            }
+
+            // Perform task based on type
+            if (type == "texture-atlas") // pack the folder's images
+            {
+                AtlasJob atlas;
+                atlas.path = path;
+                atlas.settings.maxSize = assetInfo.value("maxSize", atlas.settings.maxSize);
+                atlas.settings.padding = assetInfo.value("padding", atlas.settings.padding);
+                atlas.settings.trim = assetInfo.value("trim", atlas.settings.trim);
+                atlas.settings.rotate = assetInfo.value("rotate", atlas.settings.rotate);
+                atlas.settings.unique = assetInfo.value("unique", atlas.settings.unique);
+                atlases.push_back(std::move(atlas));
+            }
+            else                         // copy as encrypted sdgc file
+            {
+                std::string relativePath = entry.path().string().substr(assetDir.length());
+                std::string outFilePath  = assetFolder.path().string() + relativePath;
+
+                // Make sure folder structure exists in target destination, before jobs write there
+                {
+                    fs::path parent = fs::path(outFilePath).parent_path();
+                    if (!fs::exists(parent))
+                        fs::create_directories(parent);
+                }
+
+                // append .sdgc to files (marks encrypted status)
+                {
+                    if (entry.path().has_extension())
+                    {
+                        size_t dotPos = outFilePath.find(entry.path().extension().string());
+                        outFilePath = outFilePath.substr(0, dotPos) + ".sdgc";
+                    }
+                    else
+                    {
+                        outFilePath += ".sdgc";
+                    }
+                }
+
+                fileByPath[NormalizeRelative(path)] = fileJobs.size();
+                fileJobs.push_back({ entry.path(), relativePath, outFilePath });
+            }
+        }
+
+        results.assign(fileJobs.size(), FileResult());
+        loaded = true;
+        return true;
+    }
+
+    auto Builder::MarkAll() -> void
+    {
+        for (size_t i = 0; i < fileJobs.size(); ++i)
+            markedFiles.insert(i);
+        for (size_t i = 0; i < atlases.size(); ++i)
+            markedAtlases.insert(i);
+    }
+
+    auto Builder::MarkChanged(const std::string &relativePath) -> bool
+    {
+        const std::string path = NormalizeRelative(relativePath);
+        bool marked = false;
+
+        auto it = fileByPath.find(path);
+        if (it != fileByPath.end())
+        {
+            markedFiles.insert(it->second);
+            marked = true;
+        }
+
+        for (size_t i = 0; i < atlases.size(); ++i)
+        {
+            if (EntryContains(NormalizeRelative(atlases[i].path), path))
+            {
+                markedAtlases.insert(i);
+                marked = true;
+            }
+        }
+
+        return marked;
+    }
+
+    auto Builder::Build(std::ostream &out, std::ostream &err) -> int
+    {
+        auto buildStart = Clock::now();
+
+        // The config lists every asset, so when it changes, any of them may have
+        std::error_code ec;
+        if (!loaded || fs::last_write_time(options.configPath, ec) != configTime)
+        {
+            if (!Load(out, err))
+                return 1;
+            MarkAll();
+        }
+
+        // Atlases are packed in order, each across threads, then files are processed in parallel
+        size_t atlasCount = 0;
+        for (size_t i : markedAtlases)
+        {
+            AtlasJob &atlas = atlases[i];
+            auto start = Clock::now();
+            AtlasResult result = PackAtlas(options.assetDir + "/" + atlas.path,
+                options.outDir + "/atlases/" + atlas.path, atlas.settings, cache,
+                "atlas:" + NormalizeRelative(atlas.path), options.threadCount);
+            atlas.status = result.status;
+
+            for (const auto &[key, entry] : result.sources)
+            {
+                auto cached = cache.Find(key);
+                if (!cached || *cached != entry)
+                    cache.Set(key, entry);
+            }
+
+            if (result.status == AtlasStatus::Failed)
+            {
+                err << "Error: failed to create texture atlas (" << atlas.path << "): " << result.error << '\n';
+            }
+            else if (result.status == AtlasStatus::Packed)
+            {
+                out << "[ContentPipe] Packed atlas (" << atlas.path << ") of " << result.imageCount
+                    << " images on " << result.pageCount << " pages in " << std::fixed << std::setprecision(2)
+                    << SecondsSince(start) * 1000.0 << " ms\n";
+                ++atlasCount;
+            }
+        }
+
+        // The cache is only read until every job is done
+        const std::vector<size_t> jobs(markedFiles.begin(), markedFiles.end());
+        std::vector<FileResult> jobResults(jobs.size());
+        ParallelFor(jobs.size(), options.threadCount, [&](size_t i) {
+            jobResults[i] = ProcessFile(fileJobs[jobs[i]], cache, options.encryptionKey);
+        });
+
+        // Report each file in config order, and update the cache
+        size_t upToDate = 0, contentUnchanged = 0, processed = 0, failed = 0;
+        double fileSeconds = 0;
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            const FileJob &job = fileJobs[jobs[i]];
+            const FileResult &result = results[jobs[i]] = std::move(jobResults[i]);
+            fileSeconds += result.seconds;
+
+            // Only entries that differ are set, so a build that changed nothing leaves the cache file alone
+            if (result.status != FileStatus::Failed && result.status != FileStatus::NotBuilt)
+            {
+                auto cached = cache.Find(job.relativePath);
+                if (!cached || *cached != result.entry)
+                    cache.Set(job.relativePath, result.entry);
+            }
+
+            switch (result.status)
+            {
+                case FileStatus::UpToDate:
+                    ++upToDate;
+                    break;
+                case FileStatus::ContentUnchanged:
+                    ++contentUnchanged;
+                    break;
+                case FileStatus::Processed:
+                    ++processed;
+                    out << "[ContentPipe] Encrypted file (" << job.relativePath.substr(1) << ") in "
+                        << std::fixed << std::setprecision(2) << result.seconds * 1000.0 << " ms\n";
+                    break;
+                case FileStatus::Failed:
+                    ++failed;
+                    err << result.error << '\n';
+                    break;
+                case FileStatus::NotBuilt:
+                    break;
+            }
+        }
+
+        markedFiles.clear();
+        markedAtlases.clear();
+
+        // Pack everything into one archive, unless nothing was built and it already exists
+        if (!options.packPath.empty() && (atlasCount > 0 || !jobs.empty() || !fs::exists(options.packPath)))
+            WritePack(out, err);
+
+        // Output changes to cache file
+        if (cache.IsModified() && cache.Write(CacheFilename))
+        {
+            std::error_code ec;
+            fs::remove(LegacyCacheFilename, ec);
+        }
+
+        out << "[ContentPipe] Done! " << jobs.size() << " files: " << processed << " encrypted, "
+            << upToDate + contentUnchanged << " cache hits (" << contentUnchanged << " by content hash), "
+            << failed << " failed; " << atlasCount << " atlases packed. " << std::fixed << std::setprecision(2)
+            << SecondsSince(buildStart) << " s total, " << fileSeconds << " s of file work on "
+            << options.threadCount << " threads\n";
+        return 0;
+    }
+
+    auto Builder::WritePack(std::ostream &out, std::ostream &err) -> void
+    {
+        const std::string &packPath = options.packPath;
+        const bool anyFailed = std::any_of(results.begin(), results.end(),
+            [](const FileResult &result) { return result.status == FileStatus::Failed; }) ||
+            std::any_of(atlases.begin(), atlases.end(),
+                [](const AtlasJob &atlas) { return atlas.status == AtlasStatus::Failed; });
+        const bool allBuilt = std::none_of(results.begin(), results.end(),
+            [](const FileResult &result) { return result.status == FileStatus::NotBuilt; }) &&
+            std::none_of(atlases.begin(), atlases.end(),
+                [](const AtlasJob &atlas) { return atlas.status == AtlasStatus::NotBuilt; });
+
+        if (anyFailed)
+        {
+            err << "[ContentPipe] Pack was not written, since some assets failed\n";
+            return;
+        }
+        if (!allBuilt)
+        {
+            out << "[ContentPipe] Pack was not written, since it needs every asset built\n";
+            return;
+        }
+
+        PackWriter pack;
+        for (const AtlasJob &atlas : atlases)
+            AddAtlasToPack(pack, options.outDir + "/atlases/" + atlas.path, options.outDir);
+        for (size_t i = 0; i < fileJobs.size(); ++i)
+            pack.Add(PackName(fileJobs[i].outFilePath, options.outDir), fileJobs[i].source, results[i].entry.hash);
+
+        auto start = Clock::now();
+        std::string error;
+        const std::string key = options.packEncrypt ? options.encryptionKey : "";
+        if (pack.IsCurrent(packPath, key))
+            out << "[ContentPipe] Pack is up to date (" << packPath << ")\n";
+        else if (!pack.Write(packPath, key, &error))
+            err << "[ContentPipe] Failed to write pack (" << packPath << "): " << error << '\n';
+        else
+            out << "[ContentPipe] Wrote pack of " << pack.Size() << " files (" << packPath << ") in "
+                << std::fixed << std::setprecision(2) << SecondsSince(start) * 1000.0 << " ms\n";
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "AtlasPacker.h"
+#include "ContentCache.h"
+#include <filesystem>
+#include <iosfwd>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SDG::ContentPipe
+{
+    /// What to build, from the command line
+    struct BuildOptions
+    {
+        std::string assetDir, outDir, encryptionKey, configPath;
+        unsigned    threadCount = 1;
+        std::string packPath;     ///< .sdgpack to write, or empty for none
+        bool        packEncrypt = false;
+    };
+
+    /// A source file to copy to the output directory as an encrypted .sdgc file
+    struct FileJob
+    {
+        std::filesystem::path source;
+        std::string relativePath; ///< cache key, starts with a separator
+        std::string outFilePath;
+    };
+
+    /// A folder of images to pack into a texture atlas
+    struct AtlasJob
+    {
+        std::string path;         ///< source folder, relative to the asset directory
+        AtlasSettings settings;
+        AtlasStatus status = AtlasStatus::NotBuilt; ///< result of the last build that marked it
+    };
+
+    enum class FileStatus
+    {
+        NotBuilt,         ///< not marked in any build so far
+        UpToDate,         ///< size and write time match the cache
+        ContentUnchanged, ///< timestamp changed, but the content hash matches the cache
+        Processed,
+        Failed
+    };
+
+    struct FileResult
+    {
+        FileStatus status = FileStatus::NotBuilt;
+        ContentEntry entry;
+        double seconds = 0;
+        std::string error;
+    };
+
+    /// Processes the assets listed in the config file. Keeps the config, the cache, and each file's last result
+    /// between builds, so a long-running process can rebuild just the assets whose files changed, without reading
+    /// the config or checking every file again.
+    class Builder
+    {
+    public:
+        explicit Builder(BuildOptions options);
+
+        /// Loads the asset config, and the content cache the first time. Marks nothing to build.
+        auto Load(std::ostream &out, std::ostream &err) -> bool;
+
+        /// Marks every asset in the config to build. Files the cache shows are unchanged are still skipped.
+        auto MarkAll() -> void;
+
+        /// Marks the asset a changed file belongs to: the file itself, or an atlas whose folder holds it
+        /// @param relativePath - path of the file, relative to the asset directory
+        /// @return whether an asset was marked
+        auto MarkChanged(const std::string &relativePath) -> bool;
+
+        /// Whether any assets are marked to build
+        [[nodiscard]] auto HasMarked() const -> bool { return !markedFiles.empty() || !markedAtlases.empty(); }
+
+        /// Builds the marked assets, then updates the pack and cache files if anything changed. Loads the config
+        /// first, marking every asset, if it was not loaded or its file changed since.
+        /// @return exit status: 0, or 1 if the config failed to load
+        auto Build(std::ostream &out, std::ostream &err) -> int;
+
+        [[nodiscard]] auto Options() const -> const BuildOptions & { return options; }
+
+    private:
+        auto WritePack(std::ostream &out, std::ostream &err) -> void;
+
+        BuildOptions options;
+        ContentCache cache;
+        bool loaded = false;
+        std::filesystem::file_time_type configTime;
+
+        std::vector<FileJob> fileJobs;          ///< in config order
+        std::vector<FileResult> results;        ///< last result of each file job
+        std::vector<AtlasJob> atlases;          ///< in config order
+        std::unordered_map<std::string, size_t> fileByPath; ///< file job index by normalized relative path
+
+        std::set<size_t> markedFiles, markedAtlases;
+    };
+
+    /// Normalizes a path relative to the asset directory, so config entries and changed paths compare equal
+    auto NormalizeRelative(const std::string &path) -> std::string;
+}
@@ -1,21 +1,107 @@
 #include "ContentCache.h"
+#include "ContentHash.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
 
 namespace SDG::ContentPipe
 {
+    constexpr char     CacheMagic[4] = { 'S', 'D', 'C', 'C' };
+    constexpr uint32_t CacheVersion = 1;
+
+    /// Entry flags
+    enum : uint16_t
+    {
+        HasHash = 1 << 0,
+    };
+
+    /// All integers are little-endian
+    struct CacheHeader
+    {
+        char     magic[4];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t namesSize;
+        uint64_t checksum;  ///< content hash of the records and names, to reject damaged files
+    };
+
+    struct ContentCache::Record
+    {
+        uint64_t  nameHash;
+        long long writeTime;
+        uint64_t  size;
+        uint64_t  hash;
+        uint64_t  outputFingerprint;
+        uint32_t  nameOffset;  ///< from the start of the names
+        uint16_t  nameLength;
+        uint16_t  flags;
+    };
+
+    static_assert(sizeof(CacheHeader) == 24, "cache header must not be padded");
+
+    static auto HashName(const std::string &name) -> uint64_t
+    {
+        return HashContent(name.data(), name.size());
+    }
+
+    ContentCache::ContentCache() : data(), count(), changed()
+    {
+
+    }
+
     auto ContentCache::Load(const std::string &path) -> bool
     {
-        // Open cache file and read into cache
-        std::ifstream cacheFile(path);
-        if (!cacheFile.is_open())
+        data.clear();
+        count = 0;
+        changed.clear();
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
         {
             std::cout << "New content cache file will be generated at (" << path << ")\n";
             return false;
         }
 
+        // One read of the whole file, which is then searched in place
+        std::vector<char> loaded((size_t)file.tellg());
+        file.seekg(0);
+        if (!file.read(loaded.data(), (std::streamsize)loaded.size()) || loaded.size() < sizeof(CacheHeader))
+        {
+            std::cout << "Warning: content cache file is unreadable, and will be regenerated (" << path << ")\n";
+            return false;
+        }
+
+        CacheHeader header;
+        std::memcpy(&header, loaded.data(), sizeof(header));
+        const uint64_t bodySize = loaded.size() - sizeof(header);
+        if (std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) != 0 || header.version != CacheVersion ||
+            bodySize != (uint64_t)header.entryCount * sizeof(Record) + header.namesSize ||
+            HashContent(loaded.data() + sizeof(header), bodySize) != header.checksum)
+        {
+            std::cout << "Warning: content cache file is damaged or outdated, and will be regenerated (" << path
+                << ")\n";
+            return false;
+        }
+
+        data = std::move(loaded);
+        count = header.entryCount;
+        return true;
+    }
+
+    auto ContentCache::LoadText(const std::string &path) -> bool
+    {
+        // Open cache file and read into cache
+        std::ifstream cacheFile(path);
+        if (!cacheFile.is_open())
+            return false;
+
         // Populate cache from file
-        std::map<std::string, long long> cache;
+        std::unordered_map<std::string, ContentEntry> cache;
         while (cacheFile)
         {
             std::string line;
@@ -37,17 +123,20 @@ namespace SDG::ContentPipe
             filename = line.substr(0, commaPos);
 
 
-            long long lastEdited;
-            try {
-                lastEdited = std::stoll(line.substr(commaPos + 1));
-            }
-            catch (const std::invalid_argument &e)
+            // Fields are: filename,writeTime[,size,hash]. Older caches stop after writeTime.
+            ContentEntry entry;
+            std::istringstream fields(line.substr(commaPos + 1));
+            char comma;
+            if (!(fields >> entry.writeTime))
             {
                 std::cout << "Invalid timestamp on line with text \"" << line << "\"\n";
                 continue;
             }
 
-            cache[filename] = lastEdited;
+            if (fields >> comma >> entry.size >> comma >> std::hex >> entry.hash)
+                entry.hasHash = true;
+
+            cache[filename] = entry;
 
             // getline sets eof bit on reading the last line.
             // That's why the check for eof occurs after reading.
@@ -57,32 +146,165 @@ namespace SDG::ContentPipe
         cacheFile.close();
 
         // Populating complete with no errors, commit changes
-        this->cache.swap(cache);
+        for (auto &[filename, entry] : cache)
+            changed[filename] = entry;
         return true;
     }
 
     auto ContentCache::Write(const std::string &path) -> bool
     {
-        std::ofstream outFile;
-        outFile.open(path, std::ios::out | std::ios::trunc);
-        if (!outFile.is_open())
+        // Merge loaded entries with the ones set since, then sort by name hash for lookups to binary search
+        struct Item
         {
-            std::cerr << "There was a problem opening the SDG_ContentCache.txt file while caching data.\n";
-            return false;
+            uint64_t nameHash;
+            std::string_view name;
+            ContentEntry entry;
+        };
+
+        std::vector<Item> items;
+        items.reserve(count + changed.size());
+        const char *names = data.data() + sizeof(CacheHeader) + (size_t)count * sizeof(Record);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Record record = RecordAt(i);
+            const std::string name(names + record.nameOffset, record.nameLength);
+            if (changed.count(name) == 0)
+            {
+                items.push_back({ record.nameHash, std::string_view(names + record.nameOffset, record.nameLength),
+                    { record.writeTime, record.size, record.hash, record.outputFingerprint,
+                        (record.flags & HasHash) != 0 } });
+            }
         }
+        for (const auto &[name, entry] : changed)
+        {
+            if (name.size() > UINT16_MAX)
+            {
+                std::cerr << "Warning: not caching file with a path too long to store: " << name << '\n';
+                continue;
+            }
+            items.push_back({ HashName(name), name, entry });
+        }
+
+        std::sort(items.begin(), items.end(), [](const Item &a, const Item &b) {
+            return a.nameHash < b.nameHash || (a.nameHash == b.nameHash && a.name < b.name);
+        });
 
-        for (const auto &[k, v] : cache)
+        std::string namesOut;
+        std::vector<char> file(sizeof(CacheHeader) + items.size() * sizeof(Record));
+        for (size_t i = 0; i < items.size(); ++i)
         {
-            outFile << k << "," << v << '\n';
+            const Item &item = items[i];
+            Record record{};
+            record.nameHash = item.nameHash;
+            record.writeTime = item.entry.writeTime;
+            record.size = item.entry.size;
+            record.hash = item.entry.hash;
+            record.outputFingerprint = item.entry.outputFingerprint;
+            record.nameOffset = (uint32_t)namesOut.size();
+            record.nameLength = (uint16_t)item.name.size();
+            record.flags = item.entry.hasHash ? HasHash : 0;
+            std::memcpy(file.data() + sizeof(CacheHeader) + i * sizeof(Record), &record, sizeof(record));
+            namesOut += item.name;
         }
-        outFile.close();
+        file.insert(file.end(), namesOut.begin(), namesOut.end());
+
+        CacheHeader header{};
+        std::memcpy(header.magic, CacheMagic, sizeof(header.magic));
+        header.version = CacheVersion;
+        header.entryCount = (uint32_t)items.size();
+        header.namesSize = (uint32_t)namesOut.size();
+        header.checksum = HashContent(file.data() + sizeof(header), file.size() - sizeof(header));
+        std::memcpy(file.data(), &header, sizeof(header));
 
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open() || !out.write(file.data(), (std::streamsize)file.size()))
+            {
+                std::cerr << "There was a problem writing the content cache file (" << tempPath << ")\n";
+                out.close();
+                std::error_code ec;
+                fs::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, path, ec);
+        if (ec)
+        {
+            std::cerr << "There was a problem replacing the content cache file (" << path << "): " << ec.message()
+                << '\n';
+            fs::remove(tempPath, ec);
+            return false;
+        }
+
+        // What was written is now what is loaded
+        data = std::move(file);
+        count = header.entryCount;
+        changed.clear();
         return true;
     }
 
-    auto ContentCache::EntryIsNewer(const std::string &filename, long long writeTime) -> bool
+    auto ContentCache::RecordAt(size_t index) const -> Record
+    {
+        static_assert(sizeof(Record) == 48, "cache records must not be padded");
+
+        // Copied out, since the loaded bytes need not be aligned
+        Record record;
+        std::memcpy(&record, data.data() + sizeof(CacheHeader) + index * sizeof(Record), sizeof(record));
+        return record;
+    }
+
+    auto ContentCache::FindLoaded(const std::string &filename) const -> std::optional<ContentEntry>
+    {
+        const uint64_t nameHash = HashName(filename);
+        const char *names = data.data() + sizeof(CacheHeader) + (size_t)count * sizeof(Record);
+
+        // Lower bound of the name hash, then check each record with it, in case of collisions
+        size_t low = 0, high = count;
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if (RecordAt(mid).nameHash < nameHash)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        for (size_t i = low; i < count; ++i)
+        {
+            const Record record = RecordAt(i);
+            if (record.nameHash != nameHash)
+                break;
+            if (std::string_view(names + record.nameOffset, record.nameLength) == filename)
+                return ContentEntry{ record.writeTime, record.size, record.hash, record.outputFingerprint,
+                    (record.flags & HasHash) != 0 };
+        }
+
+        return std::nullopt;
+    }
+
+    auto ContentCache::Find(const std::string &filename) const -> std::optional<ContentEntry>
+    {
+        auto it = changed.find(filename);
+        return it != changed.end() ? std::optional(it->second) : FindLoaded(filename);
+    }
+
+    auto ContentCache::Set(const std::string &filename, const ContentEntry &entry) -> void
+    {
+        changed[filename] = entry;
+    }
+
+    auto ContentCache::IsUnchanged(const std::string &filename, uint64_t size, long long writeTime) const -> bool
+    {
+        const auto entry = Find(filename);
+        return entry && entry->hasHash && entry->size == size && entry->writeTime == writeTime;
+    }
+
+    auto ContentCache::ContentMatches(const std::string &filename, uint64_t size, uint64_t hash) const -> bool
     {
-        auto it = cache.find(filename);
-        return (it == cache.end() || writeTime > it->second);
+        const auto entry = Find(filename);
+        return entry && entry->hasHash && entry->size == size && entry->hash == hash;
     }
-}
\ No newline at end of file
+}
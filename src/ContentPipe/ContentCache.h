@@ -1,24 +1,70 @@
 #pragma once
-#include <map>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace SDG::ContentPipe
 {
+    /// What the cache knows about a source file from the last time it was processed
+    struct ContentEntry
+    {
+        long long writeTime = 0;
+        uint64_t  size = 0;
+        uint64_t  hash = 0;
+        uint64_t  outputFingerprint = 0; ///< size and write time of the output file, or 0 if unknown
+        bool      hasHash = false;       ///< false for entries from caches that only stored timestamps
+
+        bool operator==(const ContentEntry &other) const = default;
+    };
+
+    /// Remembers what each source file held when it was processed, so unchanged files can be skipped.
+    /// Stored in a binary file, which is, in order:
+    ///     Header
+    ///     Record[entryCount]  sorted by name hash, then by name
+    ///     names               file names, packed without terminators
+    /// It is loaded with a single read and searched in place. Entries set since loading are kept separately, and
+    /// merged in when the cache is written.
     class ContentCache
     {
     public:
-        /// Loads cache file info from file at path
+        ContentCache();
+
+        /// Loads the binary cache file at path. A missing, damaged, or outdated file leaves the cache empty.
         auto Load(const std::string &path) -> bool;
 
-        /// Writes cache file out to path
+        /// Loads a text cache file written by older versions, so its entries carry over to the binary file
+        auto LoadText(const std::string &path) -> bool;
+
+        /// Writes the cache to a temporary file, then renames it over path, so an interrupted write leaves the
+        /// previous cache intact
         auto Write(const std::string &path) -> bool;
 
-        auto EntryIsNewer(const std::string &filename, long long writeTime) -> bool;
+        /// Gets the entry for a file, or nothing if it has not been processed before
+        auto Find(const std::string &filename) const -> std::optional<ContentEntry>;
 
-        auto &operator[](const std::string &key) { return cache[key]; }
-        const auto &operator[](const std::string &key) const { return cache.at(key); }
+        /// Adds or replaces the entry for a file
+        auto Set(const std::string &filename, const ContentEntry &entry) -> void;
+
+        /// Whether entries were set since the cache was loaded or written
+        auto IsModified() const -> bool { return !changed.empty(); }
+
+        /// Fast path: whether a file's size and write time match its entry, so its content needs no hashing
+        auto IsUnchanged(const std::string &filename, uint64_t size, long long writeTime) const -> bool;
+
+        /// Whether a file's content hash matches its entry, even though its timestamp may have changed
+        auto ContentMatches(const std::string &filename, uint64_t size, uint64_t hash) const -> bool;
 
     private:
-        std::map<std::string, long long> cache;
+        struct Record;
+
+        /// Searches the loaded file for an entry
+        auto FindLoaded(const std::string &filename) const -> std::optional<ContentEntry>;
+        auto RecordAt(size_t index) const -> Record;
+
+        std::vector<char> data;  ///< the loaded file, or empty
+        uint32_t count;          ///< number of records in data
+        std::unordered_map<std::string, ContentEntry> changed; ///< entries set since loading, which take precedence
     };
-}
\ No newline at end of file
+}
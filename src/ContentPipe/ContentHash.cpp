@@ -0,0 +1,12 @@
+#include "ContentHash.h"
+#include <Engine/Lib/Hash.h>
+
+#include <string_view>
+
+namespace SDG::ContentPipe
+{
+    auto HashContent(const void *data, size_t size, uint64_t seed) -> uint64_t
+    {
+        return Hash64(std::string_view(static_cast<const char *>(data), size), seed);
+    }
+}
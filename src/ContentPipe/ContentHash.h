@@ -0,0 +1,10 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace SDG::ContentPipe
+{
+    /// 64-bit XXH64 hash of a block of memory, used to tell whether an asset's content changed. The same as
+    /// SDG::Hash64, which the engine hashes with.
+    auto HashContent(const void *data, size_t size, uint64_t seed = 0) -> uint64_t;
+}
@@ -0,0 +1,380 @@
+#include "Daemon.h"
+#include "ContentHash.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+    #include <cerrno>
+    #include <csignal>
+    #include <cstring>
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace SDG::ContentPipe
+{
+    auto DaemonSocketPath(const BuildOptions &options) -> std::string
+    {
+        auto absolute = [](const std::string &path) {
+            return fs::absolute(path).lexically_normal().generic_string();
+        };
+
+        // Everything that changes the output, so a daemon never answers for different options
+        const std::string key = absolute(options.assetDir) + '\n' + absolute(options.outDir) + '\n' +
+            absolute(options.configPath) + '\n' + options.encryptionKey + '\n' + options.packPath + '\n' +
+            (options.packEncrypt ? "1" : "0");
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "SDG_ContentPipe_%016llx.sock",
+            (unsigned long long)HashContent(key.data(), key.size()));
+        return (fs::temp_directory_path() / name).string();
+    }
+
+#if defined(__linux__)
+    /// Set by SIGINT and SIGTERM, or a stop request, to end the daemon
+    static volatile std::sig_atomic_t stopRequested = 0;
+
+    static void OnStopSignal(int)
+    {
+        stopRequested = 1;
+    }
+
+    /// Watches a directory tree with inotify, reporting changed files relative to its root
+    class DirWatcher
+    {
+    public:
+        DirWatcher() : fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)), root(), dirs() { }
+        ~DirWatcher()
+        {
+            if (fd >= 0)
+                close(fd);
+        }
+
+        auto Watch(const std::string &rootDir) -> bool
+        {
+            root = rootDir;
+            return fd >= 0 && AddDir("");
+        }
+
+        auto Fd() const -> int { return fd; }
+
+        /// Reads pending events without blocking, appending the files that were written, moved, or deleted
+        auto Read(std::vector<std::string> &changed) -> void
+        {
+            alignas(inotify_event) char buffer[4096];
+            ssize_t length;
+            while ((length = read(fd, buffer, sizeof(buffer))) > 0)
+            {
+                for (const char *p = buffer; p < buffer + length; )
+                {
+                    const auto *event = reinterpret_cast<const inotify_event *>(p);
+                    p += sizeof(inotify_event) + event->len;
+
+                    if (event->mask & IN_Q_OVERFLOW)
+                        std::cerr << "[ContentPipe] Warning: too many changes at once, some were missed\n";
+
+                    auto it = dirs.find(event->wd);
+                    if (it == dirs.end() || event->len == 0)
+                        continue;
+
+                    const std::string path = it->second.empty() ? std::string(event->name) :
+                        it->second + '/' + event->name;
+                    if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+                        AddDir(path);
+                    else if (!(event->mask & IN_ISDIR))
+                        changed.push_back(path);
+                }
+            }
+        }
+
+    private:
+        auto AddDir(const std::string &relativeDir) -> bool
+        {
+            const fs::path dir = fs::path(root) / relativeDir;
+            int wd = inotify_add_watch(fd, dir.c_str(),
+                IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE | IN_ONLYDIR);
+            if (wd < 0)
+            {
+                std::cerr << "[ContentPipe] Failed to watch directory (" << dir.string() << "): "
+                    << std::strerror(errno) << '\n';
+                return false;
+            }
+            dirs[wd] = relativeDir;
+
+            std::error_code ec;
+            for (const auto &entry : fs::directory_iterator(dir, ec))
+            {
+                if (entry.is_directory(ec))
+                    AddDir(relativeDir.empty() ? entry.path().filename().string() :
+                        relativeDir + '/' + entry.path().filename().string());
+            }
+            return true;
+        }
+
+        int fd;
+        std::string root;
+        std::unordered_map<int, std::string> dirs; ///< directories relative to root, by watch descriptor
+    };
+
+    /// Connects to the daemon's socket, or returns -1 if none is listening
+    static auto Connect(const std::string &socketPath) -> int
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path))
+            return -1;
+        std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+        int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (sock < 0)
+            return -1;
+        if (connect(sock, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            close(sock);
+            return -1;
+        }
+        return sock;
+    }
+
+    static auto SendAll(int sock, const std::string &data) -> bool
+    {
+        for (size_t sent = 0; sent < data.size(); )
+        {
+            ssize_t count = send(sock, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (count <= 0)
+                return false;
+            sent += (size_t)count;
+        }
+        return true;
+    }
+
+    static auto ReceiveAll(int sock) -> std::string
+    {
+        std::string data;
+        char buffer[4096];
+        ssize_t count;
+        while ((count = recv(sock, buffer, sizeof(buffer), 0)) > 0)
+            data.append(buffer, (size_t)count);
+        return data;
+    }
+
+    /// Sends a one-line request, such as "build", and reads the whole reply
+    static auto SendRequest(const BuildOptions &options, const char *request, std::string *reply) -> bool
+    {
+        int sock = Connect(DaemonSocketPath(options));
+        if (sock < 0)
+            return false;
+
+        bool sent = SendAll(sock, std::string(request) + '\n');
+        shutdown(sock, SHUT_WR);
+        std::string data = ReceiveAll(sock);
+        close(sock);
+
+        if (reply)
+            *reply = std::move(data);
+        return sent;
+    }
+
+    /// Reads a client's request line, and answers it. Replies start with the exit status on a line of its own.
+    static auto Serve(int client, Builder &builder, DirWatcher &watcher) -> void
+    {
+        std::string request;
+        char c;
+        while (request.size() < 64 && recv(client, &c, 1, 0) == 1 && c != '\n')
+            request += c;
+
+        std::string reply;
+        if (request == "build")
+        {
+            // A file saved just before the request has its event queued already; build it too
+            std::vector<std::string> changed;
+            watcher.Read(changed);
+            for (const std::string &path : changed)
+                builder.MarkChanged(path);
+
+            std::ostringstream log;
+            int status = builder.Build(log, log);
+            std::cout << log.str();
+            reply = std::to_string(status) + '\n' + log.str();
+        }
+        else if (request == "ping")
+        {
+            reply = "0\n";
+        }
+        else if (request == "stop")
+        {
+            stopRequested = 1;
+            reply = "0\n";
+        }
+        else
+        {
+            reply = "1\n[ContentPipe] Unknown daemon request \"" + request + "\"\n";
+        }
+
+        SendAll(client, reply);
+    }
+
+    auto RunDaemon(Builder &builder) -> int
+    {
+        const BuildOptions &options = builder.Options();
+        const std::string socketPath = DaemonSocketPath(options);
+        if (SendRequest(options, "ping", nullptr))
+        {
+            std::cerr << "[ContentPipe] A daemon is already running for these assets (" << socketPath << ")\n";
+            return 1;
+        }
+
+        DirWatcher watcher;
+        if (!watcher.Watch(options.assetDir))
+            return 1;
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path))
+        {
+            std::cerr << "[ContentPipe] Socket path is too long (" << socketPath << ")\n";
+            return 1;
+        }
+        std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+        // No daemon answered, so any socket file left there is stale
+        unlink(socketPath.c_str());
+        int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listener < 0 || bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+            listen(listener, 8) != 0)
+        {
+            std::cerr << "[ContentPipe] Failed to listen on socket (" << socketPath << "): " << std::strerror(errno)
+                << '\n';
+            if (listener >= 0)
+                close(listener);
+            return 1;
+        }
+
+        std::signal(SIGINT, OnStopSignal);
+        std::signal(SIGTERM, OnStopSignal);
+
+        // Changes to the config are noticed by its write time, when it lives outside the asset directory
+        const std::string configPath = NormalizeRelative(
+            fs::path(options.configPath).lexically_relative(options.assetDir).generic_string());
+
+        std::cout << "[ContentPipe] Watching " << options.assetDir << " for changes; builds are served on "
+            << socketPath << '\n';
+        builder.MarkAll();
+        int status = builder.Build(std::cout, std::cerr);
+
+        // Editors often save a file in several writes, so changes are built once they settle
+        using Clock = std::chrono::steady_clock;
+        const auto settleTime = std::chrono::milliseconds(50);
+        Clock::time_point lastChange;
+        bool changesPending = false;
+
+        while (!stopRequested)
+        {
+            int timeout = -1;
+            if (changesPending)
+            {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    lastChange + settleTime - Clock::now());
+                timeout = (int)std::max<long long>(remaining.count(), 0);
+            }
+
+            pollfd fds[2] = { { watcher.Fd(), POLLIN, 0 }, { listener, POLLIN, 0 } };
+            if (poll(fds, 2, timeout) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                std::cerr << "[ContentPipe] Failed to wait for changes: " << std::strerror(errno) << '\n';
+                status = 1;
+                break;
+            }
+
+            if (fds[0].revents & POLLIN)
+            {
+                std::vector<std::string> changed;
+                watcher.Read(changed);
+                for (const std::string &path : changed)
+                {
+                    if (builder.MarkChanged(path) || NormalizeRelative(path) == configPath)
+                    {
+                        changesPending = true;
+                        lastChange = Clock::now();
+                    }
+                }
+            }
+
+            if (changesPending && Clock::now() - lastChange >= settleTime)
+            {
+                status = builder.Build(std::cout, std::cerr);
+                changesPending = false;
+            }
+
+            if (fds[1].revents & POLLIN)
+            {
+                int client = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+                if (client >= 0)
+                {
+                    Serve(client, builder, watcher);
+                    close(client);
+                    changesPending = builder.HasMarked();
+                }
+            }
+        }
+
+        close(listener);
+        unlink(socketPath.c_str());
+        std::cout << "[ContentPipe] Daemon stopped\n";
+        return status;
+    }
+
+    auto RequestBuild(const BuildOptions &options, std::ostream &out) -> int
+    {
+        std::string reply;
+        if (!SendRequest(options, "build", &reply))
+            return -1;
+
+        size_t lineEnd = reply.find('\n');
+        if (lineEnd == std::string::npos)
+        {
+            out << "[ContentPipe] Daemon closed the connection without finishing the build\n";
+            return 1;
+        }
+
+        out << reply.substr(lineEnd + 1);
+        return std::atoi(reply.substr(0, lineEnd).c_str());
+    }
+
+    auto RequestStop(const BuildOptions &options) -> bool
+    {
+        return SendRequest(options, "stop", nullptr);
+    }
+#else
+    auto RunDaemon(Builder &builder) -> int
+    {
+        std::cerr << "[ContentPipe] Watch mode is not supported on this platform\n";
+        return 1;
+    }
+
+    auto RequestBuild(const BuildOptions &options, std::ostream &out) -> int
+    {
+        return -1;
+    }
+
+    auto RequestStop(const BuildOptions &options) -> bool
+    {
+        return false;
+    }
+#endif
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "Builder.h"
+#include <iosfwd>
+#include <string>
+
+namespace SDG::ContentPipe
+{
+    /// Path of the local socket the daemon for these options listens on. Each asset directory, output directory,
+    /// config and pack gets its own, so several projects may each run a daemon.
+    auto DaemonSocketPath(const BuildOptions &options) -> std::string;
+
+    /// Builds every asset, then keeps running until interrupted or asked to stop: rebuilds the assets whose files
+    /// change as soon as they do, and answers build requests over the local socket. The config, cache and results
+    /// stay in memory, so a request that finds nothing changed returns without checking any files.
+    /// @return exit status
+    auto RunDaemon(Builder &builder) -> int;
+
+    /// Asks the daemon for these options to build any changes it has not built yet, and writes out its output
+    /// @return the build's exit status, or -1 if no daemon answered
+    auto RequestBuild(const BuildOptions &options, std::ostream &out) -> int;
+
+    /// Asks the daemon for these options to exit
+    /// @return whether a daemon answered
+    auto RequestStop(const BuildOptions &options) -> bool;
+}
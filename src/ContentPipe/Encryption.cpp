@@ -0,0 +1,16 @@
+#include "Encryption.h"
+
+namespace SDG::ContentPipe
+{
+    void EncryptData(char *data, size_t size, const std::string &key, size_t position)
+    {
+        for (size_t i = 0; i < size; ++i, ++position)
+        {
+            auto c = (unsigned char)data[i];
+            unsigned char add = key[position % key.length()];
+            c ^= ~add;
+            c = (unsigned char)(c + add - position);
+            data[i] = (char)c;
+        }
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace SDG::ContentPipe
+{
+    /// Encrypts data in place with the .sdgc scheme, which IO::ReadEncryptedFile reverses at runtime
+    /// @param position - offset of data[0] in the file
+    void EncryptData(char *data, size_t size, const std::string &key, size_t position = 0);
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+namespace SDG::ContentPipe
+{
+    /// Free space of a page, tracked with the MaxRects algorithm: a list of the largest free rectangles, which may
+    /// overlap each other
+    class MaxRectsBin
+    {
+    public:
+        struct Box
+        {
+            unsigned x, y, width, height;
+        };
+
+        MaxRectsBin(unsigned width, unsigned height) : free{ { 0, 0, width, height } } { }
+
+        /// Takes space for a rectangle where it fits best: leaving the shortest side, then the shortest long side
+        /// @return whether it fit
+        auto Insert(unsigned width, unsigned height, bool allowRotate, Box *placed, bool *rotated) -> bool
+        {
+            unsigned bestShort = UINT_MAX, bestLong = UINT_MAX;
+            bool found = false;
+            auto consider = [&](const Box &box, unsigned w, unsigned h, bool turned) {
+                if (w > box.width || h > box.height)
+                    return;
+
+                const unsigned shortSide = std::min(box.width - w, box.height - h);
+                const unsigned longSide = std::max(box.width - w, box.height - h);
+                if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong))
+                {
+                    bestShort = shortSide;
+                    bestLong = longSide;
+                    *placed = { box.x, box.y, w, h };
+                    *rotated = turned;
+                    found = true;
+                }
+            };
+
+            for (const Box &box : free)
+            {
+                consider(box, width, height, false);
+                if (allowRotate && width != height)
+                    consider(box, height, width, true);
+            }
+
+            if (found)
+                Place(*placed);
+            return found;
+        }
+
+    private:
+        static auto Contains(const Box &a, const Box &b) -> bool
+        {
+            return b.x >= a.x && b.y >= a.y && b.x + b.width <= a.x + a.width && b.y + b.height <= a.y + a.height;
+        }
+
+        /// Removes used space from the free rectangles, splitting those it overlaps
+        auto Place(const Box &used) -> void
+        {
+            std::vector<Box> kept, added;
+            for (const Box &box : free)
+            {
+                if (used.x >= box.x + box.width || used.x + used.width <= box.x ||
+                    used.y >= box.y + box.height || used.y + used.height <= box.y)
+                {
+                    kept.push_back(box);
+                    continue;
+                }
+
+                // The free parts left of, right of, above, and below the used space
+                if (used.x > box.x)
+                    added.push_back({ box.x, box.y, used.x - box.x, box.height });
+                if (used.x + used.width < box.x + box.width)
+                    added.push_back({ used.x + used.width, box.y, box.x + box.width - used.x - used.width,
+                        box.height });
+                if (used.y > box.y)
+                    added.push_back({ box.x, box.y, box.width, used.y - box.y });
+                if (used.y + used.height < box.y + box.height)
+                    added.push_back({ box.x, used.y + used.height, box.width,
+                        box.y + box.height - used.y - used.height });
+            }
+
+            // Drop rectangles inside others. Kept ones were not inside each other before, so only the added ones
+            // need checking against the rest.
+            std::vector<Box> addedMaximal;
+            for (size_t i = 0; i < added.size(); ++i)
+            {
+                bool inside = std::any_of(kept.begin(), kept.end(),
+                    [&](const Box &box) { return Contains(box, added[i]); });
+                for (size_t j = 0; j < added.size() && !inside; ++j)
+                {
+                    // Of two equal rectangles, keep the first
+                    inside = j != i && Contains(added[j], added[i]) && (j < i || !Contains(added[i], added[j]));
+                }
+
+                if (!inside)
+                    addedMaximal.push_back(added[i]);
+            }
+
+            free.clear();
+            for (const Box &box : kept)
+            {
+                if (std::none_of(addedMaximal.begin(), addedMaximal.end(),
+                    [&](const Box &other) { return Contains(other, box); }))
+                    free.push_back(box);
+            }
+            free.insert(free.end(), addedMaximal.begin(), addedMaximal.end());
+        }
+
+        std::vector<Box> free;
+    };
+}
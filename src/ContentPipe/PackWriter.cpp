@@ -0,0 +1,172 @@
+#include "PackWriter.h"
+#include "ContentHash.h"
+#include "Encryption.h"
+#include <Engine/Filesys/PackFormat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace SDG::ContentPipe
+{
+    auto PackWriter::Add(std::string name, fs::path source, uint64_t hash) -> void
+    {
+        items.push_back({ std::move(name), std::move(source), hash });
+    }
+
+    auto PackWriter::Fingerprint(const std::string &key) const -> uint64_t
+    {
+        // Order-independent, so it matches however the files were listed
+        std::vector<const Item *> sorted;
+        for (const Item &item : items)
+            sorted.push_back(&item);
+        std::sort(sorted.begin(), sorted.end(), [](const Item *a, const Item *b) { return a->name < b->name; });
+
+        // A hash of the key, not the key itself, since the fingerprint is stored in the pack's header
+        std::string record = std::to_string(PackFormat::Version) + (key.empty() ? "p" : "e");
+        const uint64_t keyHash = key.empty() ? 0 : HashContent(key.data(), key.size());
+        record.append((const char *)&keyHash, sizeof(keyHash));
+        for (const Item *item : sorted)
+        {
+            record += item->name;
+            record.push_back('\0');
+            record.append((const char *)&item->hash, sizeof(item->hash));
+        }
+
+        return HashContent(record.data(), record.size());
+    }
+
+    auto PackWriter::IsCurrent(const std::string &path, const std::string &key) const -> bool
+    {
+        std::ifstream file(path, std::ios::binary);
+        PackFormat::Header header{};
+        if (!file.is_open() || !file.read((char *)&header, sizeof(header)))
+            return false;
+
+        return std::memcmp(header.magic, PackFormat::Magic, sizeof(PackFormat::Magic)) == 0 &&
+            header.version == PackFormat::Version && header.entryCount == items.size() &&
+            header.fingerprint == Fingerprint(key);
+    }
+
+    auto PackWriter::Write(const std::string &path, const std::string &key, std::string *error) -> bool
+    {
+        const bool encrypt = !key.empty();
+
+        // Table of contents is sorted by path hash, which is what the runtime binary searches
+        std::vector<PackFormat::TocEntry> toc(items.size());
+        std::vector<const Item *> sorted;
+        for (const Item &item : items)
+            sorted.push_back(&item);
+        std::sort(sorted.begin(), sorted.end(), [](const Item *a, const Item *b) {
+            uint64_t hashA = PackFormat::HashPath(a->name), hashB = PackFormat::HashPath(b->name);
+            return hashA < hashB || (hashA == hashB && a->name < b->name);
+        });
+
+        std::string names;
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            const Item &item = *sorted[i];
+            if (i > 0 && item.name == sorted[i - 1]->name)
+            {
+                *error = "file is listed more than once: " + item.name;
+                return false;
+            }
+
+            if (item.name.size() > UINT16_MAX)
+            {
+                *error = "file path is too long to pack: " + item.name;
+                return false;
+            }
+
+            toc[i].pathHash = PackFormat::HashPath(item.name);
+            toc[i].nameOffset = (uint32_t)names.size();
+            toc[i].nameLength = (uint16_t)item.name.size();
+            toc[i].flags = encrypt ? PackFormat::Encrypted : 0;
+            names += item.name;
+        }
+
+        PackFormat::Header header{};
+        std::memcpy(header.magic, PackFormat::Magic, sizeof(header.magic));
+        header.version = PackFormat::Version;
+        header.entryCount = (uint32_t)toc.size();
+        header.alignment = PackFormat::Alignment;
+        header.namesOffset = sizeof(header) + toc.size() * sizeof(PackFormat::TocEntry);
+        header.namesSize = names.size();
+        header.fingerprint = Fingerprint(key);
+
+        // Lay out blobs from their current sizes, each followed by a '\0'
+        uint64_t offset = PackFormat::Align(header.namesOffset + header.namesSize);
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            std::error_code ec;
+            toc[i].size = fs::file_size(sorted[i]->source, ec);
+            if (ec)
+            {
+                *error = "failed to get size of file: " + sorted[i]->source.string();
+                return false;
+            }
+
+            toc[i].offset = offset;
+            offset = PackFormat::Align(offset + toc[i].size + 1);
+        }
+
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+            {
+                *error = "failed to open file for writing: " + tempPath;
+                return false;
+            }
+
+            out.write((const char *)&header, sizeof(header));
+            out.write((const char *)toc.data(), (std::streamsize)(toc.size() * sizeof(PackFormat::TocEntry)));
+            out.write(names.data(), (std::streamsize)names.size());
+
+            std::vector<char> data;
+            for (size_t i = 0; i < sorted.size(); ++i)
+            {
+                // Pad up to the blob's aligned offset
+                uint64_t position = (uint64_t)out.tellp();
+                std::fill_n(std::ostreambuf_iterator<char>(out), toc[i].offset - position, '\0');
+
+                data.resize(toc[i].size);
+                std::ifstream in(sorted[i]->source, std::ios::binary);
+                if (!in.is_open() || !in.read(data.data(), (std::streamsize)data.size()) || in.peek() != EOF)
+                {
+                    *error = "failed to read file, or it changed while packing: " + sorted[i]->source.string();
+                    out.close();
+                    fs::remove(tempPath);
+                    return false;
+                }
+
+                if (encrypt)
+                    EncryptData(data.data(), data.size(), key);
+
+                data.push_back('\0');
+                out.write(data.data(), (std::streamsize)data.size());
+            }
+
+            if (!out)
+            {
+                *error = "failed while writing file: " + tempPath;
+                out.close();
+                fs::remove(tempPath);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, path, ec);
+        if (ec)
+        {
+            *error = "failed to replace " + path + ": " + ec.message();
+            fs::remove(tempPath, ec);
+            return false;
+        }
+
+        return true;
+    }
+}
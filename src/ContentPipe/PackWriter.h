@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace SDG::ContentPipe
+{
+    /// Writes .sdgpack archives, laid out as described in Engine/Filesys/PackFormat.h
+    class PackWriter
+    {
+    public:
+        /// Adds a file to be packed
+        /// @param name   - path of the file in the pack, using '/' separators
+        /// @param source - file to copy into the pack
+        /// @param hash   - content hash of the source, which goes into the pack's fingerprint
+        auto Add(std::string name, std::filesystem::path source, uint64_t hash) -> void;
+
+        auto Size() const -> size_t { return items.size(); }
+
+        /// Whether the pack at path already holds exactly the added files, written with the same key, so it need
+        /// not be rewritten
+        /// @param key - key the pack would be encrypted with, or empty when it would not be
+        auto IsCurrent(const std::string &path, const std::string &key) const -> bool;
+
+        /// Writes the pack to a temporary file, then renames it over path, so a failed or interrupted write leaves
+        /// any previous pack intact.
+        /// @param key - when not empty, encrypts each file with the .sdgc scheme
+        auto Write(const std::string &path, const std::string &key, std::string *error) -> bool;
+
+    private:
+        struct Item
+        {
+            std::string name;
+            std::filesystem::path source;
+            uint64_t hash;
+        };
+
+        /// Identifies the added files, their content, and the key they are encrypted with
+        auto Fingerprint(const std::string &key) const -> uint64_t;
+
+        std::vector<Item> items;
+    };
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace SDG::ContentPipe
+{
+    /// Runs func(i) for each i in [0, count) across a number of threads, the calling thread included
+    template <typename Func>
+    void ParallelFor(size_t count, unsigned threadCount, Func func)
+    {
+        std::atomic<size_t> next = 0;
+        auto worker = [&]() {
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count; )
+                func(i);
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < threadCount && t < count; ++t)
+            threads.emplace_back(worker);
+
+        worker();
+        for (auto &thread : threads)
+            thread.join();
+    }
+}
@@ -5,8 +5,12 @@
 #include <Engine/Exceptions/AssertionException.h>
 #include <Engine/Filesys/Filesys.h>
 #include <Engine/Game/Datatypes/AppConfig.h>
+#include <Engine/Game/ServiceProvider.h>
 #include <Engine/Graphics/WindowMgr.h>
 #include <Engine/Input/Input.h>
+#include <Engine/Jobs/JobSystem.h>
+#include <Engine/Lib/AllocationCounter.h>
+#include <Engine/Lib/FrameArena.h>
 #include <Engine/Platform.h>
 
 #include <SDL.h>
@@ -27,7 +31,7 @@ namespace SDG
     {
         Impl() 
             : windows(new WindowMgr), mainWindow(), isRunning(), time(), 
-            fileSys(), config() {}
+            fileSys(), config(), frameStats(), frameArena(), frameAllocations(), jobs(), services() {}
         ~Impl();
 
         void Initialize(const AppConfig &config);
@@ -38,6 +42,11 @@ namespace SDG
         AppTime     time;
         Filesys     fileSys;
         AppConfig   config;
+        RenderStats frameStats;
+        FrameArena  frameArena;
+        size_t      frameAllocations;
+        JobSystem   jobs;
+        ServiceProvider services;
     };
 
 
@@ -81,6 +90,10 @@ namespace SDG
         InputDriver::Initialize(SDG_INPUTTYPE_DEFAULT);
         SDG_Core_Log("- input driver: ok");
 
+        impl->jobs.Start(config.workers);
+        impl->services.Emplace<JobSystem>(impl->jobs);
+        SDG_Core_Log("- job system: ok, {} workers", impl->jobs.WorkerCount());
+
         impl->isRunning = true;
         return Initialize(); // Child class initialization;
     }
@@ -114,6 +127,7 @@ namespace SDG
     {
         try {
             ProcessInput();
+            impl->jobs.PumpMainThread();
             Update_();
             Render_();
         }
@@ -122,12 +136,19 @@ namespace SDG
             SDG_Core_Err("{}", e.what());
             Exit();
         }
+
+        // Frame memory is done with; start the next frame's allocation count
+        impl->frameArena.Reset();
+        impl->frameAllocations = AllocationCounter::Count();
+        AllocationCounter::Reset();
     }
 
 
     auto Engine::Close_() -> void
     {
         Close(); // Child class clean up
+        impl->jobs.Stop(); // before the windows, since main-thread jobs may still use the GL context
+        impl->services.RemoveAll();
         InputDriver::Close();
         Path::PopFileSys();
         impl->windows->Close();
@@ -187,6 +208,11 @@ namespace SDG
     {
         Render();
         impl->windows->SwapBuffers();
+
+        // Keep the finished frame's stats, and start counting the next one
+        RenderStats &stats = RenderStats::Frame();
+        impl->frameStats = stats;
+        stats.Reset();
     }
 
 
@@ -195,6 +221,31 @@ namespace SDG
         return impl->time;
     }
 
+    auto Engine::FrameStats() const -> Ref<const RenderStats>
+    {
+        return impl->frameStats;
+    }
+
+    auto Engine::FrameMemory() -> Ref<FrameArena>
+    {
+        return impl->frameArena;
+    }
+
+    auto Engine::FrameAllocations() const -> size_t
+    {
+        return impl->frameAllocations;
+    }
+
+    auto Engine::Jobs() -> Ref<JobSystem>
+    {
+        return impl->jobs;
+    }
+
+    auto Engine::Services() -> Ref<ServiceProvider>
+    {
+        return impl->services;
+    }
+
     auto Engine::Name() const -> const String &
     {
         return impl->config.appName;
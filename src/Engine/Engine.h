@@ -9,6 +9,7 @@
 #pragma once
 #include <Engine/Filesys/Path.h>
 #include <Engine/Game/Datatypes/AppConfig.h>
+#include <Engine/Graphics/RenderStats.h>
 #include <Engine/Lib/Ref.h>
 #include <Engine/Lib/Unique.h>
 #include <Engine/Lib/String.h>
@@ -47,6 +48,23 @@ namespace SDG
 
         Ref<const AppTime> Time();
 
+        /// Rendering stats of the last completed frame
+        Ref<const RenderStats> FrameStats() const;
+
+        /// Scratch memory for the current frame, released at the end of RunOneFrame
+        Ref<class FrameArena> FrameMemory();
+
+        /// Heap allocations made during the last completed frame. Always zero unless
+        /// SDG_COUNT_ALLOCATIONS is enabled (on by default in debug builds).
+        size_t FrameAllocations() const;
+
+        /// Job system whose workers run from initialization until shutdown. Its
+        /// main-thread jobs are run once per frame, before Update.
+        Ref<class JobSystem> Jobs();
+
+        /// Services the engine provides, such as the JobSystem
+        Ref<class ServiceProvider> Services();
+
         static Version Version();
     protected:
         // Access for base classes
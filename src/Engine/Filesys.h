@@ -1,6 +1,8 @@
 /// Contains the includes relevant to path handling and file reading/writing.
 #pragma once
+#include "Filesys/AssetID.h"
 #include "Filesys/File.h"
+#include "Filesys/FileWatcher.h"
 #include "Filesys/Filesys.h"
 #include "Filesys/Path.h"
 #include "Filesys/Xml.h"
@@ -0,0 +1,51 @@
+/* ====================================================================================================================
+ * @file AssetID.h
+ * @class SDG::AssetID
+ * Identifies an asset by the 64-bit hash of its Path. IDs of string literals are computed at compile time, so hot code
+ * can find assets without building or hashing strings:
+ *     using namespace SDG::Literals;
+ *     constexpr AssetID PlayerId = "img/player.png"_asset;  // same as AssetID(BasePath("img/player.png"))
+ *     TextureHandle player = assets.FindTexture(PlayerId);
+ *
+ * Literals and the string_view constructor hash the subpath as written, so give them paths the way Path stores them:
+ * '/' separated, without leading or trailing slashes.
+ * ==================================================================================================================*/
+#pragma once
+#include "Path.h"
+#include <Engine/Lib/Hash.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace SDG
+{
+    class AssetID
+    {
+    public:
+        /// Creates an ID that refers to no asset
+        constexpr AssetID() : value() { }
+        /// Creates the ID of the path with the subpath under base
+        constexpr explicit AssetID(std::string_view subpath, Path::BaseDir base = Path::BaseDir::Base) :
+            value(Path::HashSubpath(subpath, base)) { }
+        /// Creates the ID of a path. Not explicit, so Paths may be passed where IDs are taken.
+        AssetID(const Path &path) : value(path.Hash()) { }
+
+        [[nodiscard]] constexpr uint64_t Value() const { return value; }
+        [[nodiscard]] constexpr bool Empty() const { return value == 0; }
+
+        constexpr bool operator == (const AssetID &other) const { return value == other.value; }
+        constexpr bool operator != (const AssetID &other) const { return value != other.value; }
+    private:
+        uint64_t value;
+    };
+
+    namespace Literals
+    {
+        /// ID of an asset under the base directory, computed at compile time
+        consteval AssetID operator""_asset(const char *subpath, size_t length)
+        {
+            return AssetID(std::string_view(subpath, length), Path::BaseDir::Base);
+        }
+    }
+}
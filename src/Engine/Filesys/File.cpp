@@ -3,6 +3,7 @@
 //  SDG_Engine
 //
 #include "File.h"
+#include "Pack.h"
 #include <Engine/Debug/Log.h>
 
 #include <Engine/Exceptions/InvalidArgumentException.h>
@@ -131,6 +132,11 @@ namespace SDG
     File::Open(const Path &path)
     {
         Close();
+
+        Pack::Entry entry;
+        if (Pack::FindMounted(path, &entry))
+            return OpenPackedImpl(path, entry);
+
         return (path.Extension() == "sdgc") ?
                OpenEncryptedImpl(path) :
                OpenImpl(path);
@@ -177,6 +183,29 @@ namespace SDG
         return result;
     }
 
+    bool
+    File::OpenPackedImpl(const Path &path, const Pack::Entry &entry)
+    {
+        if (entry.encrypted)
+        {
+            // Encrypted entries cannot be used in place, so decrypt a copy
+            auto mem = static_cast<uint8_t *>(Malloc(entry.size + 1));
+            IO::Decrypt(entry.data, mem, entry.size);
+            mem[entry.size] = '\0';
+            impl->buf = Buffer(mem, entry.size);
+        }
+        else
+        {
+            // View the mapped pack, which is null-terminated after each entry
+            impl->buf = Buffer::View(entry.data, entry.size);
+        }
+
+        impl->error = "No errors.";
+        impl->isOpen = true;
+        impl->path = path;
+        return true;
+    }
+
     void
     File::Close()
     {
@@ -6,6 +6,7 @@
  * Intended for cleanly wrapping and loading game assets.
  */
 #pragma once
+#include "Pack.h"
 #include "Path.h"
 
 struct SDL_RWops;
@@ -32,6 +33,7 @@ public:
     explicit File(const Path &path);
 
     /// Loads data found in the file at path into the File class.
+    /// Files in a mounted Pack are viewed in place rather than read from disk.
     /// @param path path to the file
     bool Open(const Path &path);
 
@@ -128,6 +130,9 @@ private:
     /// Loads an encrypted file
     bool OpenEncryptedImpl(const Path &path);
 
+    /// Opens a file from a mounted Pack, viewing its data in place when it is not encrypted
+    bool OpenPackedImpl(const Path &path, const Pack::Entry &entry);
+
     /// Private implementation
     Impl *impl;
 };
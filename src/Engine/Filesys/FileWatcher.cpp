@@ -0,0 +1,196 @@
+#include "FileWatcher.h"
+#include <Engine/Debug/Log.h>
+#include <Engine/Platform.h>
+
+#include <filesystem>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if (SDG_TARGET_LINUX)
+    #include <cerrno>
+    #include <cstring>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+namespace SDG
+{
+    /// Path of an entry in a directory, with the directory's base
+    static Path ChildPath(const Path &dir, const String &name)
+    {
+        return dir.Subpath().Empty() ? Path(name, dir.Base()) : dir + name;
+    }
+
+    struct FileWatcher::Impl
+    {
+        Impl() : fd(-1), dirs(), error() { }
+
+        /// Watches a directory and its subdirectories
+        /// @param files - if not null, receives the files already in them
+        bool AddDir(const Path &dir, std::vector<Path> *files);
+
+        int fd;                                ///< inotify instance, or -1 before the first Watch
+        std::unordered_map<int, Path> dirs;    ///< watched directories by watch descriptor
+        String error;
+    };
+
+#if (SDG_TARGET_LINUX)
+    bool
+    FileWatcher::Impl::AddDir(const Path &dir, std::vector<Path> *files)
+    {
+        const String dirStr = dir.Str();
+        int wd = inotify_add_watch(fd, dirStr.Cstr(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+        if (wd < 0)
+        {
+            error = String::Format("failed to watch directory ({}): {}", dirStr, std::strerror(errno));
+            return false;
+        }
+        dirs[wd] = dir;
+
+        // Subdirectories are watched separately, and a new one may already hold files by the time it is watched
+        std::error_code ec;
+        for (const auto &entry : std::filesystem::directory_iterator(dirStr.Cstr(), ec))
+        {
+            const Path child = ChildPath(dir, entry.path().filename().string().c_str());
+            if (entry.is_directory(ec))
+                AddDir(child, files);
+            else if (files && entry.is_regular_file(ec))
+                files->emplace_back(child);
+        }
+
+        return true;
+    }
+#else
+    bool
+    FileWatcher::Impl::AddDir(const Path &dir, std::vector<Path> *files)
+    {
+        error = String::Format("failed to watch directory ({}): file watching is not supported on this platform",
+            dir.Str());
+        return false;
+    }
+#endif
+
+    FileWatcher::FileWatcher() : impl(new Impl)
+    {
+
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        Close();
+        delete impl;
+    }
+
+    bool
+    FileWatcher::IsSupported()
+    {
+        return SDG_TARGET_LINUX;
+    }
+
+    bool
+    FileWatcher::Watch(const Path &dir)
+    {
+#if (SDG_TARGET_LINUX)
+        if (impl->fd < 0)
+        {
+            impl->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (impl->fd < 0)
+            {
+                impl->error = String::Format("failed to initialize inotify: {}", std::strerror(errno));
+                return false;
+            }
+        }
+#endif
+        return impl->AddDir(dir, nullptr);
+    }
+
+    void
+    FileWatcher::Close()
+    {
+#if (SDG_TARGET_LINUX)
+        if (impl->fd >= 0)
+        {
+            close(impl->fd); // removes every watch
+            impl->fd = -1;
+        }
+#endif
+        impl->dirs.clear();
+    }
+
+    size_t
+    FileWatcher::Poll(const std::function<void(const Path &)> &onChange)
+    {
+        std::vector<Path> changed;
+#if (SDG_TARGET_LINUX)
+        if (impl->fd < 0)
+            return 0;
+
+        std::unordered_set<uint64_t> seen;
+        auto report = [&changed, &seen](const Path &path) {
+            if (seen.insert(path.Hash()).second)
+                changed.emplace_back(path);
+        };
+
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(impl->fd, buffer, sizeof(buffer))) > 0)
+        {
+            for (const char *p = buffer; p < buffer + length; )
+            {
+                const auto *event = reinterpret_cast<const inotify_event *>(p);
+                p += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    SDG_Core_Warn("FileWatcher: too many changes at once, some were missed");
+                    continue;
+                }
+
+                auto it = impl->dirs.find(event->wd);
+                if (it == impl->dirs.end())
+                    continue;
+                if (event->mask & IN_IGNORED) // directory was removed
+                {
+                    impl->dirs.erase(it);
+                    continue;
+                }
+                if (event->len == 0)
+                    continue;
+
+                const Path path = ChildPath(it->second, event->name);
+                if (event->mask & IN_ISDIR)
+                {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        std::vector<Path> files;
+                        impl->AddDir(path, &files);
+                        for (const Path &file : files)
+                            report(file);
+                    }
+                }
+                else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                {
+                    report(path);
+                }
+            }
+        }
+#endif
+        for (const Path &path : changed)
+            onChange(path);
+        return changed.size();
+    }
+
+    size_t
+    FileWatcher::Count() const
+    {
+        return impl->dirs.size();
+    }
+
+    const char *
+    FileWatcher::GetError() const
+    {
+        return impl->error.Cstr();
+    }
+}
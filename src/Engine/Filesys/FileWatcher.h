@@ -0,0 +1,54 @@
+/* ====================================================================================================================
+ * @file FileWatcher.h
+ * @class SDG::FileWatcher
+ * Notices files written, created, or moved into watched directories, for reloading assets while the game runs.
+ * Changes are reported as Paths with the same base directory as the watched directory, so they compare equal, and
+ * hash the same, as the Paths the game loads assets with:
+ *     watcher.Watch(BasePath("assets"));
+ *     watcher.Poll([](const Path &path) { ... });  // path == BasePath("assets/img/player.sdgc")
+ *
+ * Uses inotify on Linux. Other platforms are not supported yet: Watch fails, and Poll reports nothing.
+ * ==================================================================================================================*/
+#pragma once
+#include "Path.h"
+#include <Engine/Lib/ClassMacros.h>
+
+#include <cstddef>
+#include <functional>
+
+namespace SDG
+{
+    class FileWatcher
+    {
+        SDG_NOCOPY(FileWatcher);
+        struct Impl;
+    public:
+        FileWatcher();
+        ~FileWatcher();
+
+        /// Whether watching files is supported on the current platform
+        [[nodiscard]] static bool IsSupported();
+
+        /// Watches a directory and its subdirectories, including ones created later. Check GetError on failure.
+        bool Watch(const Path &dir);
+
+        /// Stops watching every directory
+        void Close();
+
+        /**
+         * Reports files changed since the last call, without blocking. Call on the thread that owns the watcher,
+         * such as once per frame. A file written several times in between is reported once, after its last write.
+         * @param onChange - invoked with the path of each changed file
+         * @return number of changed files reported
+         */
+        size_t Poll(const std::function<void(const Path &)> &onChange);
+
+        /// Number of directories watched
+        [[nodiscard]] size_t Count() const;
+
+        /// Gets the reason the last call to Watch failed
+        [[nodiscard]] const char *GetError() const;
+    private:
+        Impl *impl;
+    };
+}
@@ -9,21 +9,24 @@ namespace SDG
 {
     struct JsonLoadable::Impl
     {
-        Impl(const String &typeName) : typeName(typeName), j() { }
+        Impl(const String &typeName) : typeName(typeName), j(), path() { }
         String typeName;
         json j;
+        Path path; ///< file last loaded, for Reload
     };
 
     JsonLoadable::JsonLoadable(const String &name) : impl(new Impl(name)) { }
     JsonLoadable::JsonLoadable(const JsonLoadable &loadable) : impl(new Impl(loadable.impl->typeName)) 
     {
         impl->j = loadable.impl->j;
+        impl->path = loadable.impl->path;
     }
 
     JsonLoadable &JsonLoadable::operator=(const JsonLoadable &loadable)
     {
         impl->typeName = loadable.impl->typeName;
         impl->j = loadable.impl->j;
+        impl->path = loadable.impl->path;
         return *this;
     }
 
@@ -32,6 +35,35 @@ namespace SDG
     void JsonLoadable::LoadJson(const Path &path)
     {
         LoadJson(OpenJson(path));
+        impl->path = path;
+    }
+
+    bool JsonLoadable::Reload()
+    {
+        if (impl->path.Empty())
+        {
+            SDG_Core_Err("{}::Reload: json was not loaded from a file", impl->typeName);
+            return false;
+        }
+
+        json j;
+        try {
+            j = OpenJson(impl->path);
+        }
+        catch (const std::exception &e)
+        {
+            // Keep the current data, since the file may be saved again once fixed
+            SDG_Core_Err("{}::Reload: failed to open json ({}): {}", impl->typeName, impl->path.Str(), e.what());
+            return false;
+        }
+
+        LoadJson(j);
+        return true;
+    }
+
+    const Path &JsonLoadable::Filepath() const
+    {
+        return impl->path;
     }
 
     const String &JsonLoadable::TypeName() const
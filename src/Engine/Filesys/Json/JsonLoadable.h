@@ -19,6 +19,13 @@ namespace SDG
         void LoadJson(const Path &path);
         void LoadJson(const json &j);
 
+        /// Loads the file last loaded with LoadJson(const Path &) again, such as after it changed on disk.
+        /// Keeps the current data if the file cannot be opened.
+        bool Reload();
+
+        /// Gets the file last loaded with LoadJson(const Path &), or an empty Path
+        [[nodiscard]] const Path &Filepath() const;
+
         [[nodiscard]] json &Json();
         [[nodiscard]] const json &Json() const;
         [[nodiscard]] const String &TypeName() const;
@@ -0,0 +1,247 @@
+#include "Pack.h"
+#include "PackFormat.h"
+#include "Private/MappedFile.h"
+#include <Engine/Lib/Endian.h>
+
+#include <SDL_rwops.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace SDG
+{
+    struct Pack::Impl
+    {
+        Impl() : file(), toc(), names(), entryCount(), error("No errors.") { }
+
+        /// Points into the mapped file after it has been validated
+        bool Load();
+        void Reset()
+        {
+            file.Close();
+            toc = nullptr;
+            names = nullptr;
+            entryCount = 0;
+        }
+
+        IO::MappedFile file;
+        const PackFormat::TocEntry *toc;
+        const char *names;
+        size_t entryCount;
+        String error;
+    };
+
+    /// A pack made visible to File::Open under a directory
+    struct PackMount
+    {
+        Pack *pack;
+        Path point;
+    };
+
+    static std::vector<PackMount> mounts;
+
+    bool
+    Pack::Impl::Load()
+    {
+        using namespace PackFormat;
+
+        if (SystemEndian() != Endian::Little)
+        {
+            error = "Pack: packs are only supported on little-endian systems";
+            return false;
+        }
+
+        const uint8_t *data = file.Data();
+        const size_t size = file.Size();
+        if (size < sizeof(Header))
+        {
+            error = "Pack: file is too small to be a pack";
+            return false;
+        }
+
+        Header header;
+        std::memcpy(&header, data, sizeof(Header));
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+        {
+            error = "Pack: file is not a pack";
+            return false;
+        }
+
+        if (header.version != Version)
+        {
+            error = String::Format("Pack: unsupported pack version {}, expected {}", header.version, Version);
+            return false;
+        }
+
+        const uint64_t tocEnd = sizeof(Header) + (uint64_t)header.entryCount * sizeof(TocEntry);
+        // Subtraction forms, so offsets and sizes from a damaged pack cannot wrap around past the checks
+        if (tocEnd > size || header.namesOffset < tocEnd || header.namesOffset > size ||
+            header.namesSize > size - header.namesOffset)
+        {
+            error = "Pack: table of contents is out of bounds";
+            return false;
+        }
+
+        // Header is a multiple of 8 bytes, and maps are page-aligned, so entries can be read in place
+        toc = reinterpret_cast<const TocEntry *>(data + sizeof(Header));
+        names = reinterpret_cast<const char *>(data + header.namesOffset);
+        entryCount = header.entryCount;
+
+        for (size_t i = 0; i < entryCount; ++i)
+        {
+            const TocEntry &entry = toc[i];
+            if (entry.offset > size || entry.size >= size - entry.offset ||
+                (uint64_t)entry.nameOffset + entry.nameLength > header.namesSize ||
+                (i > 0 && entry.pathHash < toc[i - 1].pathHash))
+            {
+                error = String::Format("Pack: entry {} is invalid", i);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    Pack::Pack() : impl(new Impl)
+    {
+
+    }
+
+    Pack::Pack(const Path &path) : impl(new Impl)
+    {
+        Open(path);
+    }
+
+    Pack::~Pack()
+    {
+        Unmount(this);
+        delete impl;
+    }
+
+    bool
+    Pack::Open(const Path &path)
+    {
+        Close();
+
+        String filepath = path.Str();
+        if (!impl->file.Open(filepath.Cstr()))
+        {
+            impl->error = String("Pack::Open: ") + impl->file.GetError();
+            return false;
+        }
+
+        if (!impl->Load())
+        {
+            impl->error = String::Format("{} ({})", impl->error, filepath);
+            impl->Reset();
+            return false;
+        }
+
+        impl->error = "No errors.";
+        return true;
+    }
+
+    void
+    Pack::Close()
+    {
+        impl->Reset();
+    }
+
+    bool
+    Pack::IsOpen() const
+    {
+        return impl->file.IsOpen();
+    }
+
+    const char *
+    Pack::GetError() const
+    {
+        return impl->error.Cstr();
+    }
+
+    size_t
+    Pack::EntryCount() const
+    {
+        return impl->entryCount;
+    }
+
+    bool
+    Pack::Find(StringView path, Entry *outEntry) const
+    {
+        const uint64_t hash = PackFormat::HashPath({ path.Data(), path.Length() });
+        const PackFormat::TocEntry *end = impl->toc + impl->entryCount;
+        auto it = std::lower_bound(impl->toc, end, hash,
+            [](const PackFormat::TocEntry &entry, uint64_t value) { return entry.pathHash < value; });
+
+        // Names are compared too, in case two paths share a hash
+        for (; it != end && it->pathHash == hash; ++it)
+        {
+            if (it->nameLength == path.Length() &&
+                std::memcmp(impl->names + it->nameOffset, path.Data(), path.Length()) == 0)
+            {
+                if (outEntry)
+                {
+                    outEntry->data = impl->file.Data() + it->offset;
+                    outEntry->size = (size_t)it->size;
+                    outEntry->encrypted = (it->flags & PackFormat::Encrypted) != 0;
+                }
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    SDL_RWops *
+    Pack::OpenRW(StringView path) const
+    {
+        Entry entry;
+        if (!Find(path, &entry) || entry.encrypted)
+            return nullptr;
+
+        return SDL_RWFromConstMem(entry.data, (int)entry.size);
+    }
+
+    void
+    Pack::Mount(Ref<Pack> pack, const Path &mountPoint)
+    {
+        Unmount(pack);
+        mounts.push_back({ pack.Get(), mountPoint });
+    }
+
+    void
+    Pack::Unmount(Ref<Pack> pack)
+    {
+        mounts.erase(std::remove_if(mounts.begin(), mounts.end(),
+            [&pack](const PackMount &mount) { return mount.pack == pack.Get(); }), mounts.end());
+    }
+
+    bool
+    Pack::FindMounted(const Path &path, Entry *outEntry)
+    {
+        const String &subpath = path.Subpath();
+        for (auto it = mounts.rbegin(); it != mounts.rend(); ++it)
+        {
+            const String &point = it->point.Subpath();
+            if (path.Base() != it->point.Base() || subpath.Length() < point.Length() ||
+                std::memcmp(subpath.Cstr(), point.Cstr(), point.Length()) != 0)
+                continue;
+
+            // A mount point without a trailing slash must still end at a directory boundary
+            size_t start = point.Length();
+            if (start > 0 && point.Cstr()[start - 1] != '/')
+            {
+                if (subpath.Cstr()[start] != '/')
+                    continue;
+                ++start;
+            }
+
+            if (it->pack->Find(StringView(subpath.Cstr() + start, subpath.Length() - start), outEntry))
+                return true;
+        }
+
+        return false;
+    }
+}
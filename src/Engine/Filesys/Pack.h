@@ -0,0 +1,72 @@
+/* ====================================================================================================================
+ * @file Pack.h
+ * @class SDG::Pack
+ * Read-only .sdgpack asset archive, written by SDG_ContentPipe --pack. The pack is memory-mapped, and its files are
+ * found by binary search on their path hashes, so opening one costs no file system calls or copies.
+ *
+ * Mounting a pack makes its files visible to File::Open, and so to everything that loads through File:
+ *     Pack pack(BasePath("assets/content.sdgpack"));
+ *     Pack::Mount(pack, BasePath("assets/"));
+ *     File file(BasePath("assets/fonts/CourierPrimeCode.sdgc")); // found in the pack as "fonts/CourierPrimeCode.sdgc"
+ * Files not in a mounted pack are opened from disk as usual.
+ * ==================================================================================================================*/
+#pragma once
+#include "Path.h"
+#include <Engine/Lib/ClassMacros.h>
+#include <Engine/Lib/Ref.h>
+#include <Engine/Lib/StringView.h>
+
+#include <cstddef>
+#include <cstdint>
+
+struct SDL_RWops;
+
+namespace SDG
+{
+    class Pack
+    {
+        SDG_NOCOPY(Pack);
+        struct Impl;
+    public:
+        /// A file in the pack. Its data stays valid while the pack is open.
+        struct Entry
+        {
+            const uint8_t *data = nullptr;
+            size_t size = 0;          ///< data is followed by a '\0' not counted here
+            bool encrypted = false;   ///< data is .sdgc encrypted, so it must be decrypted into a copy to be used
+        };
+
+        Pack();
+        /// Opens the pack at path. Check IsOpen for success.
+        explicit Pack(const Path &path);
+        /// Closes the pack, unmounting it if it is still mounted
+        ~Pack();
+
+        /// Maps the pack at path and validates its table of contents
+        bool Open(const Path &path);
+        void Close();
+
+        [[nodiscard]] bool IsOpen() const;
+        [[nodiscard]] const char *GetError() const;
+        [[nodiscard]] size_t EntryCount() const;
+
+        /// Finds a file by its path in the pack, e.g. "fonts/CourierPrimeCode.sdgc"
+        [[nodiscard]] bool Find(StringView path, Entry *outEntry) const;
+
+        /// Opens a read-only SDL_RWops over a file's data without copying it, or null if the file is not in the pack
+        /// or is encrypted. Close it with SDL_RWclose while the pack is still open.
+        [[nodiscard]] SDL_RWops *OpenRW(StringView path) const;
+
+        // ===== Mounting =============================================================================================
+
+        /// Makes the pack's files visible to File::Open under a directory. Packs mounted later are searched first.
+        /// Mount and unmount from the main thread, while no other thread is opening files.
+        static void Mount(Ref<Pack> pack, const Path &mountPoint);
+        static void Unmount(Ref<Pack> pack);
+
+        /// Finds a file in the mounted packs
+        static bool FindMounted(const Path &path, Entry *outEntry);
+    private:
+        Impl *impl;
+    };
+}
@@ -0,0 +1,74 @@
+/* ====================================================================================================================
+ * @file PackFormat.h
+ * @namespace SDG::PackFormat
+ * Layout of .sdgpack asset archives, shared by SDG_ContentPipe, which writes them, and SDG::Pack, which maps them.
+ * Header-only and free of engine dependencies so the content pipeline can include it.
+ *
+ * A pack is, in order:
+ *     Header
+ *     TocEntry[entryCount]   sorted by path hash, then by name
+ *     names                  entry paths, packed without terminators
+ *     blobs                  each aligned to Alignment and followed by a '\0', so text can be used in place
+ * All integers are little-endian. Entry paths are relative to the pack's mount point and use '/' separators,
+ * e.g. "fonts/CourierPrimeCode.sdgc".
+ * ==================================================================================================================*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace SDG::PackFormat
+{
+    constexpr char     Magic[4] = { 'S', 'D', 'G', 'P' };
+    constexpr uint32_t Version = 1;
+    constexpr uint32_t Alignment = 16;
+
+    /// Entry flags
+    enum : uint16_t
+    {
+        /// Blob holds .sdgc encrypted bytes, which must be decrypted into a copy when opened
+        Encrypted = 1 << 0,
+    };
+
+    struct Header
+    {
+        char     magic[4];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t alignment;
+        uint64_t namesOffset;
+        uint64_t namesSize;
+        uint64_t fingerprint; ///< identifies the packed content, so an unchanged pack need not be rewritten
+    };
+
+    struct TocEntry
+    {
+        uint64_t pathHash;
+        uint64_t offset;      ///< from the start of the pack
+        uint64_t size;        ///< not including the trailing '\0'
+        uint32_t nameOffset;  ///< from Header::namesOffset
+        uint16_t nameLength;
+        uint16_t flags;
+    };
+
+    static_assert(sizeof(Header) == 40 && sizeof(TocEntry) == 32, "PackFormat structs must not be padded");
+
+    /// 64-bit FNV-1a hash of an entry path
+    constexpr uint64_t HashPath(std::string_view path)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (char c : path)
+        {
+            hash ^= (uint8_t)c;
+            hash *= 0x100000001B3ull;
+        }
+
+        return hash;
+    }
+
+    /// Rounds an offset up to the blob alignment
+    constexpr uint64_t Align(uint64_t offset)
+    {
+        return (offset + Alignment - 1) & ~(uint64_t)(Alignment - 1);
+    }
+}
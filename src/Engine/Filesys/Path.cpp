@@ -23,12 +23,14 @@ namespace SDG
             Path::fileSys.pop();
     }
 
-    Path::Path() : subpath(), base(BaseDir::None)
-    {}
+    Path::Path() : subpath(), base(BaseDir::None), hash()
+    {
+        UpdateHash();
+    }
 
     /// Creates a path with the specified base path.
     /// Trims any preceding forward slashes or white-space of subpath
-    Path::Path(const String &pSubpath, BaseDir base) : subpath(), base(base)
+    Path::Path(const String &pSubpath, BaseDir base) : subpath(), base(base), hash()
     {
         // Only operate if there is a subpath to work with
         if (!pSubpath.Empty())
@@ -72,6 +74,8 @@ namespace SDG
                 subpath = temp;
             }
         }
+
+        UpdateHash();
     }
 
     StringView
@@ -119,6 +123,7 @@ namespace SDG
         if (str[0] != '/')
             subpath += '/';
         subpath += str;
+        UpdateHash();
 
         return *this;
     }
@@ -162,22 +167,6 @@ namespace SDG
         }
     }
 
-    uint64_t
-    Path::Hash() const
-    {
-        const uint64_t p = 31;
-        const uint64_t m = 1e9 + 9;
-        uint64_t hash = ((uint64_t)base + 1)% m;
-        uint64_t pPow = p;
-        for (const char *c = subpath.Cstr(); *c != '\0' ; ++c)
-        {
-            hash = (hash + (*c - 'a' + 1) * pPow) % m;
-            pPow = (pPow * p) % m;
-        }
-
-        return hash;
-    }
-
     Path
     PrefPath(const String &subpath)
     {
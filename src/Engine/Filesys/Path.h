@@ -8,11 +8,13 @@
  *
  * ==================================================================================================================*/
 #pragma once
+#include <Engine/Lib/Hash.h>
 #include <Engine/Lib/Ref.h>
 #include <Engine/Lib/StringView.h>
 
 #include <iosfwd>
 #include <stack>
+#include <string_view>
 
 namespace SDG
 {
@@ -55,8 +57,14 @@ namespace SDG
 
         [[nodiscard]] bool Empty() const { return subpath.Empty() && base == BaseDir::None; }
 
-        /// Calculates a hash identifier for the path
-        [[nodiscard]] uint64_t Hash() const;
+        /// Gets the 64-bit hash identifying the path, which is computed when the path changes
+        [[nodiscard]] uint64_t Hash() const { return hash; }
+
+        /// Hashes a subpath under a base directory, the same way as Hash
+        static constexpr uint64_t HashSubpath(std::string_view subpath, BaseDir base)
+        {
+            return Hash64(subpath, (uint64_t)base + 1);
+        }
 
         /// Checks whether the Path has an extension.
         [[nodiscard]] bool HasExtension() const;
@@ -90,8 +98,11 @@ namespace SDG
         /// Removes the last Filesys that was pushed.
         static void PopFileSys();
     private:
+        void UpdateHash() { hash = HashSubpath({ subpath.Cstr(), subpath.Length() }, base); }
+
         String subpath;
         BaseDir base;
+        uint64_t hash;
         static std::stack<Ref<class Filesys>> fileSys;
     };
 
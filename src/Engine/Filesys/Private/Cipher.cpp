@@ -0,0 +1,179 @@
+#include "Cipher.h"
+#include <Engine/Debug/Assert.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SDG_CIPHER_SSE2 1
+
+    // AVX2 is chosen at runtime where the compiler can target it per function
+    #if defined(__GNUC__) || defined(__clang__)
+        #include <immintrin.h>
+        #define SDG_CIPHER_AVX2 1
+        #define SDG_CIPHER_AVX2_TARGET __attribute__((target("avx2")))
+        #define SDG_CIPHER_HAS_AVX2() __builtin_cpu_supports("avx2")
+    #elif defined(__AVX2__)
+        #include <immintrin.h>
+        #define SDG_CIPHER_AVX2 1
+        #define SDG_CIPHER_AVX2_TARGET
+        #define SDG_CIPHER_HAS_AVX2() true
+    #endif
+#endif
+
+#ifndef SDG_CIPHER_SSE2
+#define SDG_CIPHER_SSE2 0
+#endif
+#ifndef SDG_CIPHER_AVX2
+#define SDG_CIPHER_AVX2 0
+#endif
+
+namespace SDG::IO
+{
+    /// Transforms one span of bytes against a contiguous span of the key stream
+    using CipherKernel = void (*)(const uint8_t *src, uint8_t *dst, const uint8_t *add, const uint8_t *x, size_t size);
+
+    static void
+    DecryptScalar(const uint8_t *src, uint8_t *dst, const uint8_t *add, const uint8_t *x, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            dst[i] = (uint8_t)((uint8_t)(src[i] + add[i]) ^ x[i]);
+    }
+
+    static void
+    EncryptScalar(const uint8_t *src, uint8_t *dst, const uint8_t *add, const uint8_t *x, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            dst[i] = (uint8_t)((uint8_t)(src[i] ^ x[i]) - add[i]);
+    }
+
+#if (SDG_CIPHER_SSE2)
+    static void
+    DecryptSSE2(const uint8_t *src, uint8_t *dst, const uint8_t *add, const uint8_t *x, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+            v = _mm_add_epi8(v, _mm_loadu_si128((const __m128i *)(add + i)));
+            v = _mm_xor_si128(v, _mm_loadu_si128((const __m128i *)(x + i)));
+            _mm_storeu_si128((__m128i *)(dst + i), v);
+        }
+
+        DecryptScalar(src + i, dst + i, add + i, x + i, size - i);
+    }
+
+    static void
+    EncryptSSE2(const uint8_t *src, uint8_t *dst, const uint8_t *add, const uint8_t *x, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+            v = _mm_xor_si128(v, _mm_loadu_si128((const __m128i *)(x + i)));
+            v = _mm_sub_epi8(v, _mm_loadu_si128((const __m128i *)(add + i)));
+            _mm_storeu_si128((__m128i *)(dst + i), v);
+        }
+
+        EncryptScalar(src + i, dst + i, add + i, x + i, size - i);
+    }
+#endif
+
+#if (SDG_CIPHER_AVX2)
+    SDG_CIPHER_AVX2_TARGET static void
+    DecryptAVX2(const uint8_t *src, uint8_t *dst, const uint8_t *add, const uint8_t *x, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+            v = _mm256_add_epi8(v, _mm256_loadu_si256((const __m256i *)(add + i)));
+            v = _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i *)(x + i)));
+            _mm256_storeu_si256((__m256i *)(dst + i), v);
+        }
+
+        DecryptSSE2(src + i, dst + i, add + i, x + i, size - i);
+    }
+
+    SDG_CIPHER_AVX2_TARGET static void
+    EncryptAVX2(const uint8_t *src, uint8_t *dst, const uint8_t *add, const uint8_t *x, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+            v = _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i *)(x + i)));
+            v = _mm256_sub_epi8(v, _mm256_loadu_si256((const __m256i *)(add + i)));
+            _mm256_storeu_si256((__m256i *)(dst + i), v);
+        }
+
+        EncryptSSE2(src + i, dst + i, add + i, x + i, size - i);
+    }
+#endif
+
+    static CipherKernel
+    SelectKernel(bool decrypt)
+    {
+#if (SDG_CIPHER_AVX2)
+        if (SDG_CIPHER_HAS_AVX2())
+            return decrypt ? DecryptAVX2 : EncryptAVX2;
+#endif
+#if (SDG_CIPHER_SSE2)
+        return decrypt ? DecryptSSE2 : EncryptSSE2;
+#else
+        return decrypt ? DecryptScalar : EncryptScalar;
+#endif
+    }
+
+    /// Runs a kernel over a buffer, one contiguous span of the key stream at a time
+    static void
+    Transform(CipherKernel kernel, const std::vector<uint8_t> &addStream, const std::vector<uint8_t> &xorStream,
+        const uint8_t *src, uint8_t *dst, size_t size, size_t position)
+    {
+        const size_t period = addStream.size();
+        size_t offset = position % period;
+        while (size > 0)
+        {
+            size_t count = std::min(size, period - offset);
+            kernel(src, dst, addStream.data() + offset, xorStream.data() + offset, count);
+
+            src += count;
+            dst += count;
+            size -= count;
+            offset = 0;
+        }
+    }
+
+    Cipher::Cipher(const char *key) : addStream(), xorStream()
+    {
+        SDG_Assert(key && *key);
+        const size_t keyLength = std::strlen(key);
+
+        // The file position only contributes its low byte, so the stream repeats with the key and with 256
+        const size_t period = std::lcm(keyLength, (size_t)256);
+        addStream.resize(period);
+        xorStream.resize(period);
+        for (size_t i = 0; i < period; ++i)
+        {
+            auto k = (uint8_t)key[i % keyLength];
+            addStream[i] = (uint8_t)(i - k);
+            xorStream[i] = (uint8_t)~k;
+        }
+    }
+
+    void
+    Cipher::Decrypt(const uint8_t *src, uint8_t *dst, size_t size, size_t position) const
+    {
+        static const CipherKernel kernel = SelectKernel(true);
+        Transform(kernel, addStream, xorStream, src, dst, size, position);
+    }
+
+    void
+    Cipher::Encrypt(const uint8_t *src, uint8_t *dst, size_t size, size_t position) const
+    {
+        static const CipherKernel kernel = SelectKernel(false);
+        Transform(kernel, addStream, xorStream, src, dst, size, position);
+    }
+}
@@ -0,0 +1,36 @@
+/* ====================================================================================================================
+ * @file Cipher.h
+ * @class SDG::IO::Cipher
+ * Private. Applies the .sdgc byte cipher to whole buffers. Byte i of a file is encrypted with key byte k = key[i % n]:
+ *     encrypted = (plain ^ ~k) + k - i    decrypted = (encrypted - k + i) ^ ~k    (all mod 256)
+ * Both terms repeat every lcm(n, 256) bytes, so they are precomputed once as a key stream, and a buffer is
+ * transformed with one add (or subtract) and one xor per byte, 32 or 16 bytes at a time with AVX2 or SSE2.
+ * ==================================================================================================================*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SDG::IO
+{
+    class Cipher
+    {
+    public:
+        /// @param key - non-empty, null-terminated key
+        explicit Cipher(const char *key);
+
+        /// Decrypts bytes read from an encrypted file. src and dst may be the same buffer.
+        /// @param position - offset of src[0] in the file
+        void Decrypt(const uint8_t *src, uint8_t *dst, size_t size, size_t position = 0) const;
+
+        /// Encrypts bytes to be written to a file. src and dst may be the same buffer.
+        /// @param position - offset of dst[0] in the file
+        void Encrypt(const uint8_t *src, uint8_t *dst, size_t size, size_t position = 0) const;
+
+        /// Number of bytes after which the key stream repeats
+        [[nodiscard]] size_t Period() const { return addStream.size(); }
+    private:
+        std::vector<uint8_t> addStream; ///< i - k, added when decrypting, subtracted when encrypting
+        std::vector<uint8_t> xorStream; ///< ~k
+    };
+}
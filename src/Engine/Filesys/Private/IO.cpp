@@ -5,11 +5,15 @@
 //  Low-level functions to read and write files.
 //
 #include "IO.h"
+#include "Cipher.h"
 #include "SDL_rwops.h"
 #include <Engine/Lib/String.h>
 
+#include <algorithm>
+
 static const SDG::String encryptionKey = "john316";
-static SDG::String errorStr = "No errors.";
+static const SDG::IO::Cipher cipher(encryptionKey.Cstr());
+static thread_local SDG::String errorStr = "No errors.";
 
 static bool
 ReadFileStrImpl(const char *path, uint8_t **data, size_t *size, bool appendNull);
@@ -119,26 +123,24 @@ _DecryptFile(const char *path, bool nullTerminated, uint8_t **mem, size_t *oFile
     // Allocate buffer, and fill it with encrypted data
     uint8_t *fileData;
     fileData = (uint8_t *)malloc(fileSize + nullTerminated); // +1 for null terminator to make it a valid c-str
-
-    int position = 0;
-    for (uint8_t *ptr = fileData, *end = fileData + fileSize; ptr != end; ++ptr)
+    if (!fileData)
     {
-        uint8_t c;
-        size_t objsRead = SDL_RWread(io, &c, 1, 1);
-        if (objsRead == 0)
-        {
-            errorStr = SDG::String("error while reading file: ") + SDL_GetError();
-            free(fileData);
-            SDL_RWclose(io);
-            return false;
-        }
+        errorStr = SDG::String("error while allocating memory buffer: out of memory");
+        SDL_RWclose(io);
+        return false;
+    }
 
-        unsigned char add = encryptionKey[position % encryptionKey.Length()];
-        *ptr = (unsigned char)(c - add + position);
-        *ptr ^= ~add;
-        ++position;
+    // Read file all at once, then decrypt it in place
+    if (fileSize > 0 && SDL_RWread(io, fileData, fileSize, 1) != 1)
+    {
+        errorStr = SDG::String("error while reading file: ") + SDL_GetError();
+        free(fileData);
+        SDL_RWclose(io);
+        return false;
     }
 
+    cipher.Decrypt(fileData, fileData, (size_t)fileSize);
+
     if (SDL_RWclose(io) < 0)
     {
         errorStr = SDG::String("error while closing file: ") + SDL_GetError();
@@ -170,6 +172,12 @@ SDG::IO::ReadEncryptedFileStr(const char *path, uint8_t **mem, size_t *oFileSize
     return _DecryptFile(path, true, mem, oFileSize);
 }
 
+void
+SDG::IO::Decrypt(const uint8_t *src, uint8_t *dst, size_t size)
+{
+    cipher.Decrypt(src, dst, size);
+}
+
 bool
 SDG::IO::WriteEncryptedFile(const char *path, const uint8_t *mem, size_t size)
 {
@@ -180,23 +188,19 @@ SDG::IO::WriteEncryptedFile(const char *path, const uint8_t *mem, size_t size)
         return false;
     }
 
-    // Encrypt file
-    int bytesRead = 0;
-    for (const uint8_t *p = mem, *end = mem + size; p != end; ++p)
+    // Encrypt file through a fixed buffer, so the source data is left untouched
+    uint8_t buffer[16 * 1024];
+    for (size_t position = 0; position < size; position += sizeof(buffer))
     {
-        uint8_t c = *p;
-        uint8_t add = (uint8_t)encryptionKey[bytesRead % encryptionKey.Length()];
-        c ^= ~add;
-        c = (unsigned char)(c + add - bytesRead);
-        size_t objsWritten = SDL_RWwrite(io, &c, 1, 1);
+        size_t count = std::min(sizeof(buffer), size - position);
+        cipher.Encrypt(mem + position, buffer, count, position);
 
-        if (objsWritten != 1)
+        if (SDL_RWwrite(io, buffer, count, 1) != 1)
         {
+            errorStr = SDG::String("error while writing file: ") + SDL_GetError();
             SDL_RWclose(io);
             return false;
         }
-
-        ++bytesRead;
     }
     SDL_RWclose(io);
 
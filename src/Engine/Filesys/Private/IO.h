@@ -6,11 +6,12 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace SDG::IO
 {
-    /// Get the last error that occured in one of the IO functions. Not thread safe...
+    /// Get the last error that occured in one of the IO functions on the calling thread.
     const char *GetError();
 
     /// Reads data from a file into a null-terminated c-string. Same as ReadFile, but with a null terminator.
@@ -45,6 +46,10 @@ namespace SDG::IO
     /// responsibility to free. If false, data will receive a nullptr, and size will receive 0.
     bool ReadEncryptedFile(const char *path, uint8_t **data, size_t *size);
 
+    /// Decrypts .sdgc data that is already in memory, such as an encrypted pack entry.
+    /// src and dst may be the same buffer.
+    void Decrypt(const uint8_t *src, uint8_t *dst, size_t size);
+
     bool WriteEncryptedFile(const char *path, const uint8_t *mem, size_t size);
     bool WriteFile(const char *path, const uint8_t *mem, size_t size);
 }
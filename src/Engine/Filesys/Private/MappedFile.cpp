@@ -0,0 +1,166 @@
+#include "MappedFile.h"
+#include "IO.h"
+#include <Engine/Platform.h>
+
+#include <cstdlib>
+
+#if (SDG_TARGET_WINDOWS)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#elif (!SDG_TARGET_WEBGL)
+    #include <cerrno>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace SDG::IO
+{
+    MappedFile::MappedFile() : data(), size(), handle(), error()
+    {
+
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+#if (SDG_TARGET_WINDOWS)
+    bool
+    MappedFile::Open(const char *path)
+    {
+        Close();
+
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            error = String::Format("failed to open file ({}): error {}", path, GetLastError());
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            error = String::Format("failed to get size of file, or it was empty ({})", path);
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file); // the mapping keeps the file open
+        if (!mapping)
+        {
+            error = String::Format("failed to create file mapping ({}): error {}", path, GetLastError());
+            return false;
+        }
+
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            error = String::Format("failed to map view of file ({}): error {}", path, GetLastError());
+            CloseHandle(mapping);
+            return false;
+        }
+
+        data = static_cast<const uint8_t *>(view);
+        size = (size_t)fileSize.QuadPart;
+        handle = mapping;
+        return true;
+    }
+
+    void
+    MappedFile::Close()
+    {
+        if (data)
+        {
+            UnmapViewOfFile(data);
+            CloseHandle(handle);
+            data = nullptr;
+            size = 0;
+            handle = nullptr;
+        }
+    }
+
+#elif (SDG_TARGET_WEBGL)
+    bool
+    MappedFile::Open(const char *path)
+    {
+        Close();
+
+        uint8_t *mem;
+        size_t memSize;
+        if (!ReadFile(path, &mem, &memSize))
+        {
+            error = String::Format("failed to read file ({}): {}", path, IO::GetError());
+            return false;
+        }
+
+        data = mem;
+        size = memSize;
+        handle = mem;
+        return true;
+    }
+
+    void
+    MappedFile::Close()
+    {
+        if (data)
+        {
+            free(handle);
+            data = nullptr;
+            size = 0;
+            handle = nullptr;
+        }
+    }
+
+#else
+    bool
+    MappedFile::Open(const char *path)
+    {
+        Close();
+
+        int fd = open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            error = String::Format("failed to open file ({}): {}", path, std::strerror(errno));
+            return false;
+        }
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || info.st_size == 0)
+        {
+            error = String::Format("failed to get size of file, or it was empty ({})", path);
+            close(fd);
+            return false;
+        }
+
+        void *mem = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // the mapping keeps the file open
+        if (mem == MAP_FAILED)
+        {
+            error = String::Format("failed to map file ({}): {}", path, std::strerror(errno));
+            return false;
+        }
+
+        data = static_cast<const uint8_t *>(mem);
+        size = (size_t)info.st_size;
+        return true;
+    }
+
+    void
+    MappedFile::Close()
+    {
+        if (data)
+        {
+            munmap(const_cast<uint8_t *>(data), size);
+            data = nullptr;
+            size = 0;
+        }
+    }
+#endif
+}
@@ -0,0 +1,37 @@
+/* ====================================================================================================================
+ * @file MappedFile.h
+ * @class SDG::IO::MappedFile
+ * Private. Maps a whole file read-only into memory: mmap on POSIX, a file mapping on Windows. On WebGL, where files
+ * already live in memory, the file is read into a heap buffer instead.
+ * ==================================================================================================================*/
+#pragma once
+#include <Engine/Lib/ClassMacros.h>
+#include <Engine/Lib/String.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SDG::IO
+{
+    class MappedFile
+    {
+        SDG_NOCOPY(MappedFile);
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        /// Maps the file at path, unmapping any previous one. Check GetError on failure.
+        bool Open(const char *path);
+        void Close();
+
+        [[nodiscard]] bool IsOpen() const { return data != nullptr; }
+        [[nodiscard]] const uint8_t *Data() const { return data; }
+        [[nodiscard]] size_t Size() const { return size; }
+        [[nodiscard]] const char *GetError() const { return error.Cstr(); }
+    private:
+        const uint8_t *data;
+        size_t size;
+        void *handle; ///< platform mapping handle, or the heap buffer on WebGL
+        String error;
+    };
+}
@@ -0,0 +1,140 @@
+#include "Archetype.h"
+#include <Engine/Debug/Assert.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+namespace SDG
+{
+    ComponentTypeID
+    ComponentType::NextID()
+    {
+        static std::atomic<ComponentTypeID> next(0);
+        return next++;
+    }
+
+    static size_t AlignUp(size_t offset, size_t align)
+    {
+        return (offset + align - 1) & ~(align - 1);
+    }
+
+    /// Lays out the columns of a chunk of a number of rows
+    /// @return bytes the chunk needs
+    static size_t LayOut(const std::vector<const ComponentType *> &types, size_t rows, std::vector<size_t> &offsets)
+    {
+        size_t bytes = rows * sizeof(Entity);
+        for (size_t i = 0; i < types.size(); ++i)
+        {
+            bytes = AlignUp(bytes, types[i]->align);
+            offsets[i] = bytes;
+            bytes += rows * types[i]->size;
+        }
+
+        return bytes;
+    }
+
+    Archetype::Archetype(std::vector<const ComponentType *> types) : types(std::move(types)), offsets(),
+        chunks(), capacity(), chunkBytes(ChunkBytes), chunkAlign(alignof(Entity)), size()
+    {
+        offsets.resize(this->types.size());
+
+        size_t rowBytes = sizeof(Entity);
+        for (const ComponentType *type : this->types)
+        {
+            rowBytes += type->size;
+            chunkAlign = std::max(chunkAlign, type->align);
+        }
+
+        // Fit as many rows as alignment padding allows; rows larger than a chunk get a chunk each
+        capacity = std::max<size_t>(ChunkBytes / rowBytes, 1);
+        while (capacity > 1 && LayOut(this->types, capacity, offsets) > ChunkBytes)
+            --capacity;
+        chunkBytes = std::max(chunkBytes, LayOut(this->types, capacity, offsets));
+    }
+
+    Archetype::~Archetype()
+    {
+        Clear();
+        for (char *chunk : chunks)
+            ::operator delete(chunk, std::align_val_t(chunkAlign));
+    }
+
+    int
+    Archetype::ColumnOf(ComponentTypeID id) const
+    {
+        auto it = std::lower_bound(types.begin(), types.end(), id,
+            [](const ComponentType *type, ComponentTypeID id) { return type->id < id; });
+        return it != types.end() && (*it)->id == id ? (int)(it - types.begin()) : -1;
+    }
+
+    uint32_t
+    Archetype::PushBack(Entity entity)
+    {
+        if (size == chunks.size() * capacity)
+            chunks.emplace_back(static_cast<char *>(::operator new(chunkBytes, std::align_val_t(chunkAlign))));
+
+        const auto row = (uint32_t)size++;
+        Entities(row / capacity)[row % capacity] = entity;
+        return row;
+    }
+
+    Entity
+    Archetype::SwapRemove(uint32_t row)
+    {
+        SDG_Assert(row < size);
+        DestroyRow(row);
+
+        const auto last = (uint32_t)(size - 1);
+        const Entity moved = EntityAt(last);
+        if (row != last)
+        {
+            for (size_t i = 0; i < types.size(); ++i)
+            {
+                const ComponentType &type = *types[i];
+                if (type.move)
+                {
+                    type.move(At(row, i), At(last, i));
+                    if (type.destroy)
+                        type.destroy(At(last, i));
+                }
+                else
+                {
+                    std::memcpy(At(row, i), At(last, i), type.size);
+                }
+            }
+
+            Entities(row / capacity)[row % capacity] = moved;
+        }
+
+        --size;
+
+        // Keep one empty chunk, so an entity moving back and forth across a chunk boundary does not reallocate
+        if (chunks.size() > ChunkCount() + 1)
+        {
+            ::operator delete(chunks.back(), std::align_val_t(chunkAlign));
+            chunks.pop_back();
+        }
+
+        return moved;
+    }
+
+    void
+    Archetype::Clear()
+    {
+        for (size_t row = 0; row < size; ++row)
+            DestroyRow((uint32_t)row);
+        size = 0;
+    }
+
+    void
+    Archetype::DestroyRow(uint32_t row)
+    {
+        for (size_t i = 0; i < types.size(); ++i)
+        {
+            if (types[i]->destroy)
+                types[i]->destroy(At(row, i));
+        }
+    }
+}
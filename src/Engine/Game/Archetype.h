@@ -0,0 +1,96 @@
+/* ====================================================================================================================
+ * @file Archetype.h - SDG_Engine
+ *
+ * @class Archetype
+ * Storage for every entity that has the same set of component types. Rows are split into fixed-size chunks, and each
+ * chunk holds one contiguous array per component type, so iterating a component visits memory linearly.
+ * ==================================================================================================================*/
+#pragma once
+#include "ComponentType.h"
+#include "Entity.h"
+#include <Engine/Lib/ClassMacros.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SDG
+{
+    class Archetype
+    {
+        SDG_NOCOPY(Archetype);
+    public:
+        /// Bytes per chunk. A chunk holds more rows if its archetype's rows are small.
+        static constexpr size_t ChunkBytes = 16 * 1024;
+
+        /// @param types - component types of the archetype, ordered by id, without duplicates
+        explicit Archetype(std::vector<const ComponentType *> types);
+        ~Archetype();
+
+        // ========== Types ===================================================
+
+        /// Component types, ordered by id
+        [[nodiscard]] const std::vector<const ComponentType *> &Types() const { return types; }
+
+        /// Gets the column of a component type
+        /// @return the column index, or -1 if the archetype does not have the type
+        [[nodiscard]] int ColumnOf(ComponentTypeID id) const;
+
+        [[nodiscard]] bool Has(ComponentTypeID id) const { return ColumnOf(id) != -1; }
+
+        // ========== Rows ====================================================
+
+        /// Appends a row for an entity. Its components are left uninitialized for the caller to construct.
+        /// @return the new row
+        uint32_t PushBack(Entity entity);
+
+        /// Destroys a row's components, and moves the last row into it
+        /// @return the entity moved into the row, or the removed entity if the row was the last
+        Entity SwapRemove(uint32_t row);
+
+        /// Destroys every row
+        void Clear();
+
+        /// Number of rows
+        [[nodiscard]] size_t Size() const { return size; }
+
+        /// Gets a component of a row
+        [[nodiscard]] void *At(uint32_t row, size_t column) const
+        {
+            return Column(row / capacity, column) + (row % capacity) * types[column]->size;
+        }
+
+        [[nodiscard]] Entity EntityAt(uint32_t row) const { return Entities(row / capacity)[row % capacity]; }
+
+        // ========== Chunks ==================================================
+
+        /// Maximum number of rows in a chunk
+        [[nodiscard]] size_t ChunkCapacity() const { return capacity; }
+
+        /// Number of chunks that hold rows
+        [[nodiscard]] size_t ChunkCount() const { return (size + capacity - 1) / capacity; }
+
+        /// Number of rows in a chunk
+        [[nodiscard]] size_t ChunkSize(size_t chunk) const
+        {
+            return chunk + 1 < ChunkCount() ? capacity : size - chunk * capacity;
+        }
+
+        /// Gets the first component of a column in a chunk
+        [[nodiscard]] char *Column(size_t chunk, size_t column) const { return chunks[chunk] + offsets[column]; }
+
+        /// Gets the entities of the rows in a chunk
+        [[nodiscard]] Entity *Entities(size_t chunk) const { return reinterpret_cast<Entity *>(chunks[chunk]); }
+
+    private:
+        void DestroyRow(uint32_t row);
+
+        std::vector<const ComponentType *> types;
+        std::vector<size_t> offsets; ///< byte offset of each column in a chunk, after the entity column
+        std::vector<char *> chunks;  ///< allocated chunks, which may include one spare past the last in use
+        size_t capacity;             ///< rows per chunk
+        size_t chunkBytes;
+        size_t chunkAlign;
+        size_t size;
+    };
+}
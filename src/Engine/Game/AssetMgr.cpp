@@ -2,18 +2,498 @@
 #include <SDL_gpu.h>
 #include <Engine/Debug/Assert.h>
 #include <Engine/Debug/Log.h>
+#include <Engine/Exceptions/Exception.h>
+#include <Engine/Filesys/File.h>
+#include <Engine/Platform.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace SDG
 {
-    AssetMgr::~AssetMgr()
+    /// A texture cached or loading in an AssetMgr, shared with its TextureHandles
+    struct TextureHandle::Request
     {
+        explicit Request(const Path &path) : path(path), hash(path.Hash()), state(AssetState::Loading),
+            decoded(false), surface(), error(), texture(), callbacks(), cancelled(false), reloading(false), bytes(),
+            lruPos() { }
+        ~Request()
+        {
+            if (surface)
+                SDL_FreeSurface(surface);
+        }
+
+        const Path path;
+        const uint64_t hash;
+        std::atomic<AssetState> state;
 
+        // Written by the worker that decodes it, then read by the main thread once decoded is set
+        std::atomic<bool> decoded;
+        SDL_Surface *surface; ///< RGBA32 pixels to upload, null when decoding failed
+        String error;
+
+        // Main thread only
+        Texture texture;
+        std::vector<AssetMgr::TextureCallback> callbacks;
+        bool cancelled;       ///< unloaded before it finished loading
+        bool reloading;       ///< loaded, and decoding again to replace its pixels in place
+        size_t bytes;         ///< estimated GPU memory, counted while loaded
+        std::list<Request *>::iterator lruPos;
+    };
+
+    // ===== TextureHandle ============================================================================================
+
+    TextureHandle::TextureHandle() : request()
+    {
+
+    }
+
+    TextureHandle::TextureHandle(std::shared_ptr<Request> request) : request(std::move(request))
+    {
+
+    }
+
+    AssetState
+    TextureHandle::State() const
+    {
+        return request ? request->state.load(std::memory_order_acquire) : AssetState::Failed;
+    }
+
+    bool
+    TextureHandle::IsDone() const
+    {
+        return State() != AssetState::Loading;
+    }
+
+    bool
+    TextureHandle::IsLoaded() const
+    {
+        return State() == AssetState::Loaded;
+    }
+
+    const Texture &
+    TextureHandle::Get() const
+    {
+        static const Texture empty;
+        return request ? request->texture : empty;
+    }
+
+    const char *
+    TextureHandle::GetError() const
+    {
+        if (!request)
+            return "TextureHandle is empty";
+        return State() == AssetState::Failed ? request->error.Cstr() : "No errors.";
+    }
+
+    const Path &
+    TextureHandle::Filepath() const
+    {
+        static const Path empty;
+        return request ? request->path : empty;
+    }
+
+    // ===== AssetMgr =================================================================================================
+
+    /// Estimates the GPU memory held by a loaded texture
+    static size_t TextureBytes(const Texture &texture)
+    {
+        const GPU_Image *image = texture.Image();
+        return (size_t)image->texture_w * image->texture_h * image->bytes_per_pixel;
+    }
+
+    struct AssetMgr::Impl
+    {
+        using Request = TextureHandle::Request;
+
+        Impl() : textures(), context(), uploadBudget(.002), lru(), memoryUsage(), memoryBudget(), paths(),
+            mutex(), workReady(), decodeDone(), pending(),
+            decoded(), workers(), stopping(false), loadingCount() { }
+        ~Impl() { StopWorkers(); }
+
+        /// Reads and decodes the request's image file into an RGBA32 surface. Safe to call from any thread.
+        static void Decode(Request &request);
+        /// Creates the texture from a decoded request, then invokes its callbacks. Main thread only.
+        void Upload(const std::shared_ptr<Request> &request);
+        void Finish(const std::shared_ptr<Request> &request, AssetState state);
+        /// Replaces a loaded texture's pixels with the ones decoded again by ReloadTexture. Main thread only.
+        void Reupload(const std::shared_ptr<Request> &request);
+        /// Queues a request to be decoded by a worker
+        void Queue(const std::shared_ptr<Request> &request);
+
+        void StartWorkers();
+        void StopWorkers();
+        void WorkerMain();
+
+        /// Counts a loaded texture's memory, as the most recently used
+        void Track(Request &request);
+        /// Marks a loaded texture as the most recently used
+        void Touch(Request &request);
+        /// Unloads a cached texture, or cancels it if it is still loading
+        void Unload(std::map<uint64_t, std::shared_ptr<Request>>::iterator it);
+        /// Evicts unreferenced textures, least recently used first, until memory is within budget
+        void Trim();
+        /// Remembers the path of an ID, so it can be loaded by ID
+        void Intern(const Path &path);
+        /// Gets the handle of a cached or loading texture, adding the callback to it
+        TextureHandle Found(const std::shared_ptr<Request> &request, TextureCallback onComplete);
+
+        std::map<uint64_t, std::shared_ptr<Request>> textures; ///< loaded and loading textures by path hash
+        Ref<Window> context;
+        double uploadBudget;
+
+        std::list<Request *> lru;             ///< loaded textures, most recently used first
+        size_t memoryUsage, memoryBudget;
+        std::unordered_map<uint64_t, Path> paths; ///< every path requested or registered, by ID
+
+        std::mutex mutex;                     ///< guards pending, decoded and stopping
+        std::condition_variable workReady, decodeDone;
+        std::deque<std::shared_ptr<Request>> pending;  ///< waiting for a worker
+        std::deque<std::shared_ptr<Request>> decoded;  ///< waiting for upload
+        std::vector<std::thread> workers;
+        bool stopping;
+        size_t loadingCount;                  ///< main thread only
+    };
+
+    void
+    AssetMgr::Impl::Decode(Request &request)
+    {
+        File file;
+        if (!file.Open(request.path))
+        {
+            request.error = file.GetError();
+            return;
+        }
+
+        SDL_RWops *io = SDL_RWFromConstMem(file.Data(), (int)file.Size());
+        if (!io)
+        {
+            request.error = String::Format("problem while sending data to SDL_RWops: {}", SDL_GetError());
+            return;
+        }
+
+        // SDL_gpu's error stack is not thread-safe, so decoding errors are not popped from it here
+        SDL_Surface *loaded = GPU_LoadSurface_RW(io, true);
+        if (!loaded)
+        {
+            request.error = String::Format("problem decoding image file ({})", request.path.Str());
+            return;
+        }
+
+        // Uploads take tightly packed RGBA pixels
+        request.surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (!request.surface)
+            request.error = String::Format("problem converting image to RGBA ({}): {}", request.path.Str(),
+                SDL_GetError());
+    }
+
+    void
+    AssetMgr::Impl::Upload(const std::shared_ptr<Request> &request)
+    {
+        // Decoded again by ReloadTexture, whether or not the texture was unloaded since
+        if (request->state.load(std::memory_order_acquire) != AssetState::Loading)
+        {
+            Reupload(request);
+            return;
+        }
+
+        if (request->cancelled)
+        {
+            request->error = "texture was unloaded before it finished loading";
+            Finish(request, AssetState::Failed);
+            return;
+        }
+
+        if (!request->surface)
+        {
+            SDG_Core_Err("AssetMgr::LoadTextureAsync: failed to load Texture from {}: {}", request->path.Str(),
+                request->error);
+            Finish(request, AssetState::Failed);
+            return;
+        }
+
+        SDL_Surface *surface = request->surface;
+        request->surface = nullptr;
+
+        bool loaded;
+        try {
+            loaded = request->texture.LoadPixels(context.Get(), (uint32_t)surface->w, (uint32_t)surface->h,
+                static_cast<const uint8_t *>(surface->pixels), request->path);
+        }
+        catch (const Exception &e)
+        {
+            request->error = e.what();
+            loaded = false;
+        }
+        SDL_FreeSurface(surface);
+
+        if (!loaded)
+            SDG_Core_Err("AssetMgr::LoadTextureAsync: failed to upload Texture from {}: {}", request->path.Str(),
+                request->error);
+        Finish(request, loaded ? AssetState::Loaded : AssetState::Failed);
+    }
+
+    void
+    AssetMgr::Impl::Finish(const std::shared_ptr<Request> &request, AssetState state)
+    {
+        // Failed loads leave the cache, so they may be retried
+        if (state == AssetState::Failed && !request->cancelled)
+        {
+            auto it = textures.find(request->hash);
+            if (it != textures.end() && it->second == request)
+                textures.erase(it);
+        }
+
+        --loadingCount;
+        if (state == AssetState::Loaded && !request->cancelled)
+            Track(*request);
+        request->state.store(state, std::memory_order_release);
+
+        TextureHandle handle(request);
+        std::vector<TextureCallback> callbacks;
+        callbacks.swap(request->callbacks);
+        for (auto &callback : callbacks)
+            callback(handle);
+
+        Trim();
+    }
+
+    void
+    AssetMgr::Impl::Reupload(const std::shared_ptr<Request> &request)
+    {
+        SDL_Surface *surface = request->surface;
+        request->surface = nullptr;
+
+        const bool unloaded = !request->reloading;
+        request->reloading = false;
+        if (unloaded || !surface)
+        {
+            if (surface)
+                SDL_FreeSurface(surface);
+            else if (!unloaded) // the old pixels stay, so the file can be fixed and saved again
+                SDG_Core_Err("AssetMgr::ReloadTexture: failed to reload Texture from {}: {}", request->path.Str(),
+                    request->error);
+            return;
+        }
+
+        // LoadPixels resets these to the defaults, but they were set on the texture the game has been using
+        Texture &texture = request->texture;
+        const auto filter = texture.FilterMode();
+        const auto snap = texture.SnapMode();
+        const auto anchor = texture.Anchor();
+        const auto wrapX = texture.WrapModeX(), wrapY = texture.WrapModeY();
+
+        bool loaded;
+        try {
+            loaded = texture.LoadPixels(context.Get(), (uint32_t)surface->w, (uint32_t)surface->h,
+                static_cast<const uint8_t *>(surface->pixels), request->path);
+            texture.FilterMode(filter).SnapMode(snap).Anchor(anchor).WrapMode(wrapX, wrapY);
+        }
+        catch (const Exception &e)
+        {
+            request->error = e.what();
+            loaded = false;
+        }
+        SDL_FreeSurface(surface);
+
+        if (!loaded)
+        {
+            // The old image was freed before the new one failed, so the texture leaves the cache
+            SDG_Core_Err("AssetMgr::ReloadTexture: failed to upload Texture from {}: {}", request->path.Str(),
+                request->error);
+            Unload(textures.find(request->hash));
+            request->state.store(AssetState::Failed, std::memory_order_release);
+            return;
+        }
+
+        memoryUsage -= request->bytes;
+        request->bytes = TextureBytes(texture);
+        memoryUsage += request->bytes;
+        Trim();
+    }
+
+    void
+    AssetMgr::Impl::Queue(const std::shared_ptr<Request> &request)
+    {
+        StartWorkers();
+        {
+            std::lock_guard lock(mutex);
+            pending.push_back(request);
+        }
+        workReady.notify_one();
+    }
+
+    void
+    AssetMgr::Impl::StartWorkers()
+    {
+#if (SDG_TARGET_WEBGL)
+        // No worker threads without pthreads, so Update decodes on the main thread instead
+        return;
+#endif
+        if (!workers.empty())
+            return;
+
+        // Leave a core for the main thread, which keeps uploading and rendering while workers decode
+        const unsigned count = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;
+        for (unsigned i = 0; i < count; ++i)
+            workers.emplace_back(&Impl::WorkerMain, this);
+    }
+
+    void
+    AssetMgr::Impl::StopWorkers()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        workReady.notify_all();
+
+        for (auto &worker : workers)
+            worker.join();
+        workers.clear();
+
+        pending.clear();
+        decoded.clear();
+    }
+
+    void
+    AssetMgr::Impl::WorkerMain()
+    {
+        while (true)
+        {
+            std::shared_ptr<Request> request;
+            {
+                std::unique_lock lock(mutex);
+                workReady.wait(lock, [this]() { return stopping || !pending.empty(); });
+                if (stopping)
+                    return;
+
+                request = std::move(pending.front());
+                pending.pop_front();
+            }
+
+            Decode(*request);
+
+            {
+                std::lock_guard lock(mutex);
+                request->decoded.store(true, std::memory_order_release);
+                decoded.push_back(std::move(request));
+            }
+            decodeDone.notify_all();
+        }
+    }
+
+    void
+    AssetMgr::Impl::Track(Request &request)
+    {
+        request.bytes = TextureBytes(request.texture);
+        memoryUsage += request.bytes;
+        lru.push_front(&request);
+        request.lruPos = lru.begin();
+    }
+
+    void
+    AssetMgr::Impl::Touch(Request &request)
+    {
+        if (request.state.load(std::memory_order_acquire) == AssetState::Loaded)
+            lru.splice(lru.begin(), lru, request.lruPos);
+    }
+
+    void
+    AssetMgr::Impl::Unload(std::map<uint64_t, std::shared_ptr<Request>>::iterator it)
+    {
+        Request &request = *it->second;
+        if (request.state.load(std::memory_order_acquire) == AssetState::Loading)
+        {
+            request.cancelled = true;
+        }
+        else
+        {
+            memoryUsage -= request.bytes;
+            lru.erase(request.lruPos);
+            request.texture.Unload();
+            request.reloading = false; // drops the pixels if a reload is underway
+
+            // Handles still held must not report the freed texture as loaded
+            request.error = "texture was unloaded";
+            request.state.store(AssetState::Failed, std::memory_order_release);
+        }
+
+        textures.erase(it);
+    }
+
+    void
+    AssetMgr::Impl::Trim()
+    {
+        if (memoryBudget == 0)
+            return;
+
+        for (auto lruIt = lru.end(); memoryUsage > memoryBudget && lruIt != lru.begin(); )
+        {
+            Request *request = *--lruIt;
+            auto it = textures.find(request->hash);
+
+            // Handles keep their textures loaded; only the cache refers to the rest
+            if (it->second.use_count() > 1)
+                continue;
+
+            lruIt = std::next(lruIt);
+            Unload(it);
+        }
+    }
+
+    void
+    AssetMgr::Impl::Intern(const Path &path)
+    {
+        auto [it, inserted] = paths.emplace(path.Hash(), path);
+        if (!inserted && (it->second.Base() != path.Base() || it->second.Subpath() != path.Subpath()))
+        {
+            SDG_Core_Err("AssetMgr: asset ID collision between {} and {}; loading by ID will find only the first",
+                it->second.Str(), path.Str());
+        }
+    }
+
+    TextureHandle
+    AssetMgr::Impl::Found(const std::shared_ptr<Request> &request, TextureCallback onComplete)
+    {
+        TextureHandle handle(request);
+        Touch(*request);
+        if (onComplete)
+        {
+            if (handle.IsDone())
+                onComplete(handle);
+            else
+                request->callbacks.emplace_back(std::move(onComplete));
+        }
+
+        return handle;
+    }
+
+    AssetMgr::AssetMgr() : impl(new Impl)
+    {
+
+    }
+
+    AssetMgr::~AssetMgr()
+    {
+        delete impl;
     }
 
     auto
     AssetMgr::UnloadTextures()->void
     {
-        textures.clear();
+        while (!impl->textures.empty())
+            impl->Unload(impl->textures.begin());
     }
 
     auto
@@ -23,23 +503,83 @@ namespace SDG
         // add other unloading stuff here.
     }
 
+    auto
+    AssetMgr::Update()->void
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+        const auto budget = std::chrono::duration<double>(impl->uploadBudget);
+
+        do {
+            std::shared_ptr<Impl::Request> request;
+            {
+                std::lock_guard lock(impl->mutex);
+                if (!impl->decoded.empty())
+                {
+                    request = std::move(impl->decoded.front());
+                    impl->decoded.pop_front();
+                }
+                else if (impl->workers.empty() && !impl->pending.empty())
+                {
+                    request = std::move(impl->pending.front());
+                    impl->pending.pop_front();
+                }
+                else
+                {
+                    return;
+                }
+            }
+
+            if (!request->decoded.load(std::memory_order_acquire))
+            {
+                Impl::Decode(*request);
+                request->decoded.store(true, std::memory_order_release);
+            }
+
+            impl->Upload(request);
+        } while (Clock::now() - start < budget);
+    }
+
+    auto
+    AssetMgr::UploadBudget(double seconds)->void
+    {
+        impl->uploadBudget = seconds;
+    }
+
+    auto
+    AssetMgr::UploadBudget() const->double
+    {
+        return impl->uploadBudget;
+    }
+
     auto
     AssetMgr::LoadTexture(const Path &path)->Texture
     {
-        SDG_Assert(context); // Please make sure to set the context via Initialize() before loading textures.
+        SDG_Assert(impl->context); // Please make sure to set the context via Initialize() before loading textures.
 
         auto hash = path.Hash();
-        auto it = textures.find(hash);
+        auto it = impl->textures.find(hash);
+
+        if (it != impl->textures.end())
+        {
+            TextureHandle handle(it->second);
+            if (!Wait(handle))
+                return Texture{};
 
-        if (it != textures.end())
-            return it->second;
+            impl->Touch(*handle.request);
+            return handle.Get();
+        }
         else
         {
-            auto tex = Texture{};
-            if (tex.Load(context.Get(), path))
+            impl->Intern(path);
+            auto request = std::make_shared<Impl::Request>(path);
+            if (request->texture.Load(impl->context.Get(), path))
             {
-                textures[hash] = tex;
-                return tex;
+                request->state = AssetState::Loaded;
+                impl->textures[hash] = request;
+                impl->Track(*request);
+                impl->Trim(); // request is still referenced here, so it stays loaded
+                return request->texture;
             }
             else
             {
@@ -49,11 +589,146 @@ namespace SDG
         }
     }
 
+    auto
+    AssetMgr::LoadTextureAsync(const Path &path, TextureCallback onComplete)->TextureHandle
+    {
+        auto hash = path.Hash();
+        auto it = impl->textures.find(hash);
+        if (it != impl->textures.end())
+            return impl->Found(it->second, std::move(onComplete));
+
+        impl->Intern(path);
+        auto request = std::make_shared<Impl::Request>(path);
+        if (onComplete)
+            request->callbacks.emplace_back(std::move(onComplete));
+        impl->textures[hash] = request;
+        ++impl->loadingCount;
+        impl->Queue(request);
+
+        return TextureHandle(std::move(request));
+    }
+
+    auto
+    AssetMgr::LoadTextureAsync(AssetID id, TextureCallback onComplete)->TextureHandle
+    {
+        auto it = impl->textures.find(id.Value());
+        if (it != impl->textures.end())
+            return impl->Found(it->second, std::move(onComplete));
+
+        auto pathIt = impl->paths.find(id.Value());
+        if (pathIt == impl->paths.end())
+        {
+            SDG_Core_Err("AssetMgr::LoadTextureAsync: no path was registered for asset ID {:#x}", id.Value());
+            return TextureHandle();
+        }
+
+        return LoadTextureAsync(pathIt->second, std::move(onComplete));
+    }
+
+    auto
+    AssetMgr::FindTexture(AssetID id)->TextureHandle
+    {
+        auto it = impl->textures.find(id.Value());
+        return it != impl->textures.end() ? impl->Found(it->second, {}) : TextureHandle();
+    }
+
+    auto
+    AssetMgr::Register(const Path &path)->AssetID
+    {
+        impl->Intern(path);
+        return AssetID(path);
+    }
+
+    auto
+    AssetMgr::ReloadTexture(const Path &path)->bool
+    {
+        auto it = impl->textures.find(path.Hash());
+        if (it == impl->textures.end())
+            return false;
+
+        const std::shared_ptr<Impl::Request> &request = it->second;
+        if (request->state.load(std::memory_order_acquire) != AssetState::Loaded || request->reloading)
+            return false;
+
+        request->reloading = true;
+        request->error = String();
+        request->decoded.store(false, std::memory_order_relaxed); // published to the worker by the queue's mutex
+        impl->Queue(request);
+        return true;
+    }
+
+    auto
+    AssetMgr::Wait(const TextureHandle &handle)->bool
+    {
+        const std::shared_ptr<Impl::Request> &request = handle.request;
+        if (!request)
+            return false;
+        if (handle.IsDone() && !request->reloading)
+            return handle.IsLoaded();
+
+        bool decodeHere = false;
+        {
+            std::unique_lock lock(impl->mutex);
+            auto pendingIt = std::find(impl->pending.begin(), impl->pending.end(), request);
+            if (pendingIt != impl->pending.end())
+            {
+                // No worker has it yet, so skip the queue rather than wait behind it
+                impl->pending.erase(pendingIt);
+                decodeHere = true;
+            }
+            else
+            {
+                impl->decodeDone.wait(lock, [&request]() { return request->decoded.load(std::memory_order_acquire); });
+                impl->decoded.erase(std::find(impl->decoded.begin(), impl->decoded.end(), request));
+            }
+        }
+
+        if (decodeHere)
+        {
+            Impl::Decode(*request);
+            request->decoded.store(true, std::memory_order_release);
+        }
+
+        impl->Upload(request);
+        return handle.IsLoaded();
+    }
+
+    auto
+    AssetMgr::MemoryBudget(size_t bytes)->void
+    {
+        impl->memoryBudget = bytes;
+        impl->Trim();
+    }
+
+    auto
+    AssetMgr::MemoryBudget() const->size_t
+    {
+        return impl->memoryBudget;
+    }
+
+    auto
+    AssetMgr::MemoryUsage() const->size_t
+    {
+        return impl->memoryUsage;
+    }
+
+    auto
+    AssetMgr::Trim()->void
+    {
+        impl->Trim();
+    }
+
+    auto
+    AssetMgr::LoadingCount() const->size_t
+    {
+        return impl->loadingCount;
+    }
+
     auto AssetMgr::UnloadTexture(const Path &path)->void
     {
-        auto it = textures.find(path.Hash());
-        if (it != textures.end())
-            textures.erase(it);
+        auto it = impl->textures.find(path.Hash());
+        if (it != impl->textures.end())
+            impl->Unload(it);
     }
 
     auto AssetMgr::UnloadTexture(const Texture &texture)->void
@@ -64,7 +739,7 @@ namespace SDG
 
     auto AssetMgr::Initialize(Ref<Window> context)->void
     {
-        this->context = context;
+        impl->context = context;
     }
 
 } /* end namespace SDG */
@@ -4,40 +4,161 @@
  * Object that manages the loading and unloading of asset files.
  * You can use separate managers and treat them as separate banks.
  * TODO: make a singleton source of asset files that multiple asset managers
- * can share. Perhaps use shared_ptr to store the assets, and then when the
- * last ptr instance gets unloaded/deleted then it gets removed from memory.
+ * can share.
+ *
+ * Textures may be loaded asynchronously with LoadTextureAsync: file reading,
+ * decryption and image decoding run on worker threads, while the GPU upload
+ * runs on the main thread in Update, within a per-frame time budget.
+ *
+ * With a memory budget set, textures are evicted least recently used first
+ * once the budget is exceeded, and reloaded the next time they are requested.
+ * Textures a TextureHandle refers to are never evicted.
+ *
+ * ReloadTexture replaces a texture's pixels after its file changes, such as
+ * when hot reloading with HotReload, without invalidating its handles.
  */
 #pragma once
 
+#include <Engine/Filesys/AssetID.h>
 #include <Engine/Filesys/Path.h>
 #include <Engine/Graphics/Texture.h>
+#include <Engine/Lib/ClassMacros.h>
 #include <Engine/Lib/Ref.h>
 
-#include <map>
+#include <functional>
+#include <memory>
 
 namespace SDG
 {
     class Window;
 
+    enum class AssetState
+    {
+        Loading, ///< waiting on a worker thread or its upload in AssetMgr::Update
+        Loaded,
+        Failed
+    };
+
+    /// Refers to a Texture requested with AssetMgr::LoadTextureAsync. Copies refer to the same request.
+    /// May be polled from any thread, but the Texture should only be used on the main thread.
+    class TextureHandle
+    {
+        friend class AssetMgr;
+        struct Request;
+    public:
+        /// Initializes a handle that refers to no request
+        TextureHandle();
+
+        [[nodiscard]] AssetState State() const;
+        /// Whether the request has finished, whether it loaded or failed
+        [[nodiscard]] bool IsDone() const;
+        [[nodiscard]] bool IsLoaded() const;
+        [[nodiscard]] bool Empty() const { return !request; }
+
+        /// Gets the Texture, which is unloaded until State() is Loaded. The Texture is owned by the AssetMgr,
+        /// and is unloaded along with it, or by a call to AssetMgr::UnloadTexture.
+        [[nodiscard]] const Texture &Get() const;
+
+        /// Gets the reason the load failed, when State() is Failed
+        [[nodiscard]] const char *GetError() const;
+        [[nodiscard]] const Path &Filepath() const;
+    private:
+        explicit TextureHandle(std::shared_ptr<Request> request);
+        std::shared_ptr<Request> request;
+    };
+
     class AssetMgr {
+        SDG_NOCOPY(AssetMgr);
+        struct Impl;
     public:
+        using TextureCallback = std::function<void(const TextureHandle &)>;
+
+        AssetMgr();
+        /// Stops the worker threads. Textures still loading are dropped.
         ~AssetMgr();
 
         /// Sets the context window to load Textures with.
         auto Initialize(Ref<Window> context)->void;
 
+        /**
+         * Uploads textures that finished decoding on the worker threads, and invokes their callbacks.
+         * Call once per frame on the main thread. Stops when the upload budget is spent, though at
+         * least one texture is uploaded per call, so loading always makes progress.
+         */
+        auto Update()->void;
+
+        /// Sets the time Update may spend uploading textures each frame. Default is 2 milliseconds.
+        auto UploadBudget(double seconds)->void;
+        [[nodiscard]] auto UploadBudget() const->double;
+
         /**
          * Retrieves a texture already cached in the AssetMgr or loads a new one at the given path.
          * Nullptr if there was none at the path.
+         * If the texture is loading asynchronously, waits for it to finish.
          * Supported file types: png, bmp, tga
          * @param path
          * @return
          */
         auto LoadTexture(const Path &path)->Texture;
 
+        /**
+         * Starts loading a texture in the background, or gets the request for one already cached or loading.
+         * @param path - path to the image file. Supported file types: png, bmp, tga
+         * @param onComplete - invoked on the main thread once the texture has loaded or failed, from Update or
+         * Wait. Invoked immediately when the texture is already loaded.
+         */
+        auto LoadTextureAsync(const Path &path, TextureCallback onComplete = {})->TextureHandle;
+
+        /**
+         * Starts loading a texture by its ID, like LoadTextureAsync(const Path &). The ID's path must have been
+         * requested or registered with this AssetMgr before, otherwise an empty handle is returned.
+         */
+        auto LoadTextureAsync(AssetID id, TextureCallback onComplete = {})->TextureHandle;
+
+        /// Gets the texture with the ID that is cached or loading, without loading it, or an empty handle if it is
+        /// not. Marks it as recently used.
+        [[nodiscard]] auto FindTexture(AssetID id)->TextureHandle;
+
+        /// Remembers a path, so its texture can be loaded by AssetID. Paths passed to the Load functions are
+        /// remembered already.
+        auto Register(const Path &path)->AssetID;
+
+        /**
+         * Decodes a loaded texture's file again in the background, then replaces its pixels in place from Update,
+         * so TextureHandles and references to the Texture see the new image. Filter, snap, anchor and wrap settings
+         * are kept. If the file fails to decode, the old image stays.
+         * @return whether a reload started: false if the texture is not loaded, or is already reloading
+         */
+        auto ReloadTexture(const Path &path)->bool;
+
+        /**
+         * Blocks until the texture finishes loading, or a reload underway finishes, uploading it right away
+         * regardless of the budget.
+         * If no worker has started on it yet, it is decoded on the calling thread. Call on the main thread.
+         * @return whether the texture loaded
+         */
+        auto Wait(const TextureHandle &handle)->bool;
+
+        /// Sets the GPU memory, in bytes, that loaded textures may use before the least recently used ones that no
+        /// TextureHandle refers to are evicted. 0, the default, means no limit.
+        auto MemoryBudget(size_t bytes)->void;
+        [[nodiscard]] auto MemoryBudget() const->size_t;
+
+        /// Estimated GPU memory used by the loaded textures, in bytes
+        [[nodiscard]] auto MemoryUsage() const->size_t;
+
+        /// Evicts textures until memory is within budget. Loading a texture does this already, but call it after
+        /// releasing handles, such as on a scene change, to free their memory right away.
+        auto Trim()->void;
+
+        /// Number of textures requested with LoadTextureAsync that have not finished loading
+        [[nodiscard]] auto LoadingCount() const->size_t;
+
         /**
          * Unloads the Texture from memory. Unloaded texture ptr/references are valid for the
          * the lifecycle of the app, but only the inner ptr will be freed and null.
+         * A texture still loading is cancelled. Either way, handles to it become Failed, with the error
+         * "texture was unloaded"; request the path again for a new handle.
          * @param path
          */
         auto UnloadTexture(const Path &path)->void;
@@ -45,6 +166,7 @@ namespace SDG
         /**
          * Unloads the Texture from memory. Unloaded texture ptr/references are valid for the
          * the lifecycle of the app, but only the inner ptr will be freed and null.
+         * Handles to it become Failed.
          * @param path
          */
         auto UnloadTexture(const Texture &texture)->void;
@@ -53,7 +175,7 @@ namespace SDG
         /**
          * Unloads every Texture currently cached in the AssetMgr.
          * All pointers are invalidated, so any object attempting to
-         * use them will experience undefined behavior.
+         * use them will experience undefined behavior. Handles to them become Failed.
          */
         auto UnloadTextures()->void;
 
@@ -62,8 +184,6 @@ namespace SDG
          */
         auto UnloadAll()->void;
     private:
-        std::map<uint64_t, Texture> textures;
-        Ref<Window> context;
+        Impl *impl;
     };
 }
-
@@ -0,0 +1,69 @@
+/* ====================================================================================================================
+ * @file ComponentType.h - SDG_Engine
+ *
+ * @struct ComponentType
+ * Runtime description of a component type: its id, size, alignment, and how to move and destroy it. Lets an Archetype
+ * store components of any type in raw memory, without knowing the types at compile time.
+ *
+ * Components are stored in archetypes unless they ask for sparse set storage, e.g.
+ *     struct Stunned { static constexpr bool SparseStorage = true; float time; };
+ * which suits components added and removed often, such as status effects and tags: adding or removing them is O(1)
+ * and does not move an entity's other components between archetypes, but queries look them up per entity.
+ * ==================================================================================================================*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace SDG
+{
+    using ComponentTypeID = uint32_t;
+
+    /// Component types that are stored in a ComponentSet per type, instead of in archetypes
+    template <typename T>
+    concept SparseComponent = requires { requires T::SparseStorage; };
+
+    struct ComponentType
+    {
+        /// Small, dense number, assigned to each type the first time it is used as a component
+        ComponentTypeID id;
+        size_t size;
+        size_t align;
+
+        /// Move-constructs an object at dest from the one at src. Null when a memcpy does the same.
+        void (*move)(void *dest, void *src);
+        /// Destroys an object. Null when it is trivially destructible.
+        void (*destroy)(void *object);
+
+        /// Whether the type is stored in sparse sets, rather than archetypes
+        bool sparse;
+
+        /// Assigns the next component type id
+        static ComponentTypeID NextID();
+    };
+
+    /// Gets the description of a component type. Components must be move-constructible, and not const or references.
+    template <typename T>
+    const ComponentType &ComponentTypeOf()
+    {
+        static_assert(std::is_same_v<T, std::remove_cvref_t<T>>, "Component type must not be const or a reference");
+        static_assert(std::is_move_constructible_v<T>, "Component type must be move-constructible");
+
+        static const ComponentType type = {
+            ComponentType::NextID(),
+            sizeof(T),
+            alignof(T),
+            std::is_trivially_copyable_v<T> ? nullptr : +[](void *dest, void *src) {
+                new (dest) T(std::move(*static_cast<T *>(src)));
+            },
+            std::is_trivially_destructible_v<T> ? nullptr : +[](void *object) {
+                static_cast<T *>(object)->~T();
+            },
+            SparseComponent<T>
+        };
+
+        return type;
+    }
+}
@@ -33,6 +33,7 @@ namespace SDG
         auto &app  = j.at("app");
         tName     = app.at("name").get<String>();
         tOrg      = app.at("org").get<String>();
+        unsigned tWorkers = app.value("workers", 0u);
 
         if (auto window = app.find("window") != app.end())
         {
@@ -56,6 +57,7 @@ namespace SDG
 
         appName = tName;
         orgName = tOrg;
+        workers = tWorkers;
         windows.swap(tWindows);
     }
 }
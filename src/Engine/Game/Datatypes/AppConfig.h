@@ -18,9 +18,9 @@ namespace SDG
     class AppConfig : public JsonLoadable
     {
     public:
-        AppConfig() : JsonLoadable("AppConfig"), windows(), appName(), orgName() { }
+        AppConfig() : JsonLoadable("AppConfig"), windows(), appName(), orgName(), workers() { }
         AppConfig(int width, int height, uint32_t winFlags, const String &title, const String &appName, const String &orgName) :
-            JsonLoadable("AppConfig"), windows(), appName(appName), orgName(orgName)
+            JsonLoadable("AppConfig"), windows(), appName(appName), orgName(orgName), workers()
         {
             windows.emplace_back(Window{ width, height, winFlags, title });
         }
@@ -37,6 +37,8 @@ namespace SDG
 
         String appName, orgName;
         std::vector<Window> windows;
+        /// Job system worker threads; 0 for one per hardware thread, less one for the main thread
+        unsigned workers;
     private:
         void LoadJsonImpl(const json &j) override;
     };
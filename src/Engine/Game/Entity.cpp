@@ -1,14 +0,0 @@
-#include "Entity.h"
-
-namespace SDG
-{
-    Entity::Entity()
-    {
-
-    }
-
-    Entity::~Entity()
-    {
-
-    }
-}
\ No newline at end of file
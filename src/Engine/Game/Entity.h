@@ -1,17 +1,19 @@
+/* ====================================================================================================================
+ * @file Entity.h - SDG_Engine
+ *
+ * @struct Entity
+ * Handle to an entity in a World: a GenerationalHandle whose index is the entity's slot in the World's entity table.
+ * When an entity is destroyed its slot's generation advances, so old handles to it stop matching instead of referring
+ * to whatever entity reuses the slot. Cheap to copy, compare, hash and store in components to refer to other
+ * entities.
+ * ==================================================================================================================*/
 #pragma once
+#include <Engine/Lib/GenerationalHandle.h>
 
 namespace SDG
 {
-    class Entity
-    {
-    public:
-        Entity();
-        ~Entity();
+    struct EntityTag;
+    using Entity = GenerationalHandle<EntityTag>;
 
-        virtual void Initialize();
-        virtual void Update();
-        virtual void Close();
-    private:
-
-    };
+    static_assert(sizeof(Entity) == 4);
 }
@@ -0,0 +1,226 @@
+#include "Atlas.h"
+#include "AtlasFormat.h"
+
+#include <Engine/Debug/Log.h>
+#include <Engine/Exceptions/OutOfRangeException.h>
+#include <Engine/Filesys/File.h>
+#include <Engine/Game/AssetMgr.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace SDG
+{
+    struct Atlas::Impl
+    {
+        Impl() : pages(), frames(), names(), path() { }
+
+        std::vector<TextureHandle> pages; ///< keeps the page textures loaded, which frames point to
+        std::vector<Frame> frames;        ///< ordered by name, with AtlasFormat::NameLess
+        std::vector<String> names;
+        Path path;
+
+        /// Index of the first name that is not less than name
+        [[nodiscard]] size_t LowerBound(std::string_view name) const
+        {
+            auto it = std::lower_bound(names.begin(), names.end(), name,
+                [](const String &a, std::string_view b) {
+                    return AtlasFormat::NameLess({ a.Cstr(), a.Length() }, b);
+                });
+            return it - names.begin();
+        }
+    };
+
+    /// Gets a file next to another, with the same base directory
+    static Path SiblingPath(const Path &path, std::string_view filename)
+    {
+        const String &subpath = path.Subpath();
+        const std::string_view sub(subpath.Cstr(), subpath.Length());
+        const size_t slash = sub.find_last_of('/');
+        const std::string_view dir = slash == std::string_view::npos ? std::string_view() : sub.substr(0, slash + 1);
+
+        std::string result(dir);
+        result += filename;
+        return Path(result, path.Base());
+    }
+
+    Atlas::Atlas() : impl(new Impl)
+    {
+
+    }
+
+    Atlas::~Atlas()
+    {
+        delete impl;
+    }
+
+    bool
+    Atlas::Load(const Path &path, AssetMgr &assets)
+    {
+        Close();
+
+        File file;
+        if (!file.Open(path))
+        {
+            SDG_Core_Err("Atlas::Load: failed to open atlas file: {}", file.GetError());
+            return false;
+        }
+
+        const auto *data = file.Data();
+        const auto size = (size_t)file.Size();
+
+        AtlasFormat::Header header;
+        if (size < sizeof(header))
+        {
+            SDG_Core_Err("Atlas::Load: atlas file is too small ({})", path.Str());
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+
+        const size_t pagesOffset = sizeof(header);
+        const size_t imagesOffset = pagesOffset + (size_t)header.pageCount * sizeof(AtlasFormat::Page);
+        const size_t namesOffset = imagesOffset + (size_t)header.imageCount * sizeof(AtlasFormat::Image);
+        if (std::memcmp(header.magic, AtlasFormat::Magic, sizeof(header.magic)) != 0 ||
+            header.version != AtlasFormat::Version || namesOffset + header.namesSize != size)
+        {
+            SDG_Core_Err("Atlas::Load: not an atlas file, or from an incompatible version ({})", path.Str());
+            return false;
+        }
+
+        const char *names = reinterpret_cast<const char *>(data) + namesOffset;
+        auto nameOf = [&](uint32_t offset, uint16_t length) -> std::string_view {
+            return (size_t)offset + length <= header.namesSize ? std::string_view(names + offset, length) :
+                std::string_view();
+        };
+
+        // Start decoding every page before waiting on any
+        std::vector<TextureHandle> pages(header.pageCount);
+        for (uint32_t i = 0; i < header.pageCount; ++i)
+        {
+            AtlasFormat::Page page;
+            std::memcpy(&page, data + pagesOffset + i * sizeof(page), sizeof(page));
+            pages[i] = assets.LoadTextureAsync(SiblingPath(path, nameOf(page.nameOffset, page.nameLength)));
+        }
+
+        for (auto &page : pages)
+        {
+            if (!assets.Wait(page))
+            {
+                SDG_Core_Err("Atlas::Load: failed to load atlas page ({}): {}", page.Filepath().Str(),
+                    page.GetError());
+                return false;
+            }
+        }
+
+        std::vector<Frame> frames;
+        std::vector<String> imageNames;
+        frames.reserve(header.imageCount);
+        imageNames.reserve(header.imageCount);
+        for (uint32_t i = 0; i < header.imageCount; ++i)
+        {
+            AtlasFormat::Image image;
+            std::memcpy(&image, data + imagesOffset + i * sizeof(image), sizeof(image));
+            if (image.page >= pages.size())
+            {
+                SDG_Core_Err("Atlas::Load: image {} refers to a missing page ({})", i, path.Str());
+                return false;
+            }
+
+            // The original image's top-left, relative to the page, so Frame::OffsetPos gives the trim offset
+            frames.emplace_back(
+                Rect_<uint16_t>(image.x, image.y, image.width, image.height),
+                Rect_<uint16_t>(image.x + image.trimX, image.y + image.trimY, image.origWidth, image.origHeight),
+                (image.flags & AtlasFormat::Rotated) != 0,
+                Vec2_<uint16_t>(),
+                &pages[image.page].Get());
+
+            auto name = nameOf(image.nameOffset, image.nameLength);
+            imageNames.emplace_back(name.data(), name.size());
+        }
+
+        impl->pages = std::move(pages);
+        impl->frames = std::move(frames);
+        impl->names = std::move(imageNames);
+        impl->path = path;
+        return true;
+    }
+
+    void
+    Atlas::Close()
+    {
+        impl->frames.clear();
+        impl->names.clear();
+        impl->pages.clear();
+        impl->path = Path();
+    }
+
+    bool
+    Atlas::IsLoaded() const
+    {
+        return !impl->pages.empty();
+    }
+
+    const Frame *
+    Atlas::Find(StringView name) const
+    {
+        const std::string_view key(name.Data(), name.Length());
+        const size_t index = impl->LowerBound(key);
+        if (index < impl->names.size() && impl->names[index] == name)
+            return &impl->frames[index];
+        return nullptr;
+    }
+
+    Array<Frame>
+    Atlas::FramesIn(StringView folder) const
+    {
+        std::string prefix(folder.Data(), folder.Length());
+        while (!prefix.empty() && prefix.back() == '/')
+            prefix.pop_back();
+        if (!prefix.empty())
+            prefix += '/';
+
+        // Names in a folder are not always contiguous in name order, e.g. "a/1" < "a-b" < "a/x"
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < impl->names.size(); ++i)
+        {
+            const String &name = impl->names[i];
+            if (std::string_view(name.Cstr(), name.Length()).substr(0, prefix.size()) == prefix)
+                indices.push_back(i);
+        }
+
+        Array<Frame> frames(indices.size());
+        for (size_t i = 0; i < indices.size(); ++i)
+            frames[i] = impl->frames[indices[i]];
+        return frames;
+    }
+
+    size_t
+    Atlas::Size() const
+    {
+        return impl->frames.size();
+    }
+
+    const Frame &
+    Atlas::operator[](size_t index) const
+    {
+        if (index >= impl->frames.size())
+            throw OutOfRangeException((int64_t)index, "Atlas frame index");
+        return impl->frames[index];
+    }
+
+    const String &
+    Atlas::NameAt(size_t index) const
+    {
+        if (index >= impl->names.size())
+            throw OutOfRangeException((int64_t)index, "Atlas frame index");
+        return impl->names[index];
+    }
+
+    const Path &
+    Atlas::Filepath() const
+    {
+        return impl->path;
+    }
+}
@@ -0,0 +1,60 @@
+/* ====================================================================================================================
+ * @file Atlas.h - SDG_Engine
+ *
+ * @class Atlas
+ * Frames of a texture atlas packed by SDG_ContentPipe, loaded from its .sdgatlas metadata file
+ * ==================================================================================================================*/
+#pragma once
+#include "Frame.h"
+#include <Engine/Filesys/Path.h>
+#include <Engine/Lib/Array.h>
+#include <Engine/Lib/ClassMacros.h>
+#include <Engine/Lib/String.h>
+#include <Engine/Lib/StringView.h>
+
+namespace SDG
+{
+    class AssetMgr;
+
+    /// A texture atlas: page textures, and a named Frame for each image packed into them.
+    /// Page textures are loaded through an AssetMgr, which keeps them loaded while the Atlas is, so Frames taken
+    /// from it stay valid until it is closed. Reloading a page with AssetMgr::ReloadTexture updates the Frames.
+    class Atlas
+    {
+        SDG_NOCOPY(Atlas);
+        struct Impl;
+    public:
+        Atlas();
+        ~Atlas();
+
+        /// Loads an atlas's metadata and page textures.
+        /// @param path - the .sdgatlas file, e.g. BasePath("assets/atlases/creatures.sdgatlas")
+        /// @param assets - loads the page textures, which are decoded in parallel
+        /// @return whether the metadata and every page loaded
+        bool Load(const Path &path, AssetMgr &assets);
+
+        /// Releases the page textures, and forgets every Frame
+        void Close();
+
+        [[nodiscard]] bool IsLoaded() const;
+
+        /// Finds the frame of an image by its path in the atlas source folder, without extension, e.g. "bat/fly/0"
+        /// @return the frame, or nullptr if there is none by that name
+        [[nodiscard]] const Frame *Find(StringView name) const;
+
+        /// Gets the frames of the images in a folder of the atlas source folder, including its subfolders, ordered
+        /// by name, numbered frames by number ("fly/2" before "fly/10").
+        /// @param folder - e.g. "bat/fly"
+        [[nodiscard]] Array<Frame> FramesIn(StringView folder) const;
+
+        /// Number of images in the atlas, ordered by name
+        [[nodiscard]] size_t Size() const;
+        [[nodiscard]] const Frame &operator[](size_t index) const;
+        [[nodiscard]] const String &NameAt(size_t index) const;
+
+        /// Gets the .sdgatlas file the atlas was loaded from
+        [[nodiscard]] const Path &Filepath() const;
+    private:
+        Impl *impl;
+    };
+}
@@ -0,0 +1,112 @@
+/* ====================================================================================================================
+ * @file AtlasFormat.h
+ * @namespace SDG::AtlasFormat
+ * Layout of .sdgatlas texture atlas metadata, shared by SDG_ContentPipe, which packs atlases, and SDG::Atlas, which
+ * loads them. Header-only and free of engine dependencies so the content pipeline can include it.
+ *
+ * An atlas is a set of page images, "<name>0.png", "<name>1.png", etc., next to "<name>.sdgatlas", which is, in order:
+ *     Header
+ *     Page[pageCount]
+ *     Image[imageCount]      sorted by name, with NameLess
+ *     names                  page file names and image names, packed without terminators
+ * All integers are little-endian. Image names are paths relative to the atlas source folder with '/' separators and
+ * no extension, e.g. "bat/fly/0".
+ * ==================================================================================================================*/
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+namespace SDG::AtlasFormat
+{
+    constexpr char     Magic[4] = { 'S', 'D', 'G', 'A' };
+    constexpr uint32_t Version = 1;
+
+    /// Image flags
+    enum : uint16_t
+    {
+        /// Stored rotated 90 degrees clockwise in its page
+        Rotated = 1 << 0,
+    };
+
+    struct Header
+    {
+        char     magic[4];
+        uint32_t version;
+        uint32_t pageCount;
+        uint32_t imageCount;
+        uint32_t namesSize;
+        uint32_t reserved;
+        uint64_t inputHash;   ///< identifies the source images and pack settings, so an unchanged atlas is not repacked
+    };
+
+    struct Page
+    {
+        uint32_t nameOffset;  ///< page image file name, in the same folder as the .sdgatlas file
+        uint16_t nameLength;
+        uint16_t width;
+        uint16_t height;
+        uint16_t reserved;
+    };
+
+    struct Image
+    {
+        uint32_t nameOffset;
+        uint16_t nameLength;
+        uint16_t page;
+        uint16_t x, y;              ///< position in the page
+        uint16_t width, height;     ///< size in the page, which is swapped when Rotated
+        uint16_t trimX, trimY;      ///< position of the trimmed image within the original
+        uint16_t origWidth, origHeight;
+        uint16_t flags;
+        uint16_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 32 && sizeof(Page) == 12 && sizeof(Image) == 28,
+        "AtlasFormat structs must not be padded");
+
+    /// Orders image names so numbered frames sort by number: "walk2" before "walk10"
+    constexpr bool NameLess(std::string_view a, std::string_view b)
+    {
+        auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+
+        size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size())
+        {
+            if (isDigit(a[i]) && isDigit(b[j]))
+            {
+                // Compare digit runs by value: fewer significant digits is smaller, then digit by digit
+                size_t aEnd = i, bEnd = j;
+                while (aEnd < a.size() && isDigit(a[aEnd])) ++aEnd;
+                while (bEnd < b.size() && isDigit(b[bEnd])) ++bEnd;
+
+                size_t aStart = i, bStart = j;
+                while (aStart + 1 < aEnd && a[aStart] == '0') ++aStart;
+                while (bStart + 1 < bEnd && b[bStart] == '0') ++bStart;
+
+                if (aEnd - aStart != bEnd - bStart)
+                    return aEnd - aStart < bEnd - bStart;
+                for (size_t k = 0; k < aEnd - aStart; ++k)
+                    if (a[aStart + k] != b[bStart + k])
+                        return a[aStart + k] < b[bStart + k];
+
+                // Equal values: fewer leading zeros first
+                if (aEnd - i != bEnd - j)
+                    return aEnd - i < bEnd - j;
+                i = aEnd;
+                j = bEnd;
+            }
+            else
+            {
+                if (a[i] != b[j])
+                    return (unsigned char)a[i] < (unsigned char)b[j];
+                ++i;
+                ++j;
+            }
+        }
+
+        return a.size() - i < b.size() - j;
+    }
+
+    static_assert(NameLess("walk2", "walk10") && !NameLess("walk10", "walk2") && NameLess("a", "ab") &&
+        !NameLess("a1", "a1") && NameLess("a01", "a001"));
+}
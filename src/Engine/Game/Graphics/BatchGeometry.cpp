@@ -0,0 +1,147 @@
+#include "BatchGeometry.h"
+#include "Private/BatchRecords.h"
+#include <Engine/Debug/Assert.h>
+#include <Engine/Math/Math.h>
+
+#include <SDL_gpu.h>
+
+namespace SDG
+{
+    void
+    BatchGeometry::PushQuad(const FRectangle &src, const FRectangle &dest, float rotation, Vector2 anchor,
+        Flip flip, Color color, Vector2 textureSize)
+    {
+        // Scale from source pixels to destination, mirrors GPU_BlitRectX
+        float scaleX = src.Width() != 0 ? dest.Width() / src.Width() : 1.f;
+        float scaleY = src.Height() != 0 ? dest.Height() / src.Height() : 1.f;
+
+        // Pivot in world space, and corner offsets relative to it
+        float pivotX = dest.X() + anchor.X() * scaleX;
+        float pivotY = dest.Y() + anchor.Y() * scaleY;
+        float left = -anchor.X() * scaleX;
+        float top = -anchor.Y() * scaleY;
+        float right = left + dest.Width();
+        float bottom = top + dest.Height();
+
+        // Corners in order: left-top, right-top, right-bottom, left-bottom
+        float cornersX[4] = { left, right, right, left };
+        float cornersY[4] = { top, top, bottom, bottom };
+
+        if (rotation != 0)
+        {
+            float rads = rotation * (float)Math::RadsPerDeg;
+            float cosA = Math::Cos(rads);
+            float sinA = Math::Sin(rads);
+            for (int i = 0; i < 4; ++i)
+            {
+                float x = cornersX[i], y = cornersY[i];
+                cornersX[i] = x * cosA - y * sinA;
+                cornersY[i] = x * sinA + y * cosA;
+            }
+        }
+
+        // Texture coordinates, flip only swaps them
+        float u0 = src.X() / textureSize.X();
+        float v0 = src.Y() / textureSize.Y();
+        float u1 = (src.X() + src.Width()) / textureSize.X();
+        float v1 = (src.Y() + src.Height()) / textureSize.Y();
+        if (flip == Flip::Horizontal || flip == Flip::Both)
+            Swap(u0, u1);
+        if (flip == Flip::Vertical || flip == Flip::Both)
+            Swap(v0, v1);
+
+        float cornersS[4] = { u0, u1, u1, u0 };
+        float cornersT[4] = { v0, v0, v1, v1 };
+
+        auto base = (uint16_t)vertices.size();
+        for (int i = 0; i < 4; ++i)
+        {
+            vertices.emplace_back(BatchVertex{
+                pivotX + cornersX[i], pivotY + cornersY[i],
+                cornersS[i], cornersT[i],
+                color.R(), color.G(), color.B(), color.A() });
+        }
+
+        const uint16_t quadIndices[6] = { 0, 1, 2, 2, 3, 0 };
+        for (uint16_t index : quadIndices)
+            indices.emplace_back(base + index);
+    }
+
+    void
+    BatchGeometry::PushShape(const BatchRecords &records, const BatchShape &shape, Vector2 textureSize)
+    {
+        auto base = (uint16_t)vertices.size();
+        float invW = 1.f / textureSize.X(), invH = 1.f / textureSize.Y();
+
+        const BatchVertex *shapeVertices = records.shapeVertices.data() + shape.firstVertex;
+        for (uint32_t i = 0; i < shape.vertexCount; ++i)
+        {
+            BatchVertex vertex = shapeVertices[i];
+            vertex.s *= invW;
+            vertex.t *= invH;
+            vertices.emplace_back(vertex);
+        }
+
+        const uint16_t *shapeIndices = records.shapeIndices.data() + shape.firstIndex;
+        for (uint32_t i = 0; i < shape.indexCount; ++i)
+            indices.emplace_back((uint16_t)(base + shapeIndices[i]));
+    }
+
+    size_t
+    BatchGeometry::PushTextureRun(const BatchRecords &records, size_t first)
+    {
+        return PushRun(records, first, false);
+    }
+
+    size_t
+    BatchGeometry::PushShapeRun(const BatchRecords &records, size_t first)
+    {
+        return PushRun(records, first, true);
+    }
+
+    size_t
+    BatchGeometry::PushRun(const BatchRecords &records, size_t first, bool shapesOnly)
+    {
+        const size_t size = records.Size();
+        const GPU_Image *texture = records.textures[first];
+        Vector2 textureSize((float)texture->texture_w, (float)texture->texture_h);
+
+        size_t i = first;
+        for (; i < size && records.textures[i] == texture; ++i)
+        {
+            uint32_t shape = records.shapes[i];
+            if (shape == BatchRecords::NoShape)
+            {
+                if (shapesOnly || Full()) break;
+
+                const BatchTransform &transform = records.transforms[i];
+                PushQuad(records.srcs[i], records.dests[i], transform.rotation, transform.anchor,
+                    transform.flip, records.colors[i], textureSize);
+            }
+            else
+            {
+                const BatchShape &range = records.shapeRanges[shape];
+                if (!Fits(range.vertexCount)) break;
+
+                PushShape(records, range, textureSize);
+            }
+        }
+
+        SDG_Assert(i > first); // a run must make progress; shapes never exceed MaxVertices
+        return i;
+    }
+
+    void
+    BatchGeometry::Clear()
+    {
+        vertices.clear();
+        indices.clear();
+    }
+
+    void
+    BatchGeometry::Reserve(size_t quads)
+    {
+        vertices.reserve(quads * 4);
+        indices.reserve(quads * 6);
+    }
+}
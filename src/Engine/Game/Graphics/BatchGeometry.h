@@ -0,0 +1,96 @@
+/* ====================================================================================================================
+ * @file BatchGeometry.h
+ * @class SDG::BatchGeometry
+ * CPU-side vertex and index buffer used by SpriteBatch to submit runs of same-texture quads and shapes in one draw
+ * call. Rotation, anchor and flip are baked into the quad corners, so no graphics context is needed to build it.
+ *
+ * ==================================================================================================================*/
+#pragma once
+
+#include <Engine/Graphics/Color.h>
+#include <Engine/Graphics/Flip.h>
+#include <Engine/Math/Rectangle.h>
+#include <Engine/Math/Vector2.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SDG
+{
+    struct BatchRecords;
+    struct BatchShape;
+
+    /// Interleaved vertex: position, texture coordinates, and 8-bit color.
+    /// Layout matches SDL_gpu's GPU_BATCH_XY_ST_RGBA8 format.
+    struct BatchVertex
+    {
+        float x, y;
+        float s, t;
+        uint8_t r, g, b, a;
+    };
+
+    class BatchGeometry
+    {
+    public:
+        /// Maximum number of quads per submission. Vertex counts and indices are 16-bit.
+        static constexpr size_t MaxQuads = UINT16_MAX / 4;
+        /// Maximum number of vertices per submission
+        static constexpr size_t MaxVertices = MaxQuads * 4;
+
+        /// Appends a textured quad. Parameters match those of SpriteBatch::DrawTexture.
+        /// @param src         - source rectangle in texture pixels
+        /// @param dest        - destination rectangle, before rotation
+        /// @param rotation    - rotation in degrees about the anchor
+        /// @param anchor      - rotation pivot, in source pixels relative to the src rectangle's top-left
+        /// @param flip        - flips the texture coordinates; the quad's position is not affected
+        /// @param color       - vertex color to tint the quad with
+        /// @param textureSize - full pixel size of the texture, used to normalize texture coordinates
+        void PushQuad(const FRectangle &src, const FRectangle &dest, float rotation, Vector2 anchor,
+            Flip flip, Color color, Vector2 textureSize);
+
+        /// Appends a shape's triangles from draw records' shape geometry
+        /// @param records     - records holding the shape
+        /// @param shape       - range of the shape in the records' shape geometry
+        /// @param textureSize - full pixel size of the texture, used to normalize texture coordinates
+        void PushShape(const BatchRecords &records, const BatchShape &shape, Vector2 textureSize);
+
+        /// Appends quads and shapes for consecutive draw records that share the texture of the first one,
+        /// stopping when the texture changes or the buffer is full.
+        /// @param records - draw records, non-empty past "first"
+        /// @param first   - index of the first record to append
+        /// @returns index of the first record not appended
+        size_t PushTextureRun(const BatchRecords &records, size_t first);
+
+        /// Appends consecutive shape draw records that share the texture of the first one, stopping at a quad,
+        /// a texture change, or when the buffer is full.
+        /// @param records - draw records, whose record at "first" is a shape
+        /// @param first   - index of the first record to append
+        /// @returns index of the first record not appended
+        size_t PushShapeRun(const BatchRecords &records, size_t first);
+
+        /// Removes all vertices and indices. Keeps reserved memory.
+        void Clear();
+
+        /// Reserves memory for a number of quads
+        void Reserve(size_t quads);
+
+        [[nodiscard]] const BatchVertex *Vertices() const { return vertices.data(); }
+        [[nodiscard]] size_t VertexCount() const { return vertices.size(); }
+
+        [[nodiscard]] const uint16_t *Indices() const { return indices.data(); }
+        [[nodiscard]] size_t IndexCount() const { return indices.size(); }
+
+        [[nodiscard]] size_t QuadCount() const { return vertices.size() / 4; }
+        [[nodiscard]] bool Empty() const { return vertices.empty(); }
+        /// Whether another quad would exceed the 16-bit index range
+        [[nodiscard]] bool Full() const { return !Fits(4); }
+        /// Whether a number of vertices can be added without exceeding the 16-bit index range
+        [[nodiscard]] bool Fits(size_t vertexCount) const { return vertices.size() + vertexCount <= MaxVertices; }
+    private:
+        size_t PushRun(const BatchRecords &records, size_t first, bool shapesOnly);
+
+        std::vector<BatchVertex> vertices;
+        std::vector<uint16_t>    indices;
+    };
+}
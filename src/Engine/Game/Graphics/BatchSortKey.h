@@ -0,0 +1,64 @@
+/* ====================================================================================================================
+ * @file BatchSortKey.h
+ * @namespace SDG::BatchSortKey
+ * Packs SpriteBatch sort criteria into a single 64-bit key, so draws can be ordered with one radix sort.
+ *
+ * Layout, from most to least significant bits:
+ *   [ depth : 24 ][ texture id : 16 ][ submission order : 24 ]
+ * Submission order in the lowest bits keeps equal keys in the order they were drawn, and doubles as the index
+ * of the draw record to gather after sorting.
+ * ==================================================================================================================*/
+#pragma once
+#include <bit>
+#include <cstdint>
+
+namespace SDG::BatchSortKey
+{
+    constexpr int DepthBits = 24;
+    constexpr int TextureBits = 16;
+    constexpr int OrderBits = 24;
+
+    constexpr uint64_t DepthMask = (1ull << DepthBits) - 1;
+    constexpr uint64_t TextureMask = (1ull << TextureBits) - 1;
+    constexpr uint64_t OrderMask = (1ull << OrderBits) - 1;
+
+    /// Maximum number of draws that can be ordered in one batch
+    constexpr uint64_t MaxOrder = OrderMask;
+    /// Largest texture id; further textures share this id
+    constexpr uint64_t MaxTextureId = TextureMask;
+
+    /// Maps a depth onto an unsigned value with the same ordering, keeping its most significant DepthBits.
+    /// Depths closer than about 1 part in 32768 of each other are treated as equal.
+    /// @param descending - invert the ordering so higher depths come first
+    [[nodiscard]] inline uint32_t QuantizeDepth(float depth, bool descending = false)
+    {
+        if (depth == 0) depth = 0; // -0 sorts with +0
+
+        // Flip all bits of negatives, and only the sign bit of positives
+        auto bits = std::bit_cast<uint32_t>(depth);
+        bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+        bits >>= (32 - DepthBits);
+
+        return descending ? (uint32_t)(~bits & DepthMask) : bits;
+    }
+
+    /// Creates a key from a quantized depth, texture id and submission order
+    [[nodiscard]] inline uint64_t Make(uint32_t depth, uint32_t textureId, uint32_t order)
+    {
+        return ((uint64_t)depth & DepthMask) << (TextureBits + OrderBits) |
+            ((uint64_t)textureId & TextureMask) << OrderBits |
+            ((uint64_t)order & OrderMask);
+    }
+
+    /// Gets the submission order, or index of the draw, from a key
+    [[nodiscard]] inline uint32_t Order(uint64_t key)
+    {
+        return (uint32_t)(key & OrderMask);
+    }
+
+    /// Gets the texture id from a key
+    [[nodiscard]] inline uint32_t TextureId(uint64_t key)
+    {
+        return (uint32_t)((key >> OrderBits) & TextureMask);
+    }
+}
@@ -146,6 +146,31 @@ namespace SDG
         return Math::Transform(screenPos, impl->inverse);
     }
 
+    FRectangle
+    Camera2D::WorldBounds() const
+    {
+        Update();
+
+        auto w = (float)impl->size.X(), h = (float)impl->size.Y();
+        Vector2 corners[4] = {
+            Math::Transform({0, 0}, impl->inverse),
+            Math::Transform({w, 0}, impl->inverse),
+            Math::Transform({w, h}, impl->inverse),
+            Math::Transform({0, h}, impl->inverse)
+        };
+
+        float left = corners[0].X(), right = left, top = corners[0].Y(), bottom = top;
+        for (int i = 1; i < 4; ++i)
+        {
+            left = SDG_Min(left, corners[i].X());
+            right = SDG_Max(right, corners[i].X());
+            top = SDG_Min(top, corners[i].Y());
+            bottom = SDG_Max(bottom, corners[i].Y());
+        }
+
+        return { left, top, right - left, bottom - top };
+    }
+
     Camera2D &
     Camera2D::PivotPoint(Vector2 anchor, Vector2 normalized) noexcept
     {
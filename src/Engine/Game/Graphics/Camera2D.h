@@ -92,6 +92,10 @@ namespace SDG
         /// Gets the viewport resolution size
         const Point &ViewportSize() const noexcept;
 
+        /// Gets the axis-aligned bounding box of the viewport in world space, accounting for position,
+        /// pivot, zoom and rotation. Useful for culling what the camera cannot see.
+        FRectangle WorldBounds() const;
+
         /// Gets the internal matrix for referencing
         Ref<const class Matrix4x4> Matrix() const;
     private:
@@ -0,0 +1,150 @@
+#include "BatchRecords.h"
+#include "../BatchSortKey.h"
+
+#include <Engine/Debug/Assert.h>
+
+namespace SDG
+{
+    void
+    BatchRecords::Push(const GPU_Image *texture, const FRectangle &src, const FRectangle &dest, float rotation,
+        const Vector2 &anchor, Flip flip, const Color &color, float depth)
+    {
+        textures.emplace_back(texture);
+        srcs.emplace_back(src);
+        dests.emplace_back(dest);
+        transforms.emplace_back(BatchTransform{ rotation, anchor, flip });
+        colors.emplace_back(color);
+        depths.emplace_back(depth);
+        shapes.emplace_back(NoShape);
+    }
+
+    void
+    BatchRecords::PushShape(const GPU_Image *texture, const FRectangle &bounds, const Color &color, float depth,
+        size_t vertexCount, size_t indexCount, BatchVertex *&vertices, uint16_t *&indices)
+    {
+        SDG_Assert(vertexCount <= BatchGeometry::MaxVertices);
+
+        textures.emplace_back(texture);
+        srcs.emplace_back(FRectangle{});
+        dests.emplace_back(bounds);
+        transforms.emplace_back(BatchTransform{ 0, {}, Flip::None });
+        colors.emplace_back(color);
+        depths.emplace_back(depth);
+        shapes.emplace_back((uint32_t)shapeRanges.size());
+
+        size_t firstVertex = shapeVertices.size(), firstIndex = shapeIndices.size();
+        shapeRanges.emplace_back(BatchShape{ (uint32_t)firstVertex, (uint32_t)vertexCount,
+            (uint32_t)firstIndex, (uint32_t)indexCount });
+        shapeVertices.resize(firstVertex + vertexCount);
+        shapeIndices.resize(firstIndex + indexCount);
+
+        vertices = shapeVertices.data() + firstVertex;
+        indices = shapeIndices.data() + firstIndex;
+    }
+
+    void
+    BatchRecords::Append(const BatchRecords &other)
+    {
+        textures.insert(textures.end(), other.textures.begin(), other.textures.end());
+        srcs.insert(srcs.end(), other.srcs.begin(), other.srcs.end());
+        dests.insert(dests.end(), other.dests.begin(), other.dests.end());
+        transforms.insert(transforms.end(), other.transforms.begin(), other.transforms.end());
+        colors.insert(colors.end(), other.colors.begin(), other.colors.end());
+        depths.insert(depths.end(), other.depths.begin(), other.depths.end());
+
+        // Shift the other set's shape references past the shapes already held
+        auto shapeOffset = (uint32_t)shapeRanges.size();
+        auto vertexOffset = (uint32_t)shapeVertices.size(), indexOffset = (uint32_t)shapeIndices.size();
+        for (uint32_t shape : other.shapes)
+            shapes.emplace_back(shape == NoShape ? NoShape : shape + shapeOffset);
+        for (const BatchShape &range : other.shapeRanges)
+        {
+            shapeRanges.emplace_back(BatchShape{ range.firstVertex + vertexOffset, range.vertexCount,
+                range.firstIndex + indexOffset, range.indexCount });
+        }
+        shapeVertices.insert(shapeVertices.end(), other.shapeVertices.begin(), other.shapeVertices.end());
+        shapeIndices.insert(shapeIndices.end(), other.shapeIndices.begin(), other.shapeIndices.end());
+    }
+
+    void
+    BatchRecords::Gather(const BatchRecords &from, const uint64_t *keys, size_t count)
+    {
+        textures.resize(count);
+        srcs.resize(count);
+        dests.resize(count);
+        transforms.resize(count);
+        colors.resize(count);
+        depths.resize(count);
+        shapes.resize(count);
+
+        // One pass per array keeps each write stream sequential
+        for (size_t i = 0; i < count; ++i)
+            textures[i] = from.textures[BatchSortKey::Order(keys[i])];
+        for (size_t i = 0; i < count; ++i)
+            srcs[i] = from.srcs[BatchSortKey::Order(keys[i])];
+        for (size_t i = 0; i < count; ++i)
+            dests[i] = from.dests[BatchSortKey::Order(keys[i])];
+        for (size_t i = 0; i < count; ++i)
+            transforms[i] = from.transforms[BatchSortKey::Order(keys[i])];
+        for (size_t i = 0; i < count; ++i)
+            colors[i] = from.colors[BatchSortKey::Order(keys[i])];
+        for (size_t i = 0; i < count; ++i)
+            depths[i] = from.depths[BatchSortKey::Order(keys[i])];
+        for (size_t i = 0; i < count; ++i)
+            shapes[i] = from.shapes[BatchSortKey::Order(keys[i])];
+    }
+
+    void
+    BatchRecords::Clear()
+    {
+        textures.clear();
+        srcs.clear();
+        dests.clear();
+        transforms.clear();
+        colors.clear();
+        depths.clear();
+        shapes.clear();
+        shapeRanges.clear();
+        shapeVertices.clear();
+        shapeIndices.clear();
+    }
+
+    void
+    BatchRecords::Reserve(size_t count)
+    {
+        textures.reserve(count);
+        srcs.reserve(count);
+        dests.reserve(count);
+        transforms.reserve(count);
+        colors.reserve(count);
+        depths.reserve(count);
+        shapes.reserve(count);
+    }
+
+    void
+    BatchRecords::Swap(BatchRecords &other) noexcept
+    {
+        textures.swap(other.textures);
+        srcs.swap(other.srcs);
+        dests.swap(other.dests);
+        transforms.swap(other.transforms);
+        colors.swap(other.colors);
+        depths.swap(other.depths);
+        shapes.swap(other.shapes);
+        shapeRanges.swap(other.shapeRanges);
+        shapeVertices.swap(other.shapeVertices);
+        shapeIndices.swap(other.shapeIndices);
+    }
+
+    void
+    BatchRecords::SwapDraws(BatchRecords &other) noexcept
+    {
+        textures.swap(other.textures);
+        srcs.swap(other.srcs);
+        dests.swap(other.dests);
+        transforms.swap(other.transforms);
+        colors.swap(other.colors);
+        depths.swap(other.depths);
+        shapes.swap(other.shapes);
+    }
+}
@@ -0,0 +1,97 @@
+/* ====================================================================================================================
+ * @file BatchRecords.h
+ * @class SDG::BatchRecords
+ * Private storage for SpriteBatch draw records. Each field lives in its own contiguous array, so passes that only
+ * need some fields (sorting reads depths and textures, vertex building skips depths) stay cache-friendly.
+ * Shape draws, such as lines and circles, refer to triangles kept in shared shape geometry arrays.
+ * Memory is kept when cleared, so steady-state frames do not allocate.
+ * ==================================================================================================================*/
+#pragma once
+
+#include "../BatchGeometry.h"
+
+#include <Engine/Graphics/Color.h>
+#include <Engine/Graphics/Flip.h>
+#include <Engine/Math/Rectangle.h>
+#include <Engine/Math/Vector2.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct GPU_Image;
+
+namespace SDG
+{
+    /// Per-draw rotation, pivot and flip
+    struct BatchTransform
+    {
+        float   rotation;
+        Vector2 anchor;
+        Flip    flip;
+    };
+
+    /// Range of a shape draw's triangles in the shape geometry arrays of BatchRecords
+    struct BatchShape
+    {
+        uint32_t firstVertex, vertexCount;
+        uint32_t firstIndex, indexCount;
+    };
+
+    struct BatchRecords
+    {
+        /// Shape index of draws that are textured quads
+        static constexpr uint32_t NoShape = UINT32_MAX;
+
+        std::vector<const GPU_Image *> textures;
+        std::vector<FRectangle>        srcs;
+        std::vector<FRectangle>        dests;
+        std::vector<BatchTransform>    transforms;
+        std::vector<Color>             colors;
+        std::vector<float>             depths;
+        /// Index into shapeRanges, or NoShape
+        std::vector<uint32_t>          shapes;
+
+        // Shape geometry, shared by all shape draws. Sorting leaves it in place.
+        std::vector<BatchShape>        shapeRanges;
+        /// Untransformed shape vertices, with texture coordinates in pixels
+        std::vector<BatchVertex>       shapeVertices;
+        /// Shape indices, relative to the shape's first vertex
+        std::vector<uint16_t>          shapeIndices;
+
+        void Push(const GPU_Image *texture, const FRectangle &src, const FRectangle &dest, float rotation,
+            const Vector2 &anchor, Flip flip, const Color &color, float depth);
+
+        /// Adds a shape draw and makes room for its geometry, which the caller must fill in.
+        /// @param bounds      - axis-aligned bounds of the shape, stored as the draw's destination
+        /// @param vertexCount - number of vertices, at most BatchGeometry::MaxVertices
+        /// @param indexCount  - number of indices, each of which must be below vertexCount
+        /// @param vertices    - receives the first of vertexCount vertices to write
+        /// @param indices     - receives the first of indexCount indices to write
+        void PushShape(const GPU_Image *texture, const FRectangle &bounds, const Color &color, float depth,
+            size_t vertexCount, size_t indexCount, BatchVertex *&vertices, uint16_t *&indices);
+
+        /// Appends all records from another set, after the records already held
+        void Append(const BatchRecords &other);
+
+        /// Replaces draws with records from another set, in the order given by sort keys. Shape geometry is not
+        /// copied, so gathered shape draws still refer to that of "from"; use SwapDraws to move them back.
+        /// @param from  - records to copy from
+        /// @param keys  - sorted BatchSortKey values, each holding the index of a record in "from"
+        /// @param count - number of keys
+        void Gather(const BatchRecords &from, const uint64_t *keys, size_t count);
+
+        /// Removes all records. Keeps reserved memory.
+        void Clear();
+
+        void Reserve(size_t count);
+
+        void Swap(BatchRecords &other) noexcept;
+        /// Swaps per-draw arrays, leaving shape geometry in place
+        void SwapDraws(BatchRecords &other) noexcept;
+
+        [[nodiscard]] size_t Size() const { return textures.size(); }
+        [[nodiscard]] size_t Capacity() const { return textures.capacity(); }
+        [[nodiscard]] bool Empty() const { return textures.empty(); }
+    };
+}
@@ -0,0 +1,232 @@
+#include "BatchShapes.h"
+
+#include <Engine/Debug/Assert.h>
+#include <Engine/Math/Math.h>
+
+#include <cmath>
+
+namespace SDG::BatchShapes
+{
+    /// Longest a miter may reach, in half-thicknesses, before sharp joins are clipped
+    static constexpr float MiterLimit = 4.f;
+
+    /// Texture coordinate at the center of a 1x1 pixel
+    static constexpr float PixelCenter = .5f;
+
+    static BatchVertex
+    MakeVertex(float x, float y, const Color &color)
+    {
+        return { x, y, PixelCenter, PixelCenter, color.R(), color.G(), color.B(), color.A() };
+    }
+
+    /// Gets the unit normal of the segment from a to b. Leaves the normal as it was if they are the same point,
+    /// so repeated points keep the previous segment's normal.
+    /// @returns whether the normal was set
+    static bool
+    SegmentNormal(const Vector2 &a, const Vector2 &b, float &normalX, float &normalY)
+    {
+        float dx = b.X() - a.X(), dy = b.Y() - a.Y();
+        float length = std::sqrt(dx * dx + dy * dy);
+        if (length == 0)
+            return false;
+
+        normalX = -dy / length;
+        normalY = dx / length;
+        return true;
+    }
+
+    int
+    CircleSegments(float radius)
+    {
+        radius = std::abs(radius);
+        if (radius <= .25f)
+            return 8;
+
+        // Chord error is r * (1 - cos(step / 2))
+        float step = 2.f * std::acos(1.f - .25f / radius);
+        return SDG_Clamp((int)std::ceil(2.f * (float)Math::Pi / step), 8, MaxCircleSegments);
+    }
+
+    FRectangle
+    Bounds(const Vector2 *points, size_t count, float margin)
+    {
+        SDG_Assert(count > 0);
+
+        float left = points[0].X(), right = left, top = points[0].Y(), bottom = top;
+        for (size_t i = 1; i < count; ++i)
+        {
+            left = SDG_Min(left, points[i].X());
+            right = SDG_Max(right, points[i].X());
+            top = SDG_Min(top, points[i].Y());
+            bottom = SDG_Max(bottom, points[i].Y());
+        }
+
+        return { left - margin, top - margin, right - left + margin * 2.f, bottom - top + margin * 2.f };
+    }
+
+    FRectangle
+    PolylineBounds(const Vector2 *points, size_t count, float thickness)
+    {
+        return Bounds(points, count, std::abs(thickness) * .5f * MiterLimit);
+    }
+
+    void
+    Polyline(BatchRecords &records, const GPU_Image *pixel, const Vector2 *points, size_t count,
+        float thickness, bool closed, const Color &color, float depth, const FRectangle &bounds)
+    {
+        SDG_Assert(count >= 2 && count <= MaxPolylinePoints);
+
+        const size_t segmentCount = closed ? count : count - 1;
+        BatchVertex *vertices;
+        uint16_t *indices;
+        records.PushShape(pixel, bounds, color, depth, count * 2, segmentCount * 6, vertices, indices);
+
+        const float half = thickness * .5f;
+
+        // Normal entering the first point: that of the last segment before it, or of the first segment of an
+        // open line
+        float inX = 0, inY = 1.f;
+        if (closed)
+        {
+            for (size_t i = count; i-- > 0 && !SegmentNormal(points[i], points[(i + 1) % count], inX, inY); ) { }
+        }
+        else
+        {
+            for (size_t i = 0; i + 1 < count && !SegmentNormal(points[i], points[i + 1], inX, inY); ++i) { }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            // Normal leaving this point
+            float outX = inX, outY = inY;
+            if (i + 1 < count)
+                SegmentNormal(points[i], points[i + 1], outX, outY);
+            else if (closed)
+                SegmentNormal(points[i], points[0], outX, outY);
+
+            // Miter along the average of both normals, scaled to keep the edges parallel to the segments
+            float miterX = inX + outX, miterY = inY + outY;
+            float miterLength = std::sqrt(miterX * miterX + miterY * miterY);
+            float scale = half;
+            if (miterLength > 1e-4f)
+            {
+                miterX /= miterLength;
+                miterY /= miterLength;
+                scale = half / SDG_Max(miterX * outX + miterY * outY, 1.f / MiterLimit);
+            }
+            else
+            {
+                // The line folds back on itself
+                miterX = outX;
+                miterY = outY;
+            }
+
+            const Vector2 &point = points[i];
+            vertices[i * 2] = MakeVertex(point.X() + miterX * scale, point.Y() + miterY * scale, color);
+            vertices[i * 2 + 1] = MakeVertex(point.X() - miterX * scale, point.Y() - miterY * scale, color);
+
+            inX = outX;
+            inY = outY;
+        }
+
+        for (size_t i = 0; i < segmentCount; ++i)
+        {
+            auto a = (uint16_t)(i * 2);
+            auto b = (uint16_t)(((i + 1) % count) * 2);
+            const uint16_t segment[6] = { a, (uint16_t)(a + 1), (uint16_t)(b + 1), (uint16_t)(b + 1), b, a };
+            for (int j = 0; j < 6; ++j)
+                indices[i * 6 + j] = segment[j];
+        }
+    }
+
+    void
+    Circle(BatchRecords &records, const GPU_Image *pixel, const SDG::Circle &circle, int segments,
+        const Color &color, float depth)
+    {
+        segments = SDG_Clamp(segments, 3, MaxCircleSegments);
+        const float radius = std::abs(circle.Radius());
+        const FRectangle bounds{ circle.X() - radius, circle.Y() - radius, radius * 2.f, radius * 2.f };
+
+        BatchVertex *vertices;
+        uint16_t *indices;
+        records.PushShape(pixel, bounds, color, depth, (size_t)segments + 1, (size_t)segments * 3,
+            vertices, indices);
+
+        // Walk the rim by rotating one offset, so only one sine and cosine are needed
+        float step = 2.f * (float)Math::Pi / (float)segments;
+        float cosStep = std::cos(step), sinStep = std::sin(step);
+        float x = radius, y = 0;
+
+        vertices[0] = MakeVertex(circle.X(), circle.Y(), color);
+        for (int i = 0; i < segments; ++i)
+        {
+            vertices[i + 1] = MakeVertex(circle.X() + x, circle.Y() + y, color);
+
+            float nextX = x * cosStep - y * sinStep;
+            y = x * sinStep + y * cosStep;
+            x = nextX;
+
+            indices[i * 3] = 0;
+            indices[i * 3 + 1] = (uint16_t)(i + 1);
+            indices[i * 3 + 2] = (uint16_t)((i + 1) % segments + 1);
+        }
+    }
+
+    void
+    CircleOutline(BatchRecords &records, const GPU_Image *pixel, const SDG::Circle &circle, int segments,
+        float thickness, const Color &color, float depth)
+    {
+        segments = SDG_Clamp(segments, 3, MaxCircleSegments);
+        const float half = std::abs(thickness) * .5f;
+        const float radius = std::abs(circle.Radius());
+        const float outer = radius + half;
+        const FRectangle bounds{ circle.X() - outer, circle.Y() - outer, outer * 2.f, outer * 2.f };
+
+        BatchVertex *vertices;
+        uint16_t *indices;
+        records.PushShape(pixel, bounds, color, depth, (size_t)segments * 2, (size_t)segments * 6,
+            vertices, indices);
+
+        float step = 2.f * (float)Math::Pi / (float)segments;
+        float cosStep = std::cos(step), sinStep = std::sin(step);
+        float x = 1.f, y = 0; // unit direction to the rim
+        float inner = radius - half;
+
+        for (int i = 0; i < segments; ++i)
+        {
+            vertices[i * 2] = MakeVertex(circle.X() + x * outer, circle.Y() + y * outer, color);
+            vertices[i * 2 + 1] = MakeVertex(circle.X() + x * inner, circle.Y() + y * inner, color);
+
+            float nextX = x * cosStep - y * sinStep;
+            y = x * sinStep + y * cosStep;
+            x = nextX;
+
+            auto a = (uint16_t)(i * 2);
+            auto b = (uint16_t)(((i + 1) % segments) * 2);
+            const uint16_t segment[6] = { a, (uint16_t)(a + 1), (uint16_t)(b + 1), (uint16_t)(b + 1), b, a };
+            for (int j = 0; j < 6; ++j)
+                indices[i * 6 + j] = segment[j];
+        }
+    }
+
+    void
+    ConvexPolygon(BatchRecords &records, const GPU_Image *pixel, const Vector2 *points, size_t count,
+        const Color &color, float depth, const FRectangle &bounds)
+    {
+        SDG_Assert(count >= 3 && count <= MaxPolygonPoints);
+
+        BatchVertex *vertices;
+        uint16_t *indices;
+        records.PushShape(pixel, bounds, color, depth, count, (count - 2) * 3, vertices, indices);
+
+        for (size_t i = 0; i < count; ++i)
+            vertices[i] = MakeVertex(points[i].X(), points[i].Y(), color);
+
+        for (size_t i = 0; i + 2 < count; ++i)
+        {
+            indices[i * 3] = 0;
+            indices[i * 3 + 1] = (uint16_t)(i + 1);
+            indices[i * 3 + 2] = (uint16_t)(i + 2);
+        }
+    }
+}
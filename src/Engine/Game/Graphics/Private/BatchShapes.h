@@ -0,0 +1,46 @@
+/* ====================================================================================================================
+ * @file BatchShapes.h
+ * @namespace SDG::BatchShapes
+ * Private helpers that write lines, circles and convex polygons into BatchRecords as shape draws, generating their
+ * triangles directly. Texture coordinates sample the center of a 1x1 pixel texture.
+ * ==================================================================================================================*/
+#pragma once
+#include "BatchRecords.h"
+
+#include <Engine/Math/Circle.h>
+
+namespace SDG::BatchShapes
+{
+    /// Most points in one polyline shape. Longer open polylines are split into several shapes.
+    constexpr size_t MaxPolylinePoints = BatchGeometry::MaxVertices / 2;
+    /// Most points in one filled polygon
+    constexpr size_t MaxPolygonPoints = BatchGeometry::MaxVertices;
+    /// Most segments in a circle
+    constexpr int MaxCircleSegments = 256;
+
+    /// Number of segments that keeps a circle's edge within a quarter pixel of its true curve
+    [[nodiscard]] int CircleSegments(float radius);
+
+    /// Axis-aligned bounds of a set of points, grown by a margin on each side
+    [[nodiscard]] FRectangle Bounds(const Vector2 *points, size_t count, float margin);
+
+    /// Bounds of a polyline of a given thickness, including its mitered joins
+    [[nodiscard]] FRectangle PolylineBounds(const Vector2 *points, size_t count, float thickness);
+
+    /// Writes a polyline with mitered joins. At most MaxPolylinePoints points.
+    /// @param closed - joins the last point back to the first
+    void Polyline(BatchRecords &records, const GPU_Image *pixel, const Vector2 *points, size_t count,
+        float thickness, bool closed, const Color &color, float depth, const FRectangle &bounds);
+
+    /// Writes a filled circle as a triangle fan
+    void Circle(BatchRecords &records, const GPU_Image *pixel, const SDG::Circle &circle, int segments,
+        const Color &color, float depth);
+
+    /// Writes a circle outline, centered on the circle's edge
+    void CircleOutline(BatchRecords &records, const GPU_Image *pixel, const SDG::Circle &circle, int segments,
+        float thickness, const Color &color, float depth);
+
+    /// Writes a filled convex polygon as a triangle fan. At most MaxPolygonPoints points.
+    void ConvexPolygon(BatchRecords &records, const GPU_Image *pixel, const Vector2 *points, size_t count,
+        const Color &color, float depth, const FRectangle &bounds);
+}
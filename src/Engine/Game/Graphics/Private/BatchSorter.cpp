@@ -0,0 +1,118 @@
+#include "BatchSorter.h"
+#include "../BatchSortKey.h"
+
+#include <Engine/Debug/Assert.h>
+#include <Engine/Lib/Algorithm.h>
+#include <Engine/Math/Math.h>
+
+#include <algorithm>
+
+namespace SDG
+{
+    static size_t
+    HashTexture(const GPU_Image *texture)
+    {
+        return (size_t)(((uint64_t)(uintptr_t)texture * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    // ===== TextureIdTable =======================================================================
+    void
+    TextureIdTable::Clear()
+    {
+        std::fill(slots.begin(), slots.end(), Slot{});
+        count = 0;
+    }
+
+    uint32_t
+    TextureIdTable::Get(const GPU_Image *texture)
+    {
+        if ((count + 1) * 2 > slots.size())
+            Grow();
+
+        size_t mask = slots.size() - 1;
+        for (size_t i = HashTexture(texture) & mask; ; i = (i + 1) & mask)
+        {
+            Slot &slot = slots[i];
+            if (slot.texture == texture)
+                return slot.id;
+            if (!slot.texture)
+            {
+                slot.texture = texture;
+                slot.id = (uint32_t)SDG_Min(count, BatchSortKey::MaxTextureId);
+                ++count;
+                return slot.id;
+            }
+        }
+    }
+
+    void
+    TextureIdTable::Grow()
+    {
+        std::vector<Slot> last(slots.empty() ? 16 : slots.size() * 2);
+        last.swap(slots);
+
+        size_t mask = slots.size() - 1;
+        for (const Slot &slot : last)
+        {
+            if (!slot.texture) continue;
+
+            size_t i = HashTexture(slot.texture) & mask;
+            while (slots[i].texture)
+                i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+    }
+
+    // ===== BatchSorter ==========================================================================
+    void
+    BatchSorter::Sort(BatchRecords &records, SortMode sortMode)
+    {
+        const size_t size = records.Size();
+        if (sortMode == SortMode::None || size < 2)
+            return;
+
+        SDG_Assert(size <= BatchSortKey::MaxOrder); // too many draws in one batch to sort
+
+        keys.resize(size);
+        scratch.resize(size);
+
+        bool descending = sortMode == SortMode::BackToFront;
+
+        // Pack one key per draw
+        if (sortMode == SortMode::Texture)
+        {
+            textureIds.Clear();
+            const GPU_Image *lastTexture = nullptr;
+            uint32_t textureId = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (records.textures[i] != lastTexture)
+                {
+                    lastTexture = records.textures[i];
+                    textureId = textureIds.Get(lastTexture);
+                }
+
+                keys[i] = BatchSortKey::Make(BatchSortKey::QuantizeDepth(records.depths[i]), textureId, (uint32_t)i);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < size; ++i)
+                keys[i] = BatchSortKey::Make(BatchSortKey::QuantizeDepth(records.depths[i], descending), 0, (uint32_t)i);
+        }
+
+        RadixSort(keys.data(), scratch.data(), size);
+
+        // Gather the payload once, in sorted order
+        sorted.Gather(records, keys.data(), size);
+        records.SwapDraws(sorted);
+    }
+
+    void
+    BatchSorter::Reserve(size_t count)
+    {
+        sorted.Reserve(count);
+        keys.reserve(count);
+        scratch.reserve(count);
+    }
+}
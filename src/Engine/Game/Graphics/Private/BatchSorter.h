@@ -0,0 +1,50 @@
+/* ====================================================================================================================
+ * @file BatchSorter.h
+ * @class SDG::BatchSorter
+ * Private helper that orders BatchRecords by SortMode with one radix sort over packed BatchSortKeys.
+ * Sorting buffers are kept between calls, so steady-state sorts do not allocate.
+ * ==================================================================================================================*/
+#pragma once
+#include "BatchRecords.h"
+#include "../SpriteBatch.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace SDG
+{
+    /// Assigns dense ids to textures in the order they are first seen. Open addressing keeps lookups
+    /// allocation-free once the table has grown to fit the textures in use.
+    class TextureIdTable
+    {
+    public:
+        void Clear();
+        uint32_t Get(const GPU_Image *texture);
+    private:
+        struct Slot
+        {
+            const GPU_Image *texture = nullptr;
+            uint32_t id = 0;
+        };
+
+        void Grow();
+
+        std::vector<Slot> slots;
+        size_t count = 0;
+    };
+
+    class BatchSorter
+    {
+    public:
+        /// Sorts records in place. Draws that compare equal keep the order they were recorded in.
+        void Sort(BatchRecords &records, SortMode sortMode);
+
+        /// Reserves sorting memory for a number of records
+        void Reserve(size_t count);
+    private:
+        BatchRecords          sorted;
+        std::vector<uint64_t> keys;
+        std::vector<uint64_t> scratch;
+        TextureIdTable        textureIds;
+    };
+}
@@ -0,0 +1,57 @@
+/* ====================================================================================================================
+ * @file BatchTargetScope.h
+ * @class SDG::BatchTargetScope
+ * Private helper that makes a target and matrix active for the lifetime of a scope, then restores the previous
+ * ones. Calls the RenderBackend directly, skips state changes that are already in effect, and counts the rest in
+ * RenderStats.
+ * ==================================================================================================================*/
+#pragma once
+#include <Engine/Graphics/RenderBackend.h>
+#include <Engine/Graphics/RenderStats.h>
+#include <Engine/Lib/ClassMacros.h>
+
+namespace SDG
+{
+    class BatchTargetScope
+    {
+        SDG_NOCOPY(BatchTargetScope);
+    public:
+        BatchTargetScope(GPU_Target *target, const float *matrix) :
+            backend(RenderBackend::Current()), target(target), matrix(matrix),
+            lastTarget(backend.ActiveTarget()), lastMatrix(backend.CurrentMatrix())
+        {
+            RenderStats &stats = RenderStats::Frame();
+            if (target != lastTarget)
+            {
+                backend.ActiveTarget(target);
+                ++stats.targetChanges;
+            }
+            if (matrix != lastMatrix)
+            {
+                backend.LoadMatrix(matrix);
+                ++stats.matrixLoads;
+            }
+        }
+
+        ~BatchTargetScope()
+        {
+            RenderStats &stats = RenderStats::Frame();
+            if (lastTarget != target)
+            {
+                backend.ActiveTarget(lastTarget);
+                ++stats.targetChanges;
+            }
+            if (lastMatrix != matrix)
+            {
+                backend.LoadMatrix(lastMatrix);
+                ++stats.matrixLoads;
+            }
+        }
+    private:
+        RenderBackend &backend;
+        GPU_Target    *target;
+        const float   *matrix;
+        GPU_Target    *lastTarget;
+        const float   *lastMatrix;
+    };
+}
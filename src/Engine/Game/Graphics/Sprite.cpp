@@ -1,4 +1,5 @@
 #include "Sprite.h"
+#include "Atlas.h"
 #include <Engine/Exceptions/OutOfRangeException.h>
 
 namespace SDG
@@ -67,4 +68,19 @@ namespace SDG
         this->name = name;
         return true;
     }
+
+    auto Sprite::LoadFromAtlas(const String &name, const Atlas &atlas, const String &folder) -> bool
+    {
+        Array<Frame> frames = atlas.FramesIn(folder);
+        if (frames.Size() == 0) return false;
+
+        Array<unsigned> reel(frames.Size());
+        for (size_t i = 0; i < frames.Size(); ++i)
+            reel[i] = (unsigned)i;
+
+        this->frames = std::move(frames);
+        this->reel = std::move(reel);
+        this->name = name;
+        return true;
+    }
 }
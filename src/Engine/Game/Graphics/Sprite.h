@@ -23,6 +23,10 @@ namespace SDG
 
         auto LoadFromStrip(const String &name, Ref<class Texture> texture, size_t frameCount, Vector2 anchor = { 0.5f, 0.5f }) -> bool;
 
+        /// Loads the frames of the images in a folder of an atlas, in name order, e.g. "bat/fly" for "bat/fly/0",
+        /// "bat/fly/1", etc. The atlas must stay loaded while the Sprite is used.
+        auto LoadFromAtlas(const String &name, const class Atlas &atlas, const String &folder) -> bool;
+
         /// Only const indexers are available, fixed
         const Frame &operator [] (unsigned index) const;
         const Frame &At(unsigned index) const;
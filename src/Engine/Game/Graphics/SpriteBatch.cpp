@@ -1,52 +1,328 @@
 #include "SpriteBatch.h"
+#include "BatchGeometry.h"
+#include "Camera2D.h"
+#include "Private/BatchRecords.h"
+#include "Private/BatchShapes.h"
+#include "Private/BatchSorter.h"
+#include "Private/BatchTargetScope.h"
+#include <Engine/Graphics/RenderBackend.h>
+#include <Engine/Graphics/RenderStats.h>
 #include <Engine/Graphics/RenderTarget.h>
-#include <Engine/Graphics/Private/Conversions.h>
-#include <Engine/Graphics/Private/TranslateFlip.h>
 
 #include <Engine/Debug/Assert.h>
+#include <Engine/Exceptions/InvalidArgumentException.h>
 
 #include <Engine/Math/Matrix4x4.h>
 #include <Engine/Math/MathShape.h>
-#include <Engine/Math/Private/Conversions.h>
 
 #include <SDL_gpu.h>
-#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <utility>
 
 namespace SDG
 {
-    struct BatchCall
-    {
-        BatchCall(
-            const GPU_Image *texture, GPU_Rect src, GPU_Rect dest,
-            float rotation, Vector2 anchor, Flip flip,
-            SDL_Color color, float depth)
-            : texture{ texture }, src{ std::move(src) }, dest{ std::move(dest) }, rotation{ rotation },
-            anchor{ anchor }, flip{ flip }, color{ std::move(color) }, depth{ depth } { }
-
-        const GPU_Image *texture;
-        GPU_Rect   src;
-        GPU_Rect   dest;
-        float      rotation;
-        Vector2    anchor;
-        SDL_Color  color;
-        Flip       flip;
-        float      depth;
+    struct SpriteBatch::Recorder::Impl
+    {
+        explicit Impl(const Texture *pixel) : records{}, pixel{ pixel }, cullRect{}, culling{ false }, culled{ 0 } { }
+
+        /// Stores a draw, unless culling rejects it
+        void Record(const GPU_Image *texture, const FRectangle &src, const FRectangle &dest, float rotation,
+            const Vector2 &anchor, Flip flip, const Color &color, float depth)
+        {
+            if (culling && IsOutside(src, dest, rotation, anchor))
+            {
+                ++culled;
+                return;
+            }
+
+            records.Push(texture, src, dest, rotation, anchor, flip, color, depth);
+        }
+
+        /// Counts a shape as culled if its bounds miss the cull rectangle
+        /// @returns whether the shape was culled
+        bool CullShape(const FRectangle &bounds)
+        {
+            if (culling && IsOutside({}, bounds, 0, {}))
+            {
+                ++culled;
+                return true;
+            }
+
+            return false;
+        }
+
+        /// Checks whether a draw's bounds miss the cull rectangle entirely
+        [[nodiscard]] bool IsOutside(const FRectangle &src, const FRectangle &dest, float rotation,
+            const Vector2 &anchor) const
+        {
+            float left, top, right, bottom;
+            if (rotation == 0)
+            {
+                left = SDG_Min(dest.Left(), dest.Right());
+                right = SDG_Max(dest.Left(), dest.Right());
+                top = SDG_Min(dest.Top(), dest.Bottom());
+                bottom = SDG_Max(dest.Top(), dest.Bottom());
+            }
+            else
+            {
+                if (src.Width() == 0 || src.Height() == 0)
+                    return false;
+
+                // A rotated quad stays inside the circle about its pivot that reaches its farthest corner
+                float anchorX = anchor.X() * dest.Width() / src.Width();
+                float anchorY = anchor.Y() * dest.Height() / src.Height();
+                float reachX = SDG_Max(std::abs(anchorX), std::abs(dest.Width() - anchorX));
+                float reachY = SDG_Max(std::abs(anchorY), std::abs(dest.Height() - anchorY));
+                float radius = std::sqrt(reachX * reachX + reachY * reachY);
+
+                float pivotX = dest.X() + anchorX, pivotY = dest.Y() + anchorY;
+                left = pivotX - radius;
+                right = pivotX + radius;
+                top = pivotY - radius;
+                bottom = pivotY + radius;
+            }
+
+            return right < cullRect.Left() || left > cullRect.Right() ||
+                bottom < cullRect.Top() || top > cullRect.Bottom();
+        }
+
+        BatchRecords             records;
+        const Texture            *pixel;
+        FRectangle               cullRect;
+        bool                     culling;
+        size_t                   culled;
     };
 
     struct SpriteBatch::Impl
     {
-        Impl() : matrix{}, sortMode{ SortMode::FrontToBack }, target{}, batch{}, pixel{}, batching{ false } { }
-        std::vector<BatchCall>   batch;
+        Impl() : matrix{}, sortMode{ SortMode::FrontToBack }, submitMode{ SubmitMode::Blit }, target{}, pixel{},
+            recorder{ &pixel }, submitted{}, sorter{}, geometry{},
+            submittedCount{ 0 }, culledCount{ 0 }, batching{ false } { }
+
+        /// The batch being built: holds the SpriteBatch's own draws, then submitted Recorders' draws at End
+        BatchRecords &Batch() { return recorder.impl->records; }
+
+        Texture                  pixel;
+        Recorder                 recorder;
+        std::vector<Recorder *>  submitted;
+
+        BatchSorter              sorter;
+
+        BatchGeometry            geometry;
         SortMode                 sortMode;
+        SubmitMode               submitMode;
         GPU_Target               *target;
         const float              *matrix;
-        Texture                  pixel;
+
+        // Counts for the last batch
+        size_t                   submittedCount;
+        size_t                   culledCount;
         bool                     batching;
     };
 
-    // ===== BatchCall ============================================================================
+    // ===== SpriteBatch::Recorder ================================================================
+    SpriteBatch::Recorder::Recorder(const SpriteBatch &batch) : Recorder(&batch.impl->pixel)
+    {
+
+    }
 
+    SpriteBatch::Recorder::Recorder(const Texture *pixel) : impl(new Impl(pixel))
+    {
+
+    }
+
+    SpriteBatch::Recorder::~Recorder()
+    {
+        delete impl;
+    }
+
+    SpriteBatch::Recorder::Recorder(Recorder &&other) noexcept : impl(other.impl)
+    {
+        other.impl = nullptr;
+    }
+
+    SpriteBatch::Recorder &
+    SpriteBatch::Recorder::operator=(Recorder &&other) noexcept
+    {
+        std::swap(impl, other.impl);
+        return *this;
+    }
+
+    void
+    SpriteBatch::Recorder::DrawTexture(const Texture *texture, const Rectangle &src,
+        const FRectangle &dest, float rotation, const Vector2 &anchor, Flip flip, const Color &color, float depth)
+    {
+        SDG_Assert(texture); // please make sure to pass a non-null Texture
+        impl->Record(texture->Image(), (FRectangle)src, dest, rotation, anchor, flip, color, depth);
+    }
+
+    void
+    SpriteBatch::Recorder::DrawTexture(const Texture *texture, const Vector2 &position,
+        const Vector2 &scale, const Vector2 &normAnchor, float rotation, float depth, const Color &color)
+    {
+        SDG_Assert(texture != nullptr); // makes sure to pass a non-null Texture
+
+        float baseW = texture->Image()->base_w;
+        float baseH = texture->Image()->base_h;
+
+        impl->Record(texture->Image(),
+            FRectangle{0, 0, baseW, baseH},
+            FRectangle{position.X(), position.Y(), baseW * scale.X(), baseH * scale.Y()},
+            rotation,
+            Vector2{baseW * normAnchor.X(), baseH * normAnchor.Y()},
+            Flip::None, color, depth);
+    }
+
+    void
+    SpriteBatch::Recorder::DrawRectangle(const FRectangle &rect, const Vector2 &anchor, const Color &color, float rotation, float depth)
+    {
+        impl->Record(impl->pixel->Image(), FRectangle{ 0, 0, 1.f, 1.f }, rect,
+            rotation, anchor, Flip::None, color, depth);
+    }
+
+    void
+    SpriteBatch::Recorder::DrawLine(const Vector2 &a, const Vector2 &b, float thickness, const Color &color, float depth)
+    {
+        float distance = Math::PointDistance(a, b);
+        float angle = Math::PointDirection(a, b);
+
+        impl->Record(impl->pixel->Image(), FRectangle{ 0, 0, 1.f, 1.f },
+            FRectangle{ a.X(), a.Y() - thickness * 0.5f, distance, thickness },
+            angle, Vector2{ 0, 0.5f }, Flip::None, color, depth);
+    }
+
+    void
+    SpriteBatch::Recorder::DrawLine(const Vector2 &position, float length, float angle, float thickness, const Color &color, float depth)
+    {
+        impl->Record(impl->pixel->Image(), FRectangle{ 0, 0, 1.f, 1.f },
+            FRectangle{ position.X(), position.Y() - thickness * 0.5f, length, thickness },
+            angle, Vector2{ 0, 0.5f }, Flip::None, color, depth);
+    }
+
+    void
+    SpriteBatch::Recorder::DrawLines(const std::vector<Vector2> &points, float thickness, const Color &color, float depth)
+    {
+        DrawLines(points.data(), points.size(), thickness, color, depth);
+    }
+
+    void
+    SpriteBatch::Recorder::DrawLines(const Vector2 *points, size_t count, float thickness, const Color &color,
+        float depth, bool closed)
+    {
+        if (count < 2)
+            return;
+
+        if (count > BatchShapes::MaxPolylinePoints)
+        {
+            if (closed)
+                throw InvalidArgumentException("SpriteBatch::DrawLines", "count",
+                    "closed lines may have up to " + std::to_string(BatchShapes::MaxPolylinePoints) + " points");
+
+            // Split into pieces that share their end points
+            const size_t stride = BatchShapes::MaxPolylinePoints - 1;
+            for (size_t first = 0; first + 1 < count; first += stride)
+                DrawLines(points + first, SDG_Min(count - first, stride + 1), thickness, color, depth);
+            return;
+        }
+
+        FRectangle bounds = BatchShapes::PolylineBounds(points, count, thickness);
+        if (impl->CullShape(bounds))
+            return;
+
+        BatchShapes::Polyline(impl->records, impl->pixel->Image(), points, count, thickness, closed, color, depth,
+            bounds);
+    }
+
+    void
+    SpriteBatch::Recorder::DrawCircle(const Circle &circle, const Color &color, float depth, int segments)
+    {
+        float radius = std::abs(circle.Radius());
+        if (impl->CullShape({ circle.X() - radius, circle.Y() - radius, radius * 2.f, radius * 2.f }))
+            return;
+
+        BatchShapes::Circle(impl->records, impl->pixel->Image(), circle,
+            segments > 0 ? segments : BatchShapes::CircleSegments(radius), color, depth);
+    }
+
+    void
+    SpriteBatch::Recorder::DrawCircleOutline(const Circle &circle, float thickness, const Color &color, float depth,
+        int segments)
+    {
+        float outer = std::abs(circle.Radius()) + std::abs(thickness) * .5f;
+        if (impl->CullShape({ circle.X() - outer, circle.Y() - outer, outer * 2.f, outer * 2.f }))
+            return;
+
+        BatchShapes::CircleOutline(impl->records, impl->pixel->Image(), circle,
+            segments > 0 ? segments : BatchShapes::CircleSegments(outer), thickness, color, depth);
+    }
+
+    void
+    SpriteBatch::Recorder::DrawPolygon(const Vector2 *points, size_t count, const Color &color, float depth)
+    {
+        if (count < 3)
+            return;
+        if (count > BatchShapes::MaxPolygonPoints)
+            throw InvalidArgumentException("SpriteBatch::DrawPolygon", "count",
+                "polygons may have up to " + std::to_string(BatchShapes::MaxPolygonPoints) + " points");
+
+        FRectangle bounds = BatchShapes::Bounds(points, count, 0);
+        if (impl->CullShape(bounds))
+            return;
+
+        BatchShapes::ConvexPolygon(impl->records, impl->pixel->Image(), points, count, color, depth, bounds);
+    }
+
+    void
+    SpriteBatch::Recorder::DrawPolygonOutline(const Vector2 *points, size_t count, float thickness,
+        const Color &color, float depth)
+    {
+        DrawLines(points, count, thickness, color, depth, true);
+    }
+
+    void
+    SpriteBatch::Recorder::CullRect(const FRectangle &rect)
+    {
+        impl->cullRect = rect;
+        impl->culling = true;
+    }
+
+    void
+    SpriteBatch::Recorder::ClearCullRect()
+    {
+        impl->culling = false;
+    }
+
+    void
+    SpriteBatch::Recorder::Clear()
+    {
+        impl->records.Clear();
+        impl->culled = 0;
+    }
+
+    void
+    SpriteBatch::Recorder::Reserve(size_t drawCount)
+    {
+        impl->records.Reserve(drawCount);
+    }
+
+    size_t
+    SpriteBatch::Recorder::Size() const
+    {
+        return impl->records.Size();
+    }
+
+    const BatchRecords &
+    SpriteBatch::Recorder::Records() const
+    {
+        return impl->records;
+    }
+
+    size_t
+    SpriteBatch::Recorder::CulledCount() const
+    {
+        return impl->culled;
+    }
 
     // ===== SpriteBatch ==========================================================================
     SpriteBatch::SpriteBatch() : impl(new Impl)
@@ -70,159 +346,297 @@ namespace SDG
         return didLoad;
     }
 
-    // Uses direct calls to SDL GPU for speed instead of going through RenderTarget abstraction
+    // Calls the RenderBackend directly for speed instead of going through RenderTarget abstraction
     void
     SpriteBatch::RenderBatches()
     {
-        // Get the last graphics state
-        GPU_Target *lastTarget = GPU_GetActiveTarget();
-        float *lastMatrix = GPU_GetCurrentMatrix();
+        BatchTargetScope scope(impl->target, impl->matrix);
 
+        if (impl->submitMode == SubmitMode::Geometry)
+            RenderGeometry();
+        else
+            RenderBlits();
+    }
+
+    void
+    SpriteBatch::RenderBlits()
+    {
+        RenderBackend &backend = RenderBackend::Current();
         GPU_Target *target = impl->target;
-        const float *matrix = impl->matrix;
+        BatchGeometry &geometry = impl->geometry;
+        const BatchRecords &batch = impl->Batch();
+        const size_t size = batch.Size();
+        size_t drawCalls = 0, vertices = 0, textureChanges = 0;
+        for (size_t i = 0; i < size; )
+        {
+            if (i > 0 && batch.textures[i] != batch.textures[i - 1])
+                ++textureChanges;
 
-        // Set the graphics state
-        if (target != lastTarget)
-            GPU_SetActiveTarget(target);
-        if (matrix != lastMatrix)
-            GPU_LoadMatrix(matrix);
+            if (batch.shapes[i] != BatchRecords::NoShape)
+            {
+                // Shapes cannot be blitted, so each run of them goes out as one triangle batch
+                geometry.Clear();
+                size_t next = geometry.PushShapeRun(batch, i);
+
+                backend.UnsetTargetColor(target);
+                backend.TriangleBatch(batch.textures[i], target, geometry.Vertices(), geometry.VertexCount(),
+                    geometry.Indices(), geometry.IndexCount());
+
+                ++drawCalls;
+                vertices += geometry.VertexCount();
+                i = next;
+                continue;
+            }
+
+            const BatchTransform &transform = batch.transforms[i];
 
-        // Blit images
-        for (BatchCall &b : impl->batch)
-        {
-            
             // Blit to the current target
-            GPU_SetTargetColor(target, std::move(b.color));
-            GPU_BlitRectX((GPU_Image *)b.texture, &b.src, target, &b.dest, b.rotation, b.anchor.X(), b.anchor.Y(),
-                          TranslateFlip[(int)b.flip]);
+            backend.TargetColor(target, batch.colors[i]);
+            backend.Blit(batch.textures[i], batch.srcs[i], target, batch.dests[i], transform.rotation,
+                transform.anchor, transform.flip);
+
+            ++drawCalls;
+            vertices += 4;
+            ++i;
         }
 
-        // Restore the last graphics state, if mutated
-        if (lastTarget != target)
-            GPU_SetActiveTarget(lastTarget);
-        if (lastMatrix != matrix)
-            GPU_LoadMatrix(lastMatrix);
+        RenderStats &stats = RenderStats::Frame();
+        stats.drawCalls += drawCalls;
+        stats.vertices += vertices;
+        stats.colorChanges += drawCalls;
+        stats.textureChanges += textureChanges;
     }
 
     void
-    SpriteBatch::SortBatches()
+    SpriteBatch::RenderGeometry()
     {
-        switch (impl->sortMode)
+        RenderBackend &backend = RenderBackend::Current();
+        GPU_Target *target = impl->target;
+        BatchGeometry &geometry = impl->geometry;
+        const BatchRecords &batch = impl->Batch();
+        const size_t size = batch.Size();
+
+        // Vertex colors carry the tint, so the target color must not modulate them
+        backend.UnsetTargetColor(target);
+
+        RenderStats &stats = RenderStats::Frame();
+        ++stats.colorChanges;
+
+        const GPU_Image *lastTexture = nullptr;
+        for (size_t i = 0; i < size; )
         {
-        case SortMode::None:
-            break;
-        case SortMode::Texture:
-            std::stable_sort(impl->batch.begin(), impl->batch.end(),
-                                [](const BatchCall &b1, const BatchCall &b2)
-                                {
-                                    return b1.texture < b2.texture;
-                                });
-            break;
-        case SortMode::FrontToBack:
-            std::stable_sort(impl->batch.begin(), impl->batch.end(),
-                                [](const BatchCall &b1, const BatchCall &b2)
-                                {
-                                    return b1.depth < b2.depth;
-                                });
-            break;
-        case SortMode::BackToFront:
-            std::stable_sort(impl->batch.begin(), impl->batch.end(),
-                                [](const BatchCall &b1, const BatchCall &b2)
-                                {
-                                    return b1.depth > b2.depth;
-                                });
-            break;
+            // Gather the run of quads sharing this texture
+            const GPU_Image *texture = batch.textures[i];
+            geometry.Clear();
+            i = geometry.PushTextureRun(batch, i);
+
+            backend.TriangleBatch(texture, target, geometry.Vertices(), geometry.VertexCount(),
+                geometry.Indices(), geometry.IndexCount());
+
+            if (lastTexture)
+            {
+                ++stats.batchBreaks;
+                if (texture != lastTexture)
+                    ++stats.textureChanges;
+            }
+            lastTexture = texture;
+            ++stats.drawCalls;
+            stats.vertices += geometry.VertexCount();
         }
     }
 
+    void
+    SpriteBatch::SortBatches()
+    {
+        impl->sorter.Sort(impl->Batch(), impl->sortMode);
+    }
+
     void
     SpriteBatch::DrawTexture(const Texture *texture, const Rectangle &src,
         const FRectangle &dest, float rotation, const Vector2 &anchor, Flip flip, const Color &color, float depth)
     {
-        SDG_Assert(texture); // please make sure to pass a non-null Texture
-        impl->batch.emplace_back((GPU_Image *)texture->Image(), 
-            GPU_Rect{ (float)src.X(), (float)src.Y(), (float)src.Width(), (float)src.Height() }, 
-            GPU_Rect{ dest.X(), dest.Y(), dest.Width(), dest.Height() }, rotation, anchor,
-            flip, SDL_Color{ color.R(), color.G(), color.B(), color.A() }, depth);
+        impl->recorder.DrawTexture(texture, src, dest, rotation, anchor, flip, color, depth);
     }
 
     void
     SpriteBatch::DrawTexture(const Texture *texture, const Vector2 &position,
         const Vector2 &scale, const Vector2 &normAnchor, float rotation, float depth, const Color &color)
     {
-        SDG_Assert(texture != nullptr); // makes sure to pass a non-null Texture
-
-        float baseW = texture->Image()->base_w;
-        float baseH = texture->Image()->base_h;
-
-        impl->batch.emplace_back((GPU_Image *)texture->Image(),
-            GPU_Rect{0, 0, baseW, baseH},
-            GPU_Rect{position.X(), position.Y(), baseW * scale.X(), baseH * scale.Y()},
-            rotation,
-            Vector2{baseW * normAnchor.X(), baseH * normAnchor.Y()},
-            Flip::None, SDL_Color{color.R(), color.G(), color.B(), color.A()}, depth);
+        impl->recorder.DrawTexture(texture, position, scale, normAnchor, rotation, depth, color);
     }
 
     void 
     SpriteBatch::DrawRectangle(const FRectangle &rect, const Vector2 &anchor, const Color &color, float rotation, float depth)
     {
-        impl->batch.emplace_back((GPU_Image *)impl->pixel.Image(),
-            GPU_Rect{ 0, 0, 1.f, 1.f }, 
-            GPU_Rect{ rect.X(), rect.Y(), rect.Width(), rect.Height() }, 
-            rotation, anchor, Flip::None,
-            SDL_Color{ color.R(), color.G(), color.B(), color.A() }, depth);
+        impl->recorder.DrawRectangle(rect, anchor, color, rotation, depth);
     }
 
     void SpriteBatch::DrawLine(const Vector2 &a, const Vector2 &b, float thickness, const Color &color, float depth)
     {
-        float distance = Math::PointDistance(a, b);
-        float angle = Math::PointDirection(a, b);
-
-        impl->batch.emplace_back(
-            (GPU_Image *)impl->pixel.Image(), 
-            GPU_Rect{ 0, 0, 1.f, 1.f }, 
-            GPU_Rect{ a.X(), a.Y() - thickness * 0.5f, distance, thickness },
-            angle, Vector2{ 0, 0.5f }, Flip::None, 
-            SDL_Color{ color.R(), color.G(), color.B(), color.A() }, depth);
+        impl->recorder.DrawLine(a, b, thickness, color, depth);
     }
 
     void SpriteBatch::DrawLine(const Vector2 &position, float length, float angle, float thickness, const Color &color, float depth)
     {
-        impl->batch.emplace_back((GPU_Image *)impl->pixel.Image(), 
-            GPU_Rect{ 0, 0, 1.f, 1.f },
-            GPU_Rect{ position.X(), position.Y() - thickness * 0.5f, length, thickness },
-            angle, Vector2{ 0, 0.5f }, Flip::None, SDL_Color{ color.R(), color.G(), color.B(), color.A() }, depth);
+        impl->recorder.DrawLine(position, length, angle, thickness, color, depth);
     }
 
     void SpriteBatch::DrawLines(const std::vector<Vector2> &points, float thickness, const Color &color, float depth)
     {
-        for (size_t i = 0; i < points.size() - 1; ++i)
-            DrawLine(points[i], points[i + 1], thickness, color, depth);
+        impl->recorder.DrawLines(points, thickness, color, depth);
+    }
+
+    void SpriteBatch::DrawLines(const Vector2 *points, size_t count, float thickness, const Color &color, float depth,
+        bool closed)
+    {
+        impl->recorder.DrawLines(points, count, thickness, color, depth, closed);
+    }
+
+    void SpriteBatch::DrawCircle(const Circle &circle, const Color &color, float depth, int segments)
+    {
+        impl->recorder.DrawCircle(circle, color, depth, segments);
+    }
+
+    void SpriteBatch::DrawCircleOutline(const Circle &circle, float thickness, const Color &color, float depth,
+        int segments)
+    {
+        impl->recorder.DrawCircleOutline(circle, thickness, color, depth, segments);
+    }
+
+    void SpriteBatch::DrawPolygon(const Vector2 *points, size_t count, const Color &color, float depth)
+    {
+        impl->recorder.DrawPolygon(points, count, color, depth);
+    }
+
+    void SpriteBatch::DrawPolygonOutline(const Vector2 *points, size_t count, float thickness, const Color &color,
+        float depth)
+    {
+        impl->recorder.DrawPolygonOutline(points, count, thickness, color, depth);
     }
 
     void
-    SpriteBatch::Begin(Ref<RenderTarget> target, Ref<const Matrix4x4> transformMatrix, SortMode sortMode)
+    SpriteBatch::Begin(Ref<RenderTarget> target, Ref<const Matrix4x4> transformMatrix, SortMode sortMode,
+        SubmitMode submitMode)
     {
         if (impl->batching)
             throw RuntimeException("SpriteBatch::Begin called while batching. Did you forget a matching call to SpriteBatch::End()?");
 
         impl->batching = true;
         impl->sortMode = sortMode;
-        impl->target = target ? target->Target().Get() : GPU_GetActiveTarget();
-        impl->batch.clear();
+        impl->submitMode = submitMode;
+        impl->target = target ? target->Target().Get() : RenderBackend::Current().ActiveTarget();
+        impl->recorder.Clear();
+        impl->recorder.ClearCullRect();
+        impl->submitted.clear();
+        impl->submittedCount = 0;
+        impl->culledCount = 0;
 
         static Matrix4x4 identityMat = Matrix4x4::Identity();
         impl->matrix = (transformMatrix.Get()) ? transformMatrix->Data() : identityMat.Data();
     }
 
+    void
+    SpriteBatch::Begin(Ref<RenderTarget> target, const Camera2D &camera, SortMode sortMode, SubmitMode submitMode)
+    {
+        Begin(target, camera.Matrix(), sortMode, submitMode);
+
+        const Point &viewport = camera.ViewportSize();
+        if (viewport.X() > 0 && viewport.Y() > 0)
+            CullRect(camera.WorldBounds());
+    }
+
+    void
+    SpriteBatch::CullRect(const FRectangle &rect)
+    {
+        impl->recorder.CullRect(rect);
+    }
+
+    void
+    SpriteBatch::ClearCullRect()
+    {
+        impl->recorder.ClearCullRect();
+    }
+
+    const FRectangle *
+    SpriteBatch::CullRect() const
+    {
+        const Recorder::Impl *recorder = impl->recorder.impl;
+        return recorder->culling ? &recorder->cullRect : nullptr;
+    }
+
+    void
+    SpriteBatch::Submit(Recorder &recorder)
+    {
+        if (!impl->batching)
+            throw RuntimeException("SpriteBatch::Submit called while not batching. Recorders must be submitted between SpriteBatch::Begin() and SpriteBatch::End()");
+
+        impl->submitted.emplace_back(&recorder);
+    }
+
+    void
+    SpriteBatch::MergeRecorders()
+    {
+        BatchRecords &batch = impl->Batch();
+        size_t culled = impl->recorder.CulledCount();
+        for (Recorder *recorder : impl->submitted)
+        {
+            batch.Append(recorder->Records());
+            culled += recorder->CulledCount();
+            recorder->Clear();
+        }
+
+        impl->submitted.clear();
+        impl->submittedCount = batch.Size();
+        impl->culledCount = culled;
+    }
+
     void
     SpriteBatch::End()
     {
+        using Clock = std::chrono::steady_clock;
+        MergeRecorders();
+
+        auto start = Clock::now();
         SortBatches();
+        auto sorted = Clock::now();
         RenderBatches();
+        auto submitted = Clock::now();
+
+        RenderStats &stats = RenderStats::Frame();
+        stats.sprites += impl->submittedCount;
+        stats.culled += impl->culledCount;
+        stats.sortSeconds += std::chrono::duration<double>(sorted - start).count();
+        stats.submitSeconds += std::chrono::duration<double>(submitted - sorted).count();
+
         impl->batching = false;
     }
 
+    void
+    SpriteBatch::Reserve(size_t drawCount)
+    {
+        impl->Batch().Reserve(drawCount);
+        impl->sorter.Reserve(drawCount);
+        impl->geometry.Reserve(SDG_Min(drawCount, BatchGeometry::MaxQuads));
+    }
+
+    size_t
+    SpriteBatch::Capacity() const
+    {
+        return impl->recorder.impl->records.Capacity();
+    }
+
+    size_t
+    SpriteBatch::SubmittedCount() const
+    {
+        return impl->submittedCount;
+    }
+
+    size_t
+    SpriteBatch::CulledCount() const
+    {
+        return impl->culledCount;
+    }
+
 
 }
 
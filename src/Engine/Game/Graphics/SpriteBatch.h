@@ -15,6 +15,7 @@
 #include <Engine/Lib/ClassMacros.h>
 #include <Engine/Lib/Ref.h>
 #include <Engine/Lib/Unique.h>
+#include <Engine/Math/Circle.h>
 #include <Engine/Math/Rectangle.h>
 
 #include <vector>
@@ -26,7 +27,8 @@ namespace SDG
     {
         /// No sorting. Depth results from the order of calls to SpriteBatch rendering
         None,
-        /// Sort by texture ptr
+        /// Uses depth parameter to sort like FrontToBack, then groups draws of equal depth by texture
+        /// to reduce texture switches.
         Texture,
         /// Uses depth parameter to sort. Lower depth values in front; higher in back.
         FrontToBack,
@@ -34,11 +36,89 @@ namespace SDG
         BackToFront
     };
 
+    /// SpriteBatch submission method
+    enum class SubmitMode
+    {
+        /// One blit call and target color change per draw
+        Blit,
+        /// Builds vertex data on the CPU, and submits each run of same-texture draws in one triangle batch call.
+        /// Texture snap modes are not applied in this mode.
+        Geometry
+    };
+
+    struct BatchRecords;
+
     class SpriteBatch
     {
         struct Impl;
         SDG_NOCOPY(SpriteBatch);
     public:
+        /// Records draws apart from the SpriteBatch, so they can be made from worker threads.
+        /// Each Recorder may only be used by one thread at a time, but any number of Recorders can record
+        /// in parallel. Once a Recorder's thread is done drawing, pass it to SpriteBatch::Submit on the
+        /// rendering thread; End merges submitted Recorders in the order they were submitted, then sorts and
+        /// renders them together with the SpriteBatch's own draws.
+        /// Recorders keep their memory between frames, so keep one per worker rather than per frame.
+        class Recorder
+        {
+            struct Impl;
+            SDG_NOCOPY(Recorder);
+        public:
+            /// @param batch - SpriteBatch whose pixel texture is used for rectangles and lines
+            explicit Recorder(const SpriteBatch &batch);
+            ~Recorder();
+
+            Recorder(Recorder &&other) noexcept;
+            Recorder &operator=(Recorder &&other) noexcept;
+
+            void DrawTexture(const Texture *texture, const Rectangle &src, const FRectangle &dest, float rotation, const Vector2 &anchor, Flip flip, const Color &color, float depth);
+            void DrawTexture(const Texture *texture, const Vector2 &position, const Vector2 &scale = Vector2{ 1.f, 1.f },
+                const Vector2 &normAnchor = Vector2{.5f, .5f}, float rotation = 0, float depth = 0, const Color &color = Color::White());
+            void DrawRectangle(const FRectangle &rect, const Vector2 &anchor, const Color &color, float rotation = 0, float depth = 0);
+            void DrawLine(const Vector2 &a, const Vector2 &b, float thickness, const Color &color, float depth);
+            void DrawLine(const Vector2 &base, float length, float angle, float thickness, const Color &color, float depth);
+            /// Draws connected line segments with mitered joins, as one shape
+            void DrawLines(const std::vector<Vector2> &points, float thickness, const Color &color, float depth);
+            /// Draws connected line segments with mitered joins, as one shape
+            /// @param closed - also connects the last point back to the first
+            void DrawLines(const Vector2 *points, size_t count, float thickness, const Color &color, float depth, bool closed = false);
+            /// Draws a filled circle
+            /// @param segments - number of edges, or 0 to fit the radius
+            void DrawCircle(const Circle &circle, const Color &color, float depth = 0, int segments = 0);
+            /// Draws a circle outline, centered on the circle's edge
+            /// @param segments - number of edges, or 0 to fit the radius
+            void DrawCircleOutline(const Circle &circle, float thickness, const Color &color, float depth = 0, int segments = 0);
+            /// Draws a filled convex polygon. Concave polygons are not filled correctly.
+            void DrawPolygon(const Vector2 *points, size_t count, const Color &color, float depth = 0);
+            /// Draws a polygon outline with mitered joins
+            void DrawPolygonOutline(const Vector2 *points, size_t count, float thickness, const Color &color, float depth = 0);
+
+            /// Rejects further draws whose bounds fall entirely outside of a rectangle, in the same space as
+            /// draw destinations. Pass SpriteBatch::CullRect() to match the batch's culling.
+            void CullRect(const FRectangle &rect);
+            /// Stops culling draws
+            void ClearCullRect();
+
+            /// Removes all recorded draws and resets the culled count. Called automatically by
+            /// SpriteBatch::End for submitted Recorders.
+            void Clear();
+
+            /// Reserves memory for a number of draws
+            void Reserve(size_t drawCount);
+
+            /// Number of draws recorded
+            [[nodiscard]] size_t Size() const;
+            /// Number of draws rejected by the cull rectangle since the last Clear
+            [[nodiscard]] size_t CulledCount() const;
+        private:
+            Recorder(const Texture *pixel);
+            /// Recorded draws, for merging into batches
+            [[nodiscard]] const BatchRecords &Records() const;
+            friend class SpriteBatch;
+            friend class StaticBatch;
+            Impl *impl;
+        };
+
         SpriteBatch();
         ~SpriteBatch();
 
@@ -48,11 +128,37 @@ namespace SDG
         /// @param target - target to blit textures to. If not provided, the last Window or RenderTarget set as active target will be used.
         /// @param transformMatrix - matrix by which to transform each image. This object should be alive at least until after End is called. (optional)
         /// @param sortMode - method by which to sort the render order of the batch. (optional: default is front to back)
+        /// @param submitMode - method by which draws are sent to the graphics library. (optional: default is blit)
         void Begin(Ref<class RenderTarget> target = nullptr,
             Ref<const class Matrix4x4> transformMatrix = nullptr,
-            SortMode sortMode = SortMode::FrontToBack);
+            SortMode sortMode = SortMode::FrontToBack,
+            SubmitMode submitMode = SubmitMode::Blit);
+
+        /// Starts a render batch viewed through a camera. Draws outside of the camera's view are culled.
+        /// Must be paired with a call to End
+        /// @param target - target to blit textures to. If not provided, the last Window or RenderTarget set as active target will be used.
+        /// @param camera - camera whose matrix transforms each image, and whose WorldBounds are used to cull
+        ///                 draws. Culling is skipped if the camera has no viewport size.
+        /// @param sortMode - method by which to sort the render order of the batch. (optional: default is front to back)
+        /// @param submitMode - method by which draws are sent to the graphics library. (optional: default is blit)
+        void Begin(Ref<class RenderTarget> target, const class Camera2D &camera,
+            SortMode sortMode = SortMode::FrontToBack,
+            SubmitMode submitMode = SubmitMode::Blit);
+
+        /// Rejects further draws in this batch whose bounds fall entirely outside of a rectangle, in the same
+        /// space as draw destinations. Rotated draws are tested conservatively. Reset by Begin.
+        void CullRect(const FRectangle &rect);
+        /// Stops culling draws in this batch
+        void ClearCullRect();
+        /// Current cull rectangle, or null if draws are not being culled
+        [[nodiscard]] const FRectangle *CullRect() const;
 
-        /// Sorts and renders batch
+        /// Queues a Recorder's draws to be merged into this batch at End. Recording into it must have
+        /// finished before this call, and it must stay alive until End, which clears it.
+        /// Must be called from the rendering thread while batching.
+        void Submit(Recorder &recorder);
+
+        /// Merges submitted Recorders, then sorts and renders batch
         void End();
         void DrawTexture(const Texture *texture, const Rectangle &src, const FRectangle &dest, float rotation, const Vector2 &anchor, Flip flip, const Color &color, float depth);
 
@@ -62,9 +168,39 @@ namespace SDG
         void DrawRectangle(const FRectangle &rect, const Vector2 &anchor, const Color &color, float rotation = 0, float depth = 0);
         void DrawLine(const Vector2 &a, const Vector2 &b, float thickness, const Color &color, float depth);
         void DrawLine(const Vector2 &base, float length, float angle, float thickness, const Color &color, float depth);
+        /// Draws connected line segments with mitered joins, as one shape
         void DrawLines(const std::vector<Vector2> &points, float thickness, const Color &color, float depth);
+        /// Draws connected line segments with mitered joins, as one shape
+        /// @param closed - also connects the last point back to the first
+        void DrawLines(const Vector2 *points, size_t count, float thickness, const Color &color, float depth, bool closed = false);
+        /// Draws a filled circle
+        /// @param segments - number of edges, or 0 to fit the radius
+        void DrawCircle(const Circle &circle, const Color &color, float depth = 0, int segments = 0);
+        /// Draws a circle outline, centered on the circle's edge
+        /// @param segments - number of edges, or 0 to fit the radius
+        void DrawCircleOutline(const Circle &circle, float thickness, const Color &color, float depth = 0, int segments = 0);
+        /// Draws a filled convex polygon. Concave polygons are not filled correctly.
+        void DrawPolygon(const Vector2 *points, size_t count, const Color &color, float depth = 0);
+        /// Draws a polygon outline with mitered joins
+        void DrawPolygonOutline(const Vector2 *points, size_t count, float thickness, const Color &color, float depth = 0);
+
+        /// Reserves memory for a number of draws per batch. Memory is kept between batches, so frames
+        /// drawing no more than the highest count so far do not allocate. Calling this up front avoids the
+        /// growth allocations during the first frames.
+        void Reserve(size_t drawCount);
+
+        /// Number of draws a batch can hold before it needs to allocate
+        [[nodiscard]] size_t Capacity() const;
+
+        /// Number of draws sent to the graphics library by the last End
+        [[nodiscard]] size_t SubmittedCount() const;
+        /// Number of draws rejected by culling in the last batch, including those of submitted Recorders
+        [[nodiscard]] size_t CulledCount() const;
     private:    
+        void MergeRecorders();
         void RenderBatches();
+        void RenderBlits();
+        void RenderGeometry();
         void SortBatches();
         
         Impl *impl;
@@ -20,6 +20,17 @@ void SDG::SpriteRenderer::Render(Ref<class SpriteBatch> spriteBatch) const
         (Vector2)frame.Anchor(), flip, tint, depth);
 }
 
+void SDG::SpriteRenderer::Render(SpriteBatch::Recorder &recorder) const
+{
+    const Frame &frame = sprite->At((unsigned)index);
+    Vector2 position = this->position + (Vector2)frame.OffsetPos(true);
+
+    FRectangle dest(position, (Vector2)frame.FrameRect().Size());
+
+    recorder.DrawTexture(frame.Texture(), (Rectangle)frame.FrameRect(), dest, frame.Angle() + angle,
+        (Vector2)frame.Anchor(), flip, tint, depth);
+}
+
 void SDG::SpriteRenderer::Update(float deltaSeconds)
 {
     if (!paused)
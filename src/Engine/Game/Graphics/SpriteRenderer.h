@@ -1,4 +1,5 @@
 #pragma once
+#include "SpriteBatch.h"
 #include <Engine/Graphics/Color.h>
 #include <Engine/Graphics/Flip.h>
 
@@ -16,6 +17,8 @@ namespace SDG
         // Driver
 
         void Render(Ref<class SpriteBatch> spriteBatch) const;
+        /// Records the sprite for a SpriteBatch, safe to call from a worker thread that owns the recorder
+        void Render(SpriteBatch::Recorder &recorder) const;
         void Update(float deltaSeconds);
 
         // Getters / Setters
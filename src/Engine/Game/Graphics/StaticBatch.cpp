@@ -0,0 +1,125 @@
+#include "StaticBatch.h"
+#include "BatchGeometry.h"
+#include "Private/BatchRecords.h"
+#include "Private/BatchSorter.h"
+#include "Private/BatchTargetScope.h"
+
+#include <Engine/Graphics/RenderBackend.h>
+#include <Engine/Graphics/RenderStats.h>
+#include <Engine/Graphics/RenderTarget.h>
+#include <Engine/Math/Matrix4x4.h>
+
+#include <chrono>
+#include <vector>
+
+namespace SDG
+{
+    struct StaticBatch::Impl
+    {
+        /// Baked quads and shapes sharing one texture, submitted with one triangle batch
+        struct Segment
+        {
+            const GPU_Image *texture;
+            BatchGeometry    geometry;
+        };
+
+        Impl() : segments{}, drawCount{ 0 } { }
+
+        std::vector<Segment> segments;
+        size_t               drawCount;
+    };
+
+    StaticBatch::StaticBatch() : impl(new Impl)
+    {
+
+    }
+
+    StaticBatch::~StaticBatch()
+    {
+        delete impl;
+    }
+
+    void
+    StaticBatch::Build(const SpriteBatch::Recorder &recorder, SortMode sortMode)
+    {
+        Clear();
+
+        // Sort a copy, leaving the recorder as it was
+        BatchRecords records;
+        records.Append(recorder.Records());
+
+        BatchSorter sorter;
+        sorter.Sort(records, sortMode);
+
+        for (size_t i = 0, size = records.Size(); i < size; )
+        {
+            Impl::Segment &segment = impl->segments.emplace_back(Impl::Segment{ records.textures[i], {} });
+            size_t next = segment.geometry.PushTextureRun(records, i);
+            impl->drawCount += next - i;
+            i = next;
+        }
+    }
+
+    void
+    StaticBatch::Draw(Ref<RenderTarget> target, Ref<const Matrix4x4> transformMatrix) const
+    {
+        if (impl->segments.empty())
+            return;
+
+        RenderBackend &backend = RenderBackend::Current();
+        GPU_Target *gpuTarget = target ? target->Target().Get() : backend.ActiveTarget();
+
+        static Matrix4x4 identityMat = Matrix4x4::Identity();
+        BatchTargetScope scope(gpuTarget, transformMatrix ? transformMatrix->Data() : identityMat.Data());
+
+        using Clock = std::chrono::steady_clock;
+        auto start = Clock::now();
+
+        // Vertex colors carry the tint, so the target color must not modulate them
+        backend.UnsetTargetColor(gpuTarget);
+
+        RenderStats &stats = RenderStats::Frame();
+        const GPU_Image *lastTexture = nullptr;
+        for (const Impl::Segment &segment : impl->segments)
+        {
+            const BatchGeometry &geometry = segment.geometry;
+            backend.TriangleBatch(segment.texture, gpuTarget, geometry.Vertices(), geometry.VertexCount(),
+                geometry.Indices(), geometry.IndexCount());
+
+            if (lastTexture && segment.texture != lastTexture)
+                ++stats.textureChanges;
+            lastTexture = segment.texture;
+            stats.vertices += geometry.VertexCount();
+        }
+
+        ++stats.colorChanges;
+        stats.drawCalls += impl->segments.size();
+        stats.sprites += impl->drawCount;
+        stats.submitSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    void
+    StaticBatch::Clear()
+    {
+        impl->segments = {};
+        impl->drawCount = 0;
+    }
+
+    bool
+    StaticBatch::Empty() const
+    {
+        return impl->segments.empty();
+    }
+
+    size_t
+    StaticBatch::DrawCount() const
+    {
+        return impl->drawCount;
+    }
+
+    size_t
+    StaticBatch::DrawCallCount() const
+    {
+        return impl->segments.size();
+    }
+}
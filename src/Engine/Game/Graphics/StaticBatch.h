@@ -0,0 +1,50 @@
+/* ====================================================================================================================
+ * @file StaticBatch.h
+ * @class SDG::StaticBatch
+ * Retained sprite batch: captures a set of draws once, sorted and baked into vertex data, then replays them with
+ * one call per frame. Suited to backgrounds and level decoration that rarely change.
+ *
+ * Draws are recorded with the usual SpriteBatch draw API through a SpriteBatch::Recorder, then passed to Build.
+ * Rebuild only when the contents change; moving the view only needs a different matrix on Draw.
+ * Textures referenced by the batch must stay alive until it is rebuilt, cleared or destroyed.
+ * ==================================================================================================================*/
+#pragma once
+#include "SpriteBatch.h"
+
+#include <Engine/Lib/ClassMacros.h>
+#include <Engine/Lib/Ref.h>
+
+namespace SDG
+{
+    class StaticBatch
+    {
+        struct Impl;
+        SDG_NOCOPY(StaticBatch);
+    public:
+        StaticBatch();
+        ~StaticBatch();
+
+        /// Replaces the contents of the batch with the draws held by a Recorder, sorting them once and baking
+        /// their vertices. The Recorder is not modified, so it can be cleared or kept to rebuild from.
+        /// @param recorder - draws to capture. A cull rectangle set on it applies while recording, as usual.
+        /// @param sortMode - order to bake draws in. (optional: default is front to back)
+        void Build(const SpriteBatch::Recorder &recorder, SortMode sortMode = SortMode::FrontToBack);
+
+        /// Renders the captured draws immediately, with one triangle batch per run of same-texture draws.
+        /// Draw it between SpriteBatch batches, not during one, to keep layering predictable.
+        /// @param target - target to render to. If not provided, the last Window or RenderTarget set as active target will be used.
+        /// @param transformMatrix - matrix by which to transform the batch, e.g. Camera2D::Matrix(). (optional)
+        void Draw(Ref<class RenderTarget> target = nullptr, Ref<const class Matrix4x4> transformMatrix = nullptr) const;
+
+        /// Removes all captured draws and frees their memory
+        void Clear();
+
+        [[nodiscard]] bool Empty() const;
+        /// Number of draws captured, counting each shape as one
+        [[nodiscard]] size_t DrawCount() const;
+        /// Number of draw calls made by each call to Draw
+        [[nodiscard]] size_t DrawCallCount() const;
+    private:
+        Impl *impl;
+    };
+}
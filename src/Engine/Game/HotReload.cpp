@@ -0,0 +1,248 @@
+#include "HotReload.h"
+#include "AssetMgr.h"
+#include <Engine/Debug/Log.h>
+#include <Engine/Filesys/FileWatcher.h>
+#include <Engine/Filesys/Json/JsonLoadable.h>
+#include <Engine/Graphics/Shader.h>
+#include <Engine/Platform.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if (SDG_TARGET_LINUX || SDG_TARGET_MAC)
+#include <cerrno>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char **environ;
+#endif
+
+namespace SDG
+{
+    /// Runs a program to completion without a shell, so no argument is interpreted
+    /// @return the program's exit status, or -1 if it could not be run or did not exit normally
+    static int
+    RunProcess(const std::vector<String> &args)
+    {
+#if (SDG_TARGET_LINUX || SDG_TARGET_MAC)
+        std::vector<char *> argv;
+        argv.reserve(args.size() + 1);
+        for (const String &arg : args)
+            argv.push_back(const_cast<char *>(arg.Cstr()));
+        argv.push_back(nullptr);
+
+        pid_t pid;
+        if (posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) != 0)
+            return -1;
+
+        int status;
+        while (waitpid(pid, &status, 0) == -1)
+        {
+            if (errno != EINTR)
+                return -1;
+        }
+
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#else
+        // FileWatcher does not support this platform, so no source change ever reaches here
+        (void)args;
+        return -1;
+#endif
+    }
+
+    struct HotReload::Impl
+    {
+        struct Entry
+        {
+            Reloader reloader;
+            const void *owner;
+        };
+
+        Impl() : content(), source(), sourceDir(), args(), reloaders(), mutex(), workReady(), queue(),
+            running(), stopping(false), runner() { }
+        ~Impl()
+        {
+            {
+                std::lock_guard lock(mutex);
+                stopping = true;
+                queue.clear();
+            }
+            workReady.notify_all();
+
+            if (runner.joinable())
+                runner.join();
+        }
+
+        /// Queues a changed source file for the content pipeline
+        void Enqueue(const Path &changed);
+        void RunnerMain();
+
+        FileWatcher content, source;
+        Path sourceDir;
+        std::vector<String> args;   ///< content pipeline program and arguments, without --only
+        std::vector<Entry> reloaders;
+
+        std::mutex mutex;           ///< guards queue, running and stopping
+        std::condition_variable workReady;
+        std::deque<String> queue;   ///< changed source files, relative to sourceDir
+        size_t running;             ///< 1 while the pipeline runs, otherwise 0
+        bool stopping;
+        std::thread runner;         ///< runs the pipeline one file at a time, started on the first change
+    };
+
+    void
+    HotReload::Impl::Enqueue(const Path &changed)
+    {
+        // Watched paths share the directory's base and start with its subpath
+        const String &dir = sourceDir.Subpath();
+        String relative = dir.Empty() ? changed.Subpath() : changed.Subpath().Substr(dir.Length() + 1);
+
+        {
+            std::lock_guard lock(mutex);
+            if (std::find(queue.begin(), queue.end(), relative) != queue.end())
+                return;
+            queue.emplace_back(std::move(relative));
+        }
+        workReady.notify_one();
+
+        if (!runner.joinable())
+            runner = std::thread(&Impl::RunnerMain, this);
+    }
+
+    void
+    HotReload::Impl::RunnerMain()
+    {
+        while (true)
+        {
+            String file;
+            {
+                std::unique_lock lock(mutex);
+                running = 0;
+                workReady.wait(lock, [this]() { return stopping || !queue.empty(); });
+                if (stopping)
+                    return;
+
+                file = std::move(queue.front());
+                queue.pop_front();
+                running = 1;
+            }
+
+            SDG_Core_Log("HotReload: processing changed asset {}", file);
+            std::vector<String> fullArgs = args;
+            fullArgs.emplace_back("--only");
+            fullArgs.emplace_back(std::move(file));
+
+            const int status = RunProcess(fullArgs);
+            if (status != 0)
+                SDG_Core_Err("HotReload: content pipeline failed on {} with status {}", fullArgs.back(), status);
+        }
+    }
+
+    HotReload::HotReload() : impl(new Impl)
+    {
+
+    }
+
+    HotReload::~HotReload()
+    {
+        delete impl;
+    }
+
+    auto
+    HotReload::WatchContent(const Path &contentDir)->bool
+    {
+        if (!impl->content.Watch(contentDir))
+        {
+            SDG_Core_Err("HotReload::WatchContent: {}", impl->content.GetError());
+            return false;
+        }
+
+        return true;
+    }
+
+    auto
+    HotReload::WatchSource(const Path &sourceDir, std::vector<String> pipelineArgs)->bool
+    {
+        if (pipelineArgs.empty())
+        {
+            SDG_Core_Err("HotReload::WatchSource: pipelineArgs must name the content pipeline program");
+            return false;
+        }
+
+        if (!impl->source.Watch(sourceDir))
+        {
+            SDG_Core_Err("HotReload::WatchSource: {}", impl->source.GetError());
+            return false;
+        }
+
+        impl->sourceDir = sourceDir;
+        impl->args = std::move(pipelineArgs);
+        return true;
+    }
+
+    auto
+    HotReload::Add(AssetMgr &assets)->void
+    {
+        impl->reloaders.push_back({ [&assets](const Path &path) { assets.ReloadTexture(path); }, &assets });
+    }
+
+    auto
+    HotReload::Add(Shader &shader)->void
+    {
+        // Paths are checked on each change, so the shader may be compiled after it is added
+        impl->reloaders.push_back({ [&shader](const Path &path) {
+            if (path.Hash() == shader.VertexPath().Hash() || path.Hash() == shader.FragmentPath().Hash())
+                shader.Reload();
+        }, &shader });
+    }
+
+    auto
+    HotReload::Add(JsonLoadable &loadable)->void
+    {
+        impl->reloaders.push_back({ [&loadable](const Path &path) {
+            if (path.Hash() == loadable.Filepath().Hash())
+                loadable.Reload();
+        }, &loadable });
+    }
+
+    auto
+    HotReload::Add(const Path &path, Reloader reloader, const void *owner)->void
+    {
+        impl->reloaders.push_back({ [hash = path.Hash(), reloader = std::move(reloader)](const Path &changed) {
+            if (changed.Hash() == hash)
+                reloader(changed);
+        }, owner });
+    }
+
+    auto
+    HotReload::Remove(const void *owner)->void
+    {
+        auto &reloaders = impl->reloaders;
+        reloaders.erase(std::remove_if(reloaders.begin(), reloaders.end(),
+            [owner](const Impl::Entry &entry) { return entry.owner == owner; }), reloaders.end());
+    }
+
+    auto
+    HotReload::Update()->void
+    {
+        impl->source.Poll([this](const Path &path) { impl->Enqueue(path); });
+
+        impl->content.Poll([this](const Path &path) {
+            // Copied, since reloaders may add or remove others
+            const std::vector<Impl::Entry> reloaders = impl->reloaders;
+            for (const auto &entry : reloaders)
+                entry.reloader(path);
+        });
+    }
+
+    auto
+    HotReload::PipelineCount() const->size_t
+    {
+        std::lock_guard lock(impl->mutex);
+        return impl->queue.size() + impl->running;
+    }
+}
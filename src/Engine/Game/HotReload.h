@@ -0,0 +1,91 @@
+/*!
+ * @file HotReload.h -- SDG_Engine
+ * @class HotReload
+ * Reloads assets while the game runs, as their files change, so artists
+ * see their edits without restarting. Optional: nothing is watched unless a
+ * HotReload is created, and file watching is only supported on Linux so far
+ * (see FileWatcher).
+ *
+ * Watch the source asset directory to rerun SDG_ContentPipe on just the
+ * asset that changed, and the content directory the game loads from to
+ * reload what it writes. Objects added to the HotReload reload in place, so
+ * references and handles to them stay valid:
+ *     HotReload reload;
+ *     reload.WatchSource(RootPath("home/me/game/assets"),
+ *         {"SDG_ContentPipe", "/home/me/game/assets", "assets", "key", "assets.json"});
+ *     reload.WatchContent(BasePath("assets"));
+ *     reload.Add(assets);   // AssetMgr textures
+ *     reload.Add(shader);   // recompiled with Shader::Reload
+ *     reload.Add(config);   // JsonLoadable, reloaded with Reload
+ *     ...
+ *     reload.Update();      // once per frame
+ *
+ * When the content pipeline daemon (SDG_ContentPipe --watch) is running, it
+ * rebuilds changed assets itself, so only WatchContent is needed.
+ *
+ * Loose files are reloaded, so do not mount a Pack of the content while hot
+ * reloading: its files are found before the loose ones.
+ */
+#pragma once
+#include <Engine/Filesys/Path.h>
+#include <Engine/Lib/ClassMacros.h>
+#include <Engine/Lib/String.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace SDG
+{
+    class AssetMgr;
+    class JsonLoadable;
+    class Shader;
+
+    class HotReload {
+        SDG_NOCOPY(HotReload);
+        struct Impl;
+    public:
+        using Reloader = std::function<void(const Path &)>;
+
+        HotReload();
+        /// Waits for a content pipeline run underway to finish
+        ~HotReload();
+
+        /// Watches the directory the game loads content from. Files changed there are passed to the reloaders.
+        /// @return whether the directory is watched. Fails on platforms FileWatcher does not support.
+        auto WatchContent(const Path &contentDir)->bool;
+
+        /**
+         * Watches the source asset directory, rerunning the content pipeline for each file changed there,
+         * one at a time on a background thread. The files it writes are then reloaded from the content directory.
+         * @param sourceDir - the asset directory passed to SDG_ContentPipe
+         * @param pipelineArgs - SDG_ContentPipe and its usual arguments. The program is found on PATH when it has
+         * no slashes. It runs without a shell, with the changed file appended as "--only" "<path>", relative to
+         * sourceDir, so file names are never interpreted.
+         * @return whether the directory is watched. Also fails if pipelineArgs is empty.
+         */
+        auto WatchSource(const Path &sourceDir, std::vector<String> pipelineArgs)->bool;
+
+        /// Reloads textures cached in the AssetMgr in place, with AssetMgr::ReloadTexture
+        auto Add(AssetMgr &assets)->void;
+        /// Recompiles the Shader when either of its files changes. Failing to compile keeps the old program.
+        auto Add(Shader &shader)->void;
+        /// Reloads the JsonLoadable when the file it was loaded from changes
+        auto Add(JsonLoadable &loadable)->void;
+        /// Invokes the reloader whenever the file at path changes
+        /// @param owner - identifies the reloader to Remove, such as the object it reloads
+        auto Add(const Path &path, Reloader reloader, const void *owner = nullptr)->void;
+
+        /// Stops reloading an object added before. Call before destroying it.
+        auto Remove(const void *owner)->void;
+
+        /// Polls for changed files, starts content pipeline runs, and reloads changed content. Call once per frame
+        /// on the main thread. Textures finish reloading in AssetMgr::Update.
+        auto Update()->void;
+
+        /// Number of changed source files waiting for, or being processed by, the content pipeline
+        [[nodiscard]] auto PipelineCount() const->size_t;
+    private:
+        Impl *impl;
+    };
+}
@@ -0,0 +1,95 @@
+#include "Scheduler.h"
+
+#include <algorithm>
+
+namespace SDG
+{
+    /// Checks whether two sorted lists of ids have one in common
+    static bool Intersects(const std::vector<ComponentTypeID> &a, const std::vector<ComponentTypeID> &b)
+    {
+        for (auto i = a.begin(), j = b.begin(); i != a.end() && j != b.end(); )
+        {
+            if (*i < *j)
+                ++i;
+            else if (*j < *i)
+                ++j;
+            else
+                return true;
+        }
+
+        return false;
+    }
+
+    bool
+    SystemAccess::ConflictsWith(const SystemAccess &other) const
+    {
+        return exclusive || other.exclusive ||
+            Intersects(writes, other.writes) || Intersects(writes, other.reads) || Intersects(reads, other.writes);
+    }
+
+    void
+    SystemAccess::Add(std::vector<ComponentTypeID> &ids, ComponentTypeID id)
+    {
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it == ids.end() || *it != id)
+            ids.insert(it, id);
+    }
+
+    Scheduler::Scheduler() : systems(), remaining()
+    {
+
+    }
+
+    Scheduler::~Scheduler()
+    {
+
+    }
+
+    Scheduler &
+    Scheduler::AddSystem(const String &name, const SystemAccess &access, SystemFunc func)
+    {
+        const size_t index = systems.size();
+        System system{ name, access, std::move(func), {}, {} };
+        for (size_t i = 0; i < index; ++i)
+        {
+            if (systems[i].access.ConflictsWith(access))
+                system.dependencies.push_back(i);
+        }
+
+        for (size_t dependency : system.dependencies)
+            systems[dependency].dependents.push_back(index);
+        systems.emplace_back(std::move(system));
+
+        remaining.reset(new std::atomic<int>[systems.size()]);
+        return *this;
+    }
+
+    void
+    Scheduler::Run(World &world, JobSystem &jobs)
+    {
+        for (size_t i = 0; i < systems.size(); ++i)
+            remaining[i].store((int)systems[i].dependencies.size(), std::memory_order_relaxed);
+
+        // Each system submits the dependents it was the last dependency of. They are counted before the system's
+        // own job finishes, so the counter only reaches zero once every system that can run has.
+        JobCounter counter;
+        std::function<void(size_t)> launch = [&](size_t index) {
+            jobs.Run([&, index]() {
+                systems[index].func(world, jobs);
+                for (size_t dependent : systems[index].dependents)
+                {
+                    if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        launch(dependent);
+                }
+            }, &counter);
+        };
+
+        for (size_t i = 0; i < systems.size(); ++i)
+        {
+            if (systems[i].dependencies.empty())
+                launch(i);
+        }
+
+        jobs.Wait(counter);
+    }
+}
@@ -0,0 +1,136 @@
+/* ====================================================================================================================
+ * @file Scheduler.h - SDG_Engine
+ *
+ * @class SystemAccess
+ * The component types a system reads and writes.
+ *
+ * @class Scheduler
+ * Runs systems over a World across the workers of a JobSystem. Systems declare their SystemAccess, and the scheduler
+ * orders each system after the ones added before it that it conflicts with: one writes a component type the other
+ * reads or writes. Systems that do not conflict run at the same time. For example:
+ *     scheduler.AddEach<Position, const Velocity>("move", [](Position &p, const Velocity &v) { ... });
+ *     scheduler.AddEach<Velocity, const Gravity>("fall", ...);  // after "move", which reads Velocity
+ *     scheduler.AddEach<Sprite, const Health>("flash", ...);    // alongside both
+ *     scheduler.Add("spawn", SystemAccess().Exclusive(), [](World &world) { world.CreateEntity(); ... });
+ *     ...
+ *     scheduler.Run(world, jobs);  // once per frame
+ * ==================================================================================================================*/
+#pragma once
+#include "ComponentType.h"
+#include "World.h"
+#include <Engine/Jobs/JobSystem.h>
+#include <Engine/Lib/ClassMacros.h>
+#include <Engine/Lib/String.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace SDG
+{
+    class SystemAccess
+    {
+    public:
+        SystemAccess() : reads(), writes(), exclusive(false) { }
+
+        /// Gets the access of a query over Ts: const types are read, and the others written
+        template <typename...Ts>
+        [[nodiscard]] static SystemAccess Of()
+        {
+            SystemAccess access;
+            ([&access]() {
+                if constexpr (std::is_const_v<Ts>)
+                    access.Read<std::remove_const_t<Ts>>();
+                else
+                    access.Write<Ts>();
+            }(), ...);
+            return access;
+        }
+
+        template <typename...Ts>
+        SystemAccess &Read() { (Add(reads, ComponentTypeOf<Ts>().id), ...); return *this; }
+
+        template <typename...Ts>
+        SystemAccess &Write() { (Add(writes, ComponentTypeOf<Ts>().id), ...); return *this; }
+
+        /// Marks a system that changes the world's structure, by creating or destroying entities or adding or
+        /// removing components, so it conflicts with every other system
+        SystemAccess &Exclusive() { exclusive = true; return *this; }
+
+        /// Checks whether two systems may not run at the same time
+        [[nodiscard]] bool ConflictsWith(const SystemAccess &other) const;
+    private:
+        /// Inserts an id into a sorted list of ids, if it is not there
+        static void Add(std::vector<ComponentTypeID> &ids, ComponentTypeID id);
+
+        std::vector<ComponentTypeID> reads, writes; ///< sorted
+        bool exclusive;
+    };
+
+    class Scheduler
+    {
+        SDG_NOCOPY(Scheduler);
+    public:
+        using SystemFunc = std::function<void(World &, JobSystem &)>;
+
+        Scheduler();
+        ~Scheduler();
+
+        /// Adds a system, which runs after the systems added before it that it conflicts with
+        /// @param func - called as func(World &) or func(World &, JobSystem &) once per Run. May spawn jobs of its
+        ///               own, but must wait on them before returning.
+        template <typename Func>
+        Scheduler &Add(const String &name, const SystemAccess &access, Func &&func)
+        {
+            if constexpr (std::is_invocable_v<Func &, World &, JobSystem &>)
+                return AddSystem(name, access, SystemFunc(std::forward<Func>(func)));
+            else
+                return AddSystem(name, access,
+                    [func = std::forward<Func>(func)](World &world, JobSystem &) mutable { func(world); });
+        }
+
+        /// Adds a system that calls a function for each entity that has every component type in Ts, splitting the
+        /// entities across workers with World::ParallelEach. Const types are read, and the others written.
+        /// @param func - called as in World::Each, from several threads at once
+        template <typename...Ts, typename Func>
+        Scheduler &AddEach(const String &name, Func &&func)
+        {
+            return AddSystem(name, SystemAccess::Of<Ts...>(),
+                [func = std::forward<Func>(func)](World &world, JobSystem &jobs) {
+                    world.ParallelEach<Ts...>(jobs, func);
+                });
+        }
+
+        /// Runs every system once, returning when all are done. Rethrows the first exception a system throws;
+        /// systems after it that depend on it are skipped.
+        void Run(World &world, JobSystem &jobs);
+
+        /// Number of systems
+        [[nodiscard]] size_t Size() const { return systems.size(); }
+
+        [[nodiscard]] const String &NameOf(size_t index) const { return systems.at(index).name; }
+
+        /// Gets the indices of the systems that a system runs after
+        [[nodiscard]] const std::vector<size_t> &DependenciesOf(size_t index) const
+        {
+            return systems.at(index).dependencies;
+        }
+    private:
+        struct System
+        {
+            String name;
+            SystemAccess access;
+            SystemFunc func;
+            std::vector<size_t> dependencies; ///< earlier systems it conflicts with
+            std::vector<size_t> dependents;   ///< later systems that conflict with it
+        };
+
+        Scheduler &AddSystem(const String &name, const SystemAccess &access, SystemFunc func);
+
+        std::vector<System> systems;
+        std::unique_ptr<std::atomic<int>[]> remaining; ///< dependencies of each system left to run, during Run
+    };
+}
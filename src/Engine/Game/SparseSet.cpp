@@ -0,0 +1,68 @@
+#include "SparseSet.h"
+#include <Engine/Debug/Assert.h>
+
+#include <algorithm>
+
+namespace SDG
+{
+    SparseSet::SparseSet() : pages(), dense()
+    {
+
+    }
+
+    SparseSet::~SparseSet()
+    {
+
+    }
+
+    uint32_t
+    SparseSet::Insert(Entity entity)
+    {
+        const uint32_t page = entity.Index() / PageSize;
+        if (page >= pages.size())
+            pages.resize(page + 1);
+        if (!pages[page])
+        {
+            pages[page].reset(new uint32_t[PageSize]);
+            std::fill_n(pages[page].get(), PageSize, NullIndex);
+        }
+
+        uint32_t &index = pages[page][entity.Index() % PageSize];
+        SDG_Assert(index == NullIndex || dense[index].Index() != entity.Index());
+
+        dense.emplace_back(entity);
+        index = (uint32_t)(dense.size() - 1);
+        return index;
+    }
+
+    bool
+    SparseSet::Remove(Entity entity)
+    {
+        const uint32_t index = IndexOf(entity);
+        if (index == NullIndex)
+            return false;
+
+        SwapRemove(index);
+        return true;
+    }
+
+    void
+    SparseSet::SwapRemove(uint32_t index)
+    {
+        const Entity removed = dense[index];
+        const Entity last = dense.back();
+        dense[index] = last;
+        dense.pop_back();
+
+        pages[last.Index() / PageSize][last.Index() % PageSize] = index;
+        pages[removed.Index() / PageSize][removed.Index() % PageSize] = NullIndex;
+    }
+
+    void
+    SparseSet::Clear()
+    {
+        for (const Entity &entity : dense)
+            pages[entity.Index() / PageSize][entity.Index() % PageSize] = NullIndex;
+        dense.clear();
+    }
+}
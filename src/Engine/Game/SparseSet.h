@@ -0,0 +1,141 @@
+/* ====================================================================================================================
+ * @file SparseSet.h - SDG_Engine
+ *
+ * @class SparseSet
+ * Set of entities with O(1) insert, remove and lookup, and a dense array of its entities for iteration. A sparse,
+ * paged array maps each entity's index to its position in the dense array; removal moves the last entity into the
+ * hole.
+ *
+ * @class ComponentSet
+ * SparseSet that stores a component for each of its entities, in a dense array parallel to the entities.
+ * ==================================================================================================================*/
+#pragma once
+#include "Entity.h"
+#include <Engine/Lib/ClassMacros.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SDG
+{
+    class SparseSet
+    {
+        SDG_NOCOPY(SparseSet);
+    public:
+        /// Position of entities that are not in the set
+        static constexpr uint32_t NullIndex = ~0u;
+
+        SparseSet();
+        virtual ~SparseSet();
+
+        /// Gets an entity's position in the dense array
+        /// @return the position, or NullIndex if the set does not hold this entity
+        [[nodiscard]] uint32_t IndexOf(Entity entity) const
+        {
+            const uint32_t page = entity.Index() / PageSize;
+            if (page >= pages.size() || !pages[page])
+                return NullIndex;
+
+            const uint32_t index = pages[page][entity.Index() % PageSize];
+            return index != NullIndex && dense[index] == entity ? index : NullIndex;
+        }
+
+        [[nodiscard]] bool Contains(Entity entity) const { return IndexOf(entity) != NullIndex; }
+
+        /// Number of entities in the set
+        [[nodiscard]] size_t Size() const { return dense.size(); }
+        [[nodiscard]] bool Empty() const { return dense.empty(); }
+
+        /// Gets the entities in the set, densely packed, in no particular order
+        [[nodiscard]] const Entity *Entities() const { return dense.data(); }
+
+        /// Removes an entity from the set
+        /// @return whether the set held it
+        virtual bool Remove(Entity entity);
+
+        /// Removes every entity from the set
+        virtual void Clear();
+
+    protected:
+        /// Adds an entity to the end of the dense array. The set must not already hold an entity with its index.
+        /// @return the entity's position
+        uint32_t Insert(Entity entity);
+
+        /// Removes the entity at a position, moving the last entity into it
+        void SwapRemove(uint32_t index);
+
+    private:
+        /// Entity indices per page of the sparse array; pages are allocated as indices in them are used
+        static constexpr uint32_t PageSize = 1024;
+
+        std::vector<std::unique_ptr<uint32_t[]>> pages;
+        std::vector<Entity> dense;
+    };
+
+    template <typename T>
+    class ComponentSet : public SparseSet
+    {
+        static_assert(std::is_move_constructible_v<T> && std::is_move_assignable_v<T>,
+            "Components stored in sparse sets must be move-constructible and move-assignable");
+    public:
+        /// Adds a component for an entity, which must not already have one
+        template <typename...Args>
+        T &Emplace(Entity entity, Args &&...args)
+        {
+            components.emplace_back(std::forward<Args>(args)...);
+            try {
+                Insert(entity);
+            }
+            catch (...)
+            {
+                components.pop_back();
+                throw;
+            }
+
+            return components.back();
+        }
+
+        /// Gets an entity's component
+        /// @return the component, or nullptr if the entity has none in this set
+        [[nodiscard]] T *Find(Entity entity)
+        {
+            const uint32_t index = IndexOf(entity);
+            return index == NullIndex ? nullptr : &components[index];
+        }
+
+        [[nodiscard]] const T *Find(Entity entity) const
+        {
+            const uint32_t index = IndexOf(entity);
+            return index == NullIndex ? nullptr : &components[index];
+        }
+
+        /// Gets the components, in the same order as Entities()
+        [[nodiscard]] T *Components() { return components.data(); }
+        [[nodiscard]] const T *Components() const { return components.data(); }
+
+        bool Remove(Entity entity) override
+        {
+            const uint32_t index = IndexOf(entity);
+            if (index == NullIndex)
+                return false;
+
+            if (index + 1 != components.size())
+                components[index] = std::move(components.back());
+            components.pop_back();
+            SwapRemove(index);
+            return true;
+        }
+
+        void Clear() override
+        {
+            components.clear();
+            SparseSet::Clear();
+        }
+    private:
+        std::vector<T> components;
+    };
+}
@@ -0,0 +1,232 @@
+#include "World.h"
+#include <Engine/Debug/Assert.h>
+#include <Engine/Exceptions/RuntimeException.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace SDG
+{
+    World::World() : records(), freeIndices(), liveCount(), archetypes(), empty(), bySignature(), neighbors(),
+        sets(), iterating()
+    {
+        archetypes.emplace_back(new Archetype({}));
+        empty = archetypes.back().get();
+        bySignature[{}] = empty;
+    }
+
+    World::~World()
+    {
+
+    }
+
+    Entity
+    World::CreateEntity()
+    {
+        SDG_Assert(iterating == 0);
+
+        uint32_t index;
+        if (freeIndices.empty())
+        {
+            if (records.size() >= Entity::MaxCount)
+                throw RuntimeException("World::CreateEntity: too many entities");
+            index = (uint32_t)records.size();
+            records.push_back({ nullptr, 0, 0 });
+        }
+        else
+        {
+            index = freeIndices.back();
+            freeIndices.pop_back();
+        }
+
+        Record &record = records[index];
+        const Entity entity(index, record.generation);
+        record.row = empty->PushBack(entity);
+        record.archetype = empty;
+        ++liveCount;
+        return entity;
+    }
+
+    void
+    World::DestroyEntity(Entity entity)
+    {
+        SDG_Assert(iterating == 0);
+        if (!IsAlive(entity))
+            return;
+
+        for (auto &set : sets)
+        {
+            if (set)
+                set->Remove(entity);
+        }
+
+        Record &record = records[entity.Index()];
+        const Entity moved = record.archetype->SwapRemove(record.row);
+        records[moved.Index()].row = record.row;
+        record.archetype = nullptr;
+        --liveCount;
+
+        // Retire the slot once its generations run out, so no handle can be mistaken for a later entity
+        if (++record.generation <= Entity::MaxGeneration)
+            freeIndices.emplace_back(entity.Index());
+    }
+
+    bool
+    World::IsAlive(Entity entity) const
+    {
+        const uint32_t index = entity.Index();
+        return index < records.size() && records[index].archetype &&
+            records[index].generation == entity.Generation();
+    }
+
+    void
+    World::Clear()
+    {
+        SDG_Assert(iterating == 0);
+        for (auto &archetype : archetypes)
+            archetype->Clear();
+        for (auto &set : sets)
+        {
+            if (set)
+                set->Clear();
+        }
+
+        // Keep the generations, so handles to the cleared entities stay invalid
+        freeIndices.clear();
+        for (uint32_t i = (uint32_t)records.size(); i-- > 0; )
+        {
+            Record &record = records[i];
+            if (record.archetype)
+            {
+                record.archetype = nullptr;
+                ++record.generation;
+            }
+
+            if (record.generation <= Entity::MaxGeneration)
+                freeIndices.emplace_back(i);
+        }
+
+        liveCount = 0;
+    }
+
+    void *
+    World::Emplace(Entity entity, const ComponentType &type)
+    {
+        SDG_Assert(iterating == 0);
+        Record &record = records[entity.Index()];
+        Archetype *to = Neighbor(record.archetype, type, true);
+        MoveEntity(record, entity, to);
+        return to->At(record.row, to->ColumnOf(type.id));
+    }
+
+    bool
+    World::Erase(Entity entity, ComponentTypeID type)
+    {
+        if (!IsAlive(entity))
+            return false;
+
+        Record &record = records[entity.Index()];
+        const int column = record.archetype->ColumnOf(type);
+        if (column == -1)
+            return false;
+
+        SDG_Assert(iterating == 0);
+        MoveEntity(record, entity, Neighbor(record.archetype, *record.archetype->Types()[column], false));
+        return true;
+    }
+
+    void *
+    World::Find(Entity entity, ComponentTypeID type) const
+    {
+        if (!IsAlive(entity))
+            return nullptr;
+
+        const Record &record = records[entity.Index()];
+        const int column = record.archetype->ColumnOf(type);
+        return column == -1 ? nullptr : record.archetype->At(record.row, column);
+    }
+
+    Archetype *
+    World::Neighbor(Archetype *archetype, const ComponentType &type, bool add)
+    {
+        auto &neighbor = neighbors[{ archetype, type.id, add }];
+        if (neighbor)
+            return neighbor;
+
+        std::vector<const ComponentType *> types = archetype->Types();
+        if (add)
+        {
+            types.insert(std::upper_bound(types.begin(), types.end(), &type,
+                [](const ComponentType *a, const ComponentType *b) { return a->id < b->id; }), &type);
+        }
+        else
+        {
+            types.erase(std::remove(types.begin(), types.end(), &type), types.end());
+        }
+
+        std::vector<ComponentTypeID> signature(types.size());
+        std::transform(types.begin(), types.end(), signature.begin(),
+            [](const ComponentType *t) { return t->id; });
+
+        Archetype *&found = bySignature[signature];
+        if (!found)
+        {
+            archetypes.emplace_back(new Archetype(std::move(types)));
+            found = archetypes.back().get();
+        }
+
+        neighbor = found;
+        return neighbor;
+    }
+
+    void
+    World::MoveEntity(Record &record, Entity entity, Archetype *to)
+    {
+        Archetype *from = record.archetype;
+        const uint32_t row = to->PushBack(entity);
+
+        // Column types of both archetypes are ordered by id, so common columns can be matched in one pass
+        const auto &fromTypes = from->Types();
+        const auto &toTypes = to->Types();
+        for (size_t i = 0, j = 0; i < fromTypes.size() && j < toTypes.size(); )
+        {
+            if (fromTypes[i]->id < toTypes[j]->id)
+            {
+                ++i;
+            }
+            else if (toTypes[j]->id < fromTypes[i]->id)
+            {
+                ++j;
+            }
+            else
+            {
+                const ComponentType &type = *fromTypes[i];
+                if (type.move)
+                    type.move(to->At(row, j), from->At(record.row, i));
+                else
+                    std::memcpy(to->At(row, j), from->At(record.row, i), type.size);
+                ++i, ++j;
+            }
+        }
+
+        // Destroys the moved-from components, and the one being removed, if any
+        const Entity moved = from->SwapRemove(record.row);
+        records[moved.Index()].row = record.row;
+
+        record.archetype = to;
+        record.row = row;
+    }
+
+    bool
+    World::Match(const Archetype &archetype, const ComponentType *const *types, int *columns, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            columns[i] = archetype.ColumnOf(types[i]->id);
+            if (columns[i] == -1 && !types[i]->sparse)
+                return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,173 @@
+/* ====================================================================================================================
+ * @file World.h - SDG_Engine
+ *
+ * @class World
+ * Holds entities and their components. Entities with the same set of component types share an Archetype, which stores
+ * each component type in contiguous arrays, so queries visit the components they match linearly, chunk by chunk.
+ * Component types that ask for sparse storage are kept in a ComponentSet per type instead.
+ * ==================================================================================================================*/
+#pragma once
+#include "Archetype.h"
+#include "ComponentType.h"
+#include "Entity.h"
+#include "SparseSet.h"
+#include <Engine/Lib/ClassMacros.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace SDG
+{
+    class JobSystem;
+
+    /// Holds entities and their components.
+    /// Components may be any move-constructible type, and are stored by value. Adding or removing a component moves
+    /// an entity's archetype components to another archetype, which invalidates pointers to components of that
+    /// archetype, and may not be done from inside a query over the world. Components with sparse storage (see
+    /// ComponentType.h) are added and removed in O(1), without moving other components.
+    class World
+    {
+        SDG_NOCOPY(World);
+    public:
+        World();
+        ~World();
+
+        // ========== Entities ================================================
+
+        /// Creates an entity with no components.
+        /// Throws RuntimeException if the world already holds Entity::MaxCount entities.
+        Entity CreateEntity();
+
+        /// Destroys an entity and its components. Does nothing if the entity is not alive.
+        void DestroyEntity(Entity entity);
+
+        /// Checks whether a handle refers to an entity that was created and not destroyed since
+        [[nodiscard]] bool IsAlive(Entity entity) const;
+
+        /// Number of live entities
+        [[nodiscard]] size_t EntityCount() const { return liveCount; }
+
+        /// Destroys every entity. Handles to them stay invalid.
+        void Clear();
+
+        // ========== Components ==============================================
+
+        /// Adds a component to an entity, or replaces the one it has
+        /// @param args - arguments to construct the component with
+        /// @return the component
+        template <typename T, typename...Args>
+        T &Add(Entity entity, Args &&...args);
+
+        /// Removes a component from an entity
+        /// @return whether the entity had the component
+        template <typename T>
+        bool Remove(Entity entity);
+
+        /// Gets an entity's component
+        /// @return the component, or nullptr if the entity is not alive or does not have one of type T
+        template <typename T>
+        [[nodiscard]] T *Get(Entity entity);
+        template <typename T>
+        [[nodiscard]] const T *Get(Entity entity) const;
+
+        template <typename T>
+        [[nodiscard]] bool Has(Entity entity) const { return Get<T>(entity) != nullptr; }
+
+        // ========== Queries =================================================
+
+        /// Calls a function for each entity that has every component type in Ts
+        /// @param func - called as func(Ts &...) or func(Entity, Ts &...). Use const types for read-only access.
+        template <typename...Ts, typename Func>
+        void Each(Func &&func);
+
+        /// Calls a function for each chunk of entities that have every component type in Ts, for loops that work
+        /// on whole arrays of components. Ts may not have sparse storage.
+        /// @param func - called as func(size_t count, const Entity *entities, Ts *...components)
+        template <typename...Ts, typename Func>
+        void EachChunk(Func &&func);
+
+        /// Calls a function for each entity that has every component type in Ts, splitting the entities by chunk
+        /// into jobs that run across a JobSystem's workers. Returns once every entity was visited. Ts may not have
+        /// sparse storage. Queries may run at the same time as each other, but not alongside structural changes.
+        /// @param func - called as in Each, from several threads at once
+        template <typename...Ts, typename Func>
+        void ParallelEach(JobSystem &jobs, Func &&func);
+
+        /// Number of entities that have every component type in Ts
+        template <typename...Ts>
+        [[nodiscard]] size_t Count() const;
+
+        /// Number of distinct sets of archetype components entities have had
+        [[nodiscard]] size_t ArchetypeCount() const { return archetypes.size(); }
+
+    private:
+        struct Record
+        {
+            Archetype *archetype; ///< null while the slot holds no entity
+            uint32_t row;
+            uint32_t generation;  ///< generation of the slot's current or next entity; past MaxGeneration once retired
+        };
+
+        /// Moves an entity to an archetype with one more component type
+        /// @return the new component, uninitialized
+        void *Emplace(Entity entity, const ComponentType &type);
+
+        /// Moves an entity to an archetype without a component type
+        /// @return whether the entity had the component
+        bool Erase(Entity entity, ComponentTypeID type);
+
+        /// Gets the archetype component of an entity
+        /// @return the component, or nullptr if the entity does not have one of the type
+        [[nodiscard]] void *Find(Entity entity, ComponentTypeID type) const;
+
+        /// Gets the sparse set of a component type, creating it if need be
+        template <typename T>
+        ComponentSet<T> &SetOf();
+
+        /// Gets the sparse set of a component type
+        /// @return the set, or nullptr if no component of the type was added yet
+        template <typename T>
+        [[nodiscard]] ComponentSet<T> *FindSet() const;
+
+        /// Gets the archetype with a component type added to or removed from another's, creating it if need be
+        Archetype *Neighbor(Archetype *archetype, const ComponentType &type, bool add);
+
+        /// Moves an entity's row to another archetype, moving the components the archetypes have in common
+        void MoveEntity(Record &record, Entity entity, Archetype *to);
+
+        /// Gets the columns of component types in an archetype. Sparse types match with column -1.
+        /// @return whether the archetype has every archetype type
+        static bool Match(const Archetype &archetype, const ComponentType *const *types, int *columns, size_t count);
+
+        /// Counts a query in progress while in scope, to assert against structural changes during queries
+        struct QueryScope
+        {
+            explicit QueryScope(std::atomic<int> &iterating) : iterating(iterating) { ++iterating; }
+            ~QueryScope() { --iterating; }
+            std::atomic<int> &iterating;
+        };
+
+        /// Implements Each and Count
+        template <typename...Ts, typename Func>
+        void Query(Func &&func) const;
+
+        std::vector<Record> records;
+        std::vector<uint32_t> freeIndices;
+        size_t liveCount;
+
+        std::vector<std::unique_ptr<Archetype>> archetypes;
+        Archetype *empty;  ///< archetype of entities with no archetype components
+        std::map<std::vector<ComponentTypeID>, Archetype *> bySignature;
+        std::map<std::tuple<const Archetype *, ComponentTypeID, bool>, Archetype *> neighbors;
+
+        std::vector<std::unique_ptr<SparseSet>> sets; ///< sparse sets, by component type id
+        mutable std::atomic<int> iterating;  ///< number of queries in progress
+    };
+}
+
+#include "World.inl"
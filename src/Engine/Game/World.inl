@@ -0,0 +1,267 @@
+#include "World.h"
+#include <Engine/Debug/Assert.h>
+#include <Engine/Exceptions/Fwd.h>
+#include <Engine/Jobs/JobSystem.h>
+
+#include <array>
+
+#include <type_traits>
+#include <utility>
+
+namespace SDG
+{
+    /// Constructs a component, with aggregate initialization if it has no matching constructor
+    template <typename T, typename...Args>
+    T MakeComponent(Args &&...args)
+    {
+        if constexpr (std::is_constructible_v<T, Args...>)
+            return T(std::forward<Args>(args)...);
+        else
+            return T{ std::forward<Args>(args)... };
+    }
+
+    template <typename T, typename...Args>
+    T &World::Add(Entity entity, Args &&...args)
+    {
+        if (!IsAlive(entity))
+            ThrowInvalidArgumentException("World::Add", "entity", "entity is not alive");
+
+        if (T *component = Get<T>(entity))
+        {
+            *component = MakeComponent<T>(std::forward<Args>(args)...);
+            return *component;
+        }
+
+        if constexpr (SparseComponent<T>)
+        {
+            SDG_Assert(iterating == 0);
+            return SetOf<T>().Emplace(entity, MakeComponent<T>(std::forward<Args>(args)...));
+        }
+        else
+        {
+            // Construct first, so a throwing constructor leaves the entity as it was
+            T component = MakeComponent<T>(std::forward<Args>(args)...);
+            return *new (Emplace(entity, ComponentTypeOf<T>())) T(std::move(component));
+        }
+    }
+
+    template <typename T>
+    bool World::Remove(Entity entity)
+    {
+        if constexpr (SparseComponent<T>)
+        {
+            SDG_Assert(iterating == 0);
+            ComponentSet<T> *set = FindSet<T>();
+            return set && set->Remove(entity);
+        }
+        else
+        {
+            return Erase(entity, ComponentTypeOf<T>().id);
+        }
+    }
+
+    template <typename T>
+    T *World::Get(Entity entity)
+    {
+        return const_cast<T *>(static_cast<const World *>(this)->Get<T>(entity));
+    }
+
+    template <typename T>
+    const T *World::Get(Entity entity) const
+    {
+        if constexpr (SparseComponent<T>)
+        {
+            const ComponentSet<T> *set = FindSet<T>();
+            return set ? set->Find(entity) : nullptr;
+        }
+        else
+        {
+            return static_cast<const T *>(Find(entity, ComponentTypeOf<T>().id));
+        }
+    }
+
+    template <typename T>
+    ComponentSet<T> &World::SetOf()
+    {
+        const ComponentTypeID id = ComponentTypeOf<T>().id;
+        if (id >= sets.size())
+            sets.resize(id + 1);
+        if (!sets[id])
+            sets[id].reset(new ComponentSet<T>);
+        return static_cast<ComponentSet<T> &>(*sets[id]);
+    }
+
+    template <typename T>
+    ComponentSet<T> *World::FindSet() const
+    {
+        const ComponentTypeID id = ComponentTypeOf<T>().id;
+        return id < sets.size() ? static_cast<ComponentSet<T> *>(sets[id].get()) : nullptr;
+    }
+
+    template <typename...Ts, typename Func>
+    void World::Query(Func &&func) const
+    {
+        static_assert(sizeof...(Ts) > 0, "Query must have at least one component type");
+
+        [&]<size_t...I>(std::index_sequence<I...>) {
+            // Sparse set of each sparse type, or nullptr for archetype types
+            const auto sets = std::make_tuple([this]() {
+                if constexpr (SparseComponent<std::remove_const_t<Ts>>)
+                    return static_cast<const ComponentSet<std::remove_const_t<Ts>> *>(
+                        FindSet<std::remove_const_t<Ts>>());
+                else
+                    return nullptr;
+            }()...);
+
+            // Nothing matches if no component of a sparse type was ever added
+            if (((SparseComponent<std::remove_const_t<Ts>> && std::get<I>(sets) == nullptr) || ...))
+                return;
+
+            const QueryScope scope(iterating);
+            if constexpr ((SparseComponent<std::remove_const_t<Ts>> && ...))
+            {
+                // Visit the smallest set, looking up the rest
+                const SparseSet *lead = nullptr;
+                ((lead = !lead || std::get<I>(sets)->Size() < lead->Size() ? std::get<I>(sets) : lead), ...);
+
+                for (size_t i = 0, count = lead->Size(); i < count; ++i)
+                {
+                    const Entity entity = lead->Entities()[i];
+                    const auto components = std::make_tuple(std::get<I>(sets)->Find(entity)...);
+                    if ((std::get<I>(components) && ...))
+                        func(entity, *const_cast<Ts *>(std::get<I>(components))...);
+                }
+            }
+            else
+            {
+                const ComponentType *types[] = { &ComponentTypeOf<std::remove_const_t<Ts>>()... };
+                int columns[sizeof...(Ts)];
+                for (const auto &archetype : archetypes)
+                {
+                    if (archetype->Size() == 0 || !Match(*archetype, types, columns, sizeof...(Ts)))
+                        continue;
+
+                    for (size_t chunk = 0, chunkCount = archetype->ChunkCount(); chunk < chunkCount; ++chunk)
+                    {
+                        const Entity *entities = archetype->Entities(chunk);
+                        char *const chunkColumns[] = {
+                            (columns[I] == -1 ? nullptr : archetype->Column(chunk, columns[I]))...
+                        };
+
+                        for (size_t i = 0, count = archetype->ChunkSize(chunk); i < count; ++i)
+                        {
+                            const auto components = std::make_tuple([&]() {
+                                if constexpr (SparseComponent<std::remove_const_t<Ts>>)
+                                    return const_cast<Ts *>(std::get<I>(sets)->Find(entities[i]));
+                                else
+                                    return reinterpret_cast<Ts *>(chunkColumns[I]) + i;
+                            }()...);
+
+                            if (((!SparseComponent<std::remove_const_t<Ts>> || std::get<I>(components)) && ...))
+                                func(entities[i], *std::get<I>(components)...);
+                        }
+                    }
+                }
+            }
+        }(std::index_sequence_for<Ts...>());
+    }
+
+    template <typename...Ts, typename Func>
+    void World::Each(Func &&func)
+    {
+        Query<Ts...>([&func](Entity entity, Ts &...components) {
+            if constexpr (std::is_invocable_v<Func &, Entity, Ts &...>)
+                func(entity, components...);
+            else
+                func(components...);
+        });
+    }
+
+    template <typename...Ts, typename Func>
+    void World::EachChunk(Func &&func)
+    {
+        static_assert(sizeof...(Ts) > 0, "Query must have at least one component type");
+        static_assert(!(SparseComponent<std::remove_const_t<Ts>> || ...),
+            "EachChunk takes component types stored in archetypes only");
+
+        const ComponentType *types[] = { &ComponentTypeOf<std::remove_const_t<Ts>>()... };
+        int columns[sizeof...(Ts)];
+
+        const QueryScope scope(iterating);
+        for (const auto &archetype : archetypes)
+        {
+            if (archetype->Size() == 0 || !Match(*archetype, types, columns, sizeof...(Ts)))
+                continue;
+
+            for (size_t chunk = 0, count = archetype->ChunkCount(); chunk < count; ++chunk)
+            {
+                [&]<size_t...I>(std::index_sequence<I...>) {
+                    func(archetype->ChunkSize(chunk), static_cast<const Entity *>(archetype->Entities(chunk)),
+                        reinterpret_cast<Ts *>(archetype->Column(chunk, columns[I]))...);
+                }(std::index_sequence_for<Ts...>());
+            }
+        }
+    }
+
+    template <typename...Ts, typename Func>
+    void World::ParallelEach(JobSystem &jobs, Func &&func)
+    {
+        static_assert(sizeof...(Ts) > 0, "Query must have at least one component type");
+        static_assert(!(SparseComponent<std::remove_const_t<Ts>> || ...),
+            "ParallelEach takes component types stored in archetypes only");
+
+        const ComponentType *types[] = { &ComponentTypeOf<std::remove_const_t<Ts>>()... };
+        std::array<int, sizeof...(Ts)> columns;
+
+        const QueryScope scope(iterating);
+        JobCounter counter;
+        for (const auto &archetype : archetypes)
+        {
+            if (archetype->Size() == 0 || !Match(*archetype, types, columns.data(), sizeof...(Ts)))
+                continue;
+
+            for (size_t chunk = 0, count = archetype->ChunkCount(); chunk < count; ++chunk)
+            {
+                jobs.Run([&func, archetype = archetype.get(), chunk, columns]() {
+                    [&]<size_t...I>(std::index_sequence<I...>) {
+                        const Entity *entities = archetype->Entities(chunk);
+                        const auto arrays = std::make_tuple(
+                            reinterpret_cast<Ts *>(archetype->Column(chunk, columns[I]))...);
+
+                        for (size_t i = 0, size = archetype->ChunkSize(chunk); i < size; ++i)
+                        {
+                            if constexpr (std::is_invocable_v<Func &, Entity, Ts &...>)
+                                func(entities[i], std::get<I>(arrays)[i]...);
+                            else
+                                func(std::get<I>(arrays)[i]...);
+                        }
+                    }(std::index_sequence_for<Ts...>());
+                }, &counter);
+            }
+        }
+
+        jobs.Wait(counter);
+    }
+
+    template <typename...Ts>
+    size_t World::Count() const
+    {
+        size_t count = 0;
+        if constexpr (!(SparseComponent<std::remove_const_t<Ts>> || ...))
+        {
+            const ComponentType *types[] = { &ComponentTypeOf<std::remove_const_t<Ts>>()... };
+            int columns[sizeof...(Ts)];
+            for (const auto &archetype : archetypes)
+            {
+                if (Match(*archetype, types, columns, sizeof...(Ts)))
+                    count += archetype->Size();
+            }
+        }
+        else
+        {
+            Query<const Ts...>([&count](Entity, const Ts &...) { ++count; });
+        }
+
+        return count;
+    }
+}
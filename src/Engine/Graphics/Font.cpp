@@ -7,8 +7,10 @@
 #include <Engine/Filesys/File.h>
 
 #include <Engine/Graphics/Window.h>
+#include <Engine/Graphics/RenderStats.h>
 #include <Engine/Graphics/RenderTarget.h>
 
+#include <cctype>
 #include <cstdarg>
 
 namespace SDG
@@ -104,6 +106,18 @@ namespace SDG
         NFont::Effect effect(nAlign, {scale.X(), scale.Y()}, {color.R(), color.G(), color.B(), color.A()});
 
         impl->font->draw(target->Target().Get(), position.X(), position.Y(), effect, "%s", str);
+
+        // NFont blits each visible glyph separately
+        size_t glyphs = 0;
+        for (const char *c = str; *c; ++c)
+        {
+            if (!std::isspace((unsigned char)*c) && ((unsigned char)*c & 0xC0) != 0x80)
+                ++glyphs;
+        }
+
+        RenderStats &stats = RenderStats::Frame();
+        stats.drawCalls += glyphs;
+        stats.vertices += glyphs * 4;
     }
 
     int Font::Spacing() const
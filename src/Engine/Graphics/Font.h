@@ -74,9 +74,11 @@ namespace SDG
         void Draw(class RenderTarget *target, Vector2 position, Vector2 scale,
             FontAlign alignment, Color color, const char *format, Args &&...args)
         {
-            auto out = std::string();
-            auto str = fmt::vformat_to(std::back_inserter(out), std::string_view(format), fmt::make_format_args(args...));
-            DrawImpl(target, position, scale, alignment, color, out.c_str());
+            // Inline buffer keeps short text off the heap
+            auto out = fmt::memory_buffer();
+            fmt::vformat_to(std::back_inserter(out), std::string_view(format), fmt::make_format_args(args...));
+            out.push_back('\0');
+            DrawImpl(target, position, scale, alignment, color, out.data());
         }
 
         // ========== Settings ================================================
@@ -0,0 +1,255 @@
+#include "NullRenderBackend.h"
+#include "Private/Conversions.h"
+#include "Private/TextureConversions.h"
+
+#include <SDL_gpu.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace SDG
+{
+    // ===== RenderLog ============================================================================
+    RenderLog::RenderLog() : commands(), counts(), lastImage(), textureSwitches(), vertices(), indices(),
+        bytesUploaded(), recordCommands(true)
+    {
+
+    }
+
+    void
+    RenderLog::Clear()
+    {
+        commands.clear();
+        std::fill(std::begin(counts), std::end(counts), 0);
+        lastImage = nullptr;
+        textureSwitches = 0;
+        vertices = 0;
+        indices = 0;
+        bytesUploaded = 0;
+    }
+
+    size_t
+    RenderLog::DrawCalls() const
+    {
+        return Count(RenderCommand::Type::Blit) + Count(RenderCommand::Type::TriangleBatch) +
+            Count(RenderCommand::Type::DrawRectangle) + Count(RenderCommand::Type::DrawCircle);
+    }
+
+    size_t
+    RenderLog::StateChanges() const
+    {
+        return Count(RenderCommand::Type::ActiveTarget) + Count(RenderCommand::Type::LoadMatrix) +
+            Count(RenderCommand::Type::TargetColor) + Count(RenderCommand::Type::UnsetTargetColor);
+    }
+
+    void
+    RenderLog::Add(RenderCommand::Type type, const GPU_Image *image, const GPU_Target *target, size_t size)
+    {
+        ++counts[(int)type];
+        if (type == RenderCommand::Type::UpdateImage)
+            bytesUploaded += size;
+
+        if (recordCommands)
+            commands.emplace_back(RenderCommand{ type, image, target, size });
+    }
+
+    void
+    RenderLog::AddDraw(RenderCommand::Type type, const GPU_Image *image, const GPU_Target *target,
+        size_t vertexCount, size_t indexCount)
+    {
+        if (image != lastImage && DrawCalls() > 0)
+            ++textureSwitches;
+        lastImage = image;
+
+        vertices += vertexCount;
+        indices += indexCount;
+        Add(type, image, target, type == RenderCommand::Type::TriangleBatch ? vertexCount : 0);
+    }
+
+    // ===== NullRenderBackend ====================================================================
+    NullRenderBackend::NullRenderBackend() : log(), activeTarget(), matrix{}, imageCount()
+    {
+        // Identity
+        matrix[0] = matrix[5] = matrix[10] = matrix[15] = 1.f;
+    }
+
+    NullRenderBackend::~NullRenderBackend() = default;
+
+    GPU_Target *
+    NullRenderBackend::CreateTarget(uint16_t width, uint16_t height)
+    {
+        auto target = new GPU_Target{};
+        target->w = target->base_w = width;
+        target->h = target->base_h = height;
+        target->viewport = GPU_Rect{ 0, 0, (float)width, (float)height };
+        target->color = SDL_Color{ 255, 255, 255, 255 };
+        target->refcount = 1;
+        return target;
+    }
+
+    void
+    NullRenderBackend::MakeCurrent(Window *context)
+    {
+        log.Add(RenderCommand::Type::MakeCurrent);
+    }
+
+    GPU_Target *
+    NullRenderBackend::ActiveTarget()
+    {
+        return activeTarget;
+    }
+
+    void
+    NullRenderBackend::ActiveTarget(GPU_Target *target)
+    {
+        activeTarget = target;
+        log.Add(RenderCommand::Type::ActiveTarget, nullptr, target);
+    }
+
+    const float *
+    NullRenderBackend::CurrentMatrix()
+    {
+        return matrix;
+    }
+
+    void
+    NullRenderBackend::LoadMatrix(const float *matrix)
+    {
+        std::memcpy(this->matrix, matrix, sizeof(this->matrix));
+        log.Add(RenderCommand::Type::LoadMatrix);
+    }
+
+    void
+    NullRenderBackend::TargetColor(GPU_Target *target, Color color)
+    {
+        if (target)
+        {
+            target->use_color = true;
+            target->color = Conv::ToSDLColor(color);
+        }
+
+        log.Add(RenderCommand::Type::TargetColor, nullptr, target);
+    }
+
+    void
+    NullRenderBackend::UnsetTargetColor(GPU_Target *target)
+    {
+        if (target)
+        {
+            target->use_color = false;
+            target->color = SDL_Color{ 255, 255, 255, 255 };
+        }
+
+        log.Add(RenderCommand::Type::UnsetTargetColor, nullptr, target);
+    }
+
+    void
+    NullRenderBackend::Clear(GPU_Target *target, Color color)
+    {
+        log.Add(RenderCommand::Type::Clear, nullptr, target);
+    }
+
+    void
+    NullRenderBackend::SwapBuffers(GPU_Target *target)
+    {
+        log.Add(RenderCommand::Type::SwapBuffers, nullptr, target);
+    }
+
+    void
+    NullRenderBackend::FreeTarget(GPU_Target *target)
+    {
+        if (activeTarget == target)
+            activeTarget = nullptr;
+
+        log.Add(RenderCommand::Type::FreeTarget, nullptr, target);
+        delete target;
+    }
+
+    void
+    NullRenderBackend::Blit(const GPU_Image *image, const FRectangle &src, GPU_Target *target,
+        const FRectangle &dest, float rotation, const Vector2 &anchor, Flip flip)
+    {
+        log.AddDraw(RenderCommand::Type::Blit, image, target, 4, 6);
+    }
+
+    void
+    NullRenderBackend::TriangleBatch(const GPU_Image *image, GPU_Target *target, const void *vertices,
+        size_t vertexCount, const uint16_t *indices, size_t indexCount)
+    {
+        log.AddDraw(RenderCommand::Type::TriangleBatch, image, target, vertexCount, indexCount);
+    }
+
+    void
+    NullRenderBackend::DrawRectangle(GPU_Target *target, const FRectangle &rect, Color color)
+    {
+        log.AddDraw(RenderCommand::Type::DrawRectangle, nullptr, target, 0, 0);
+    }
+
+    void
+    NullRenderBackend::DrawCircle(GPU_Target *target, const Circle &circle, Color color)
+    {
+        log.AddDraw(RenderCommand::Type::DrawCircle, nullptr, target, 0, 0);
+    }
+
+    GPU_Image *
+    NullRenderBackend::CreateImage(uint16_t width, uint16_t height)
+    {
+        auto image = new GPU_Image{};
+        image->w = image->base_w = image->texture_w = width;
+        image->h = image->base_h = image->texture_h = height;
+        image->format = GPU_FORMAT_RGBA;
+        image->num_layers = 1;
+        image->bytes_per_pixel = 4;
+        image->color = SDL_Color{ 255, 255, 255, 255 };
+        image->use_blending = true;
+        image->filter_mode = GPU_FILTER_LINEAR;
+        image->snap_mode = GPU_SNAP_POSITION_AND_DIMENSIONS;
+        image->wrap_mode_x = image->wrap_mode_y = GPU_WRAP_NONE;
+        image->refcount = 1;
+
+        ++imageCount;
+        log.Add(RenderCommand::Type::CreateImage, image);
+        return image;
+    }
+
+    void
+    NullRenderBackend::UpdateImage(GPU_Image *image, const Rectangle &rect, const uint8_t *pixels, int bytesPerRow)
+    {
+        log.Add(RenderCommand::Type::UpdateImage, image, nullptr, (size_t)bytesPerRow * rect.Height());
+    }
+
+    GPU_Image *
+    NullRenderBackend::CopyImage(const GPU_Image *image)
+    {
+        auto copy = new GPU_Image(*image);
+        copy->target = nullptr;
+        copy->refcount = 1;
+
+        ++imageCount;
+        log.Add(RenderCommand::Type::CopyImage, copy);
+        return copy;
+    }
+
+    void
+    NullRenderBackend::FreeImage(GPU_Image *image)
+    {
+        log.Add(RenderCommand::Type::FreeImage, image);
+        --imageCount;
+        delete image;
+    }
+
+    void
+    NullRenderBackend::ImageFilter(GPU_Image *image, Texture::Filter filter)
+    {
+        image->filter_mode = Conv::ToGPUFilter(filter);
+        log.Add(RenderCommand::Type::ImageFilter, image);
+    }
+
+    void
+    NullRenderBackend::ImageWrap(GPU_Image *image, Texture::Wrap wrapX, Texture::Wrap wrapY)
+    {
+        image->wrap_mode_x = Conv::ToGPUWrap(wrapX);
+        image->wrap_mode_y = Conv::ToGPUWrap(wrapY);
+        log.Add(RenderCommand::Type::ImageWrap, image);
+    }
+}
@@ -0,0 +1,154 @@
+/*!
+ * @file NullRenderBackend.h
+ * @namespace SDG
+ * @class NullRenderBackend
+ * RenderBackend that draws nothing and needs no graphics context. Each call is recorded into a RenderLog
+ * instead, so render paths can be tested and benchmarked on headless machines, and their draw calls,
+ * state changes and uploads inspected.
+ *
+ * Images and targets it creates are plain placeholders holding only their sizes and settings.
+ *
+ * @example
+ * NullRenderBackend backend;
+ * RenderBackend::Current(&backend);
+ * RenderTarget target(backend.CreateTarget(640, 480));
+ * // ... render with SpriteBatch, passing nullptr as the Window context
+ * REQUIRE(backend.Log().DrawCalls() == 1);
+ * RenderBackend::Current(nullptr);
+ */
+#pragma once
+#include "RenderBackend.h"
+
+#include <Engine/Lib/ClassMacros.h>
+
+#include <vector>
+
+namespace SDG
+{
+    /// One call received by a NullRenderBackend
+    struct RenderCommand
+    {
+        enum class Type
+        {
+            MakeCurrent,
+            ActiveTarget,
+            LoadMatrix,
+            TargetColor,
+            UnsetTargetColor,
+            Clear,
+            SwapBuffers,
+            FreeTarget,
+            Blit,
+            TriangleBatch,
+            DrawRectangle,
+            DrawCircle,
+            CreateImage,
+            UpdateImage,
+            CopyImage,
+            FreeImage,
+            ImageFilter,
+            ImageWrap,
+
+            Count ///< number of command types, not a command
+        };
+
+        Type              type;
+        const GPU_Image  *image;
+        const GPU_Target *target;
+        /// Vertices for TriangleBatch, bytes for UpdateImage, otherwise 0
+        size_t            size;
+    };
+
+    /// Calls recorded by a NullRenderBackend, with running totals
+    class RenderLog
+    {
+    public:
+        RenderLog();
+
+        /// Removes all commands and resets totals. Keeps reserved memory.
+        void Clear();
+
+        /// Whether each command is kept, or only the totals. On by default; turn off for long benchmarks.
+        void RecordCommands(bool record) { recordCommands = record; }
+        [[nodiscard]] bool RecordCommands() const { return recordCommands; }
+
+        [[nodiscard]] const std::vector<RenderCommand> &Commands() const { return commands; }
+
+        /// Number of commands of a type
+        [[nodiscard]] size_t Count(RenderCommand::Type type) const { return counts[(int)type]; }
+        /// Number of calls that draw: blits, triangle batches, rectangles and circles
+        [[nodiscard]] size_t DrawCalls() const;
+        /// Number of target, matrix and target color changes
+        [[nodiscard]] size_t StateChanges() const;
+        /// Number of image changes between consecutive draw calls
+        [[nodiscard]] size_t TextureSwitches() const { return textureSwitches; }
+        /// Vertices submitted, counting 4 for each blit
+        [[nodiscard]] size_t Vertices() const { return vertices; }
+        [[nodiscard]] size_t Indices() const { return indices; }
+        /// Bytes of pixel data uploaded to images
+        [[nodiscard]] size_t BytesUploaded() const { return bytesUploaded; }
+
+        void Add(RenderCommand::Type type, const GPU_Image *image = nullptr, const GPU_Target *target = nullptr,
+            size_t size = 0);
+        /// Adds a draw call, tracking texture switches
+        void AddDraw(RenderCommand::Type type, const GPU_Image *image, const GPU_Target *target,
+            size_t vertexCount, size_t indexCount);
+    private:
+        std::vector<RenderCommand> commands;
+        size_t counts[(int)RenderCommand::Type::Count];
+        const GPU_Image *lastImage;
+        size_t textureSwitches;
+        size_t vertices;
+        size_t indices;
+        size_t bytesUploaded;
+        bool recordCommands;
+    };
+
+    class NullRenderBackend : public RenderBackend
+    {
+        SDG_NOCOPY(NullRenderBackend);
+    public:
+        NullRenderBackend();
+        ~NullRenderBackend() override;
+
+        /// Creates a placeholder target, for use with RenderTarget. Freed by RenderTarget::Close.
+        GPU_Target *CreateTarget(uint16_t width, uint16_t height);
+
+        [[nodiscard]] RenderLog &Log() { return log; }
+        [[nodiscard]] const RenderLog &Log() const { return log; }
+
+        /// Number of images created and not yet freed
+        [[nodiscard]] size_t ImageCount() const { return imageCount; }
+
+        void MakeCurrent(Window *context) override;
+
+        GPU_Target *ActiveTarget() override;
+        void ActiveTarget(GPU_Target *target) override;
+        const float *CurrentMatrix() override;
+        void LoadMatrix(const float *matrix) override;
+        void TargetColor(GPU_Target *target, Color color) override;
+        void UnsetTargetColor(GPU_Target *target) override;
+        void Clear(GPU_Target *target, Color color) override;
+        void SwapBuffers(GPU_Target *target) override;
+        void FreeTarget(GPU_Target *target) override;
+
+        void Blit(const GPU_Image *image, const FRectangle &src, GPU_Target *target, const FRectangle &dest,
+            float rotation, const Vector2 &anchor, Flip flip) override;
+        void TriangleBatch(const GPU_Image *image, GPU_Target *target, const void *vertices,
+            size_t vertexCount, const uint16_t *indices, size_t indexCount) override;
+        void DrawRectangle(GPU_Target *target, const FRectangle &rect, Color color) override;
+        void DrawCircle(GPU_Target *target, const Circle &circle, Color color) override;
+
+        GPU_Image *CreateImage(uint16_t width, uint16_t height) override;
+        void UpdateImage(GPU_Image *image, const Rectangle &rect, const uint8_t *pixels, int bytesPerRow) override;
+        GPU_Image *CopyImage(const GPU_Image *image) override;
+        void FreeImage(GPU_Image *image) override;
+        void ImageFilter(GPU_Image *image, Texture::Filter filter) override;
+        void ImageWrap(GPU_Image *image, Texture::Wrap wrapX, Texture::Wrap wrapY) override;
+    private:
+        RenderLog   log;
+        GPU_Target *activeTarget;
+        float       matrix[16];
+        size_t      imageCount;
+    };
+}
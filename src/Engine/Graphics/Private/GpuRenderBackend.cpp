@@ -0,0 +1,144 @@
+#include "GpuRenderBackend.h"
+#include "Conversions.h"
+#include "TextureConversions.h"
+#include "TranslateFlip.h"
+
+#include <Engine/Exceptions/NullReferenceException.h>
+#include <Engine/Graphics/Window.h>
+#include <Engine/Math/Private/Conversions.h>
+
+#include <SDL_gpu.h>
+
+namespace SDG
+{
+    void
+    GpuRenderBackend::MakeCurrent(Window *context)
+    {
+        if (!context)
+            throw NullReferenceException();
+        context->MakeCurrent();
+    }
+
+    GPU_Target *
+    GpuRenderBackend::ActiveTarget()
+    {
+        return GPU_GetActiveTarget();
+    }
+
+    void
+    GpuRenderBackend::ActiveTarget(GPU_Target *target)
+    {
+        GPU_SetActiveTarget(target);
+    }
+
+    const float *
+    GpuRenderBackend::CurrentMatrix()
+    {
+        return GPU_GetCurrentMatrix();
+    }
+
+    void
+    GpuRenderBackend::LoadMatrix(const float *matrix)
+    {
+        GPU_LoadMatrix(matrix);
+    }
+
+    void
+    GpuRenderBackend::TargetColor(GPU_Target *target, Color color)
+    {
+        GPU_SetTargetColor(target, Conv::ToSDLColor(color));
+    }
+
+    void
+    GpuRenderBackend::UnsetTargetColor(GPU_Target *target)
+    {
+        GPU_UnsetTargetColor(target);
+    }
+
+    void
+    GpuRenderBackend::Clear(GPU_Target *target, Color color)
+    {
+        GPU_ClearColor(target, Conv::ToSDLColor(color));
+    }
+
+    void
+    GpuRenderBackend::SwapBuffers(GPU_Target *target)
+    {
+        GPU_Flip(target);
+    }
+
+    void
+    GpuRenderBackend::FreeTarget(GPU_Target *target)
+    {
+        GPU_FreeTarget(target);
+    }
+
+    void
+    GpuRenderBackend::Blit(const GPU_Image *image, const FRectangle &src, GPU_Target *target,
+        const FRectangle &dest, float rotation, const Vector2 &anchor, Flip flip)
+    {
+        GPU_Rect gpuSrc = Conv::ToGPURect(src);
+        GPU_Rect gpuDest = Conv::ToGPURect(dest);
+        GPU_BlitRectX((GPU_Image *)image, &gpuSrc, target, &gpuDest, rotation,
+            anchor.X(), anchor.Y(), TranslateFlip[(int)flip]);
+    }
+
+    void
+    GpuRenderBackend::TriangleBatch(const GPU_Image *image, GPU_Target *target, const void *vertices,
+        size_t vertexCount, const uint16_t *indices, size_t indexCount)
+    {
+        GPU_TriangleBatchX((GPU_Image *)image, target,
+            (unsigned short)vertexCount, (void *)vertices,
+            (unsigned int)indexCount, (unsigned short *)indices,
+            GPU_BATCH_XY_ST_RGBA8);
+    }
+
+    void
+    GpuRenderBackend::DrawRectangle(GPU_Target *target, const FRectangle &rect, Color color)
+    {
+        GPU_Rectangle2(target, Conv::ToGPURect(rect), Conv::ToSDLColor(color));
+    }
+
+    void
+    GpuRenderBackend::DrawCircle(GPU_Target *target, const Circle &circle, Color color)
+    {
+        GPU_CircleFilled(target, circle.X(), circle.Y(), circle.Radius(), Conv::ToSDLColor(color));
+    }
+
+    GPU_Image *
+    GpuRenderBackend::CreateImage(uint16_t width, uint16_t height)
+    {
+        return GPU_CreateImage(width, height, GPU_FORMAT_RGBA);
+    }
+
+    void
+    GpuRenderBackend::UpdateImage(GPU_Image *image, const Rectangle &rect, const uint8_t *pixels, int bytesPerRow)
+    {
+        GPU_Rect gpuRect = Conv::ToGPURect(rect);
+        GPU_UpdateImageBytes(image, &gpuRect, pixels, bytesPerRow);
+    }
+
+    GPU_Image *
+    GpuRenderBackend::CopyImage(const GPU_Image *image)
+    {
+        return GPU_CopyImage((GPU_Image *)image);
+    }
+
+    void
+    GpuRenderBackend::FreeImage(GPU_Image *image)
+    {
+        GPU_FreeImage(image);
+    }
+
+    void
+    GpuRenderBackend::ImageFilter(GPU_Image *image, Texture::Filter filter)
+    {
+        GPU_SetImageFilter(image, Conv::ToGPUFilter(filter));
+    }
+
+    void
+    GpuRenderBackend::ImageWrap(GPU_Image *image, Texture::Wrap wrapX, Texture::Wrap wrapY)
+    {
+        GPU_SetWrapMode(image, Conv::ToGPUWrap(wrapX), Conv::ToGPUWrap(wrapY));
+    }
+}
@@ -0,0 +1,39 @@
+/* =============================================================================
+ * GpuRenderBackend
+ * Default RenderBackend, forwarding each call to SDL_gpu
+ * ===========================================================================*/
+#pragma once
+#include "../RenderBackend.h"
+
+namespace SDG
+{
+    class GpuRenderBackend : public RenderBackend
+    {
+    public:
+        void MakeCurrent(Window *context) override;
+
+        GPU_Target *ActiveTarget() override;
+        void ActiveTarget(GPU_Target *target) override;
+        const float *CurrentMatrix() override;
+        void LoadMatrix(const float *matrix) override;
+        void TargetColor(GPU_Target *target, Color color) override;
+        void UnsetTargetColor(GPU_Target *target) override;
+        void Clear(GPU_Target *target, Color color) override;
+        void SwapBuffers(GPU_Target *target) override;
+        void FreeTarget(GPU_Target *target) override;
+
+        void Blit(const GPU_Image *image, const FRectangle &src, GPU_Target *target, const FRectangle &dest,
+            float rotation, const Vector2 &anchor, Flip flip) override;
+        void TriangleBatch(const GPU_Image *image, GPU_Target *target, const void *vertices,
+            size_t vertexCount, const uint16_t *indices, size_t indexCount) override;
+        void DrawRectangle(GPU_Target *target, const FRectangle &rect, Color color) override;
+        void DrawCircle(GPU_Target *target, const Circle &circle, Color color) override;
+
+        GPU_Image *CreateImage(uint16_t width, uint16_t height) override;
+        void UpdateImage(GPU_Image *image, const Rectangle &rect, const uint8_t *pixels, int bytesPerRow) override;
+        GPU_Image *CopyImage(const GPU_Image *image) override;
+        void FreeImage(GPU_Image *image) override;
+        void ImageFilter(GPU_Image *image, Texture::Filter filter) override;
+        void ImageWrap(GPU_Image *image, Texture::Wrap wrapX, Texture::Wrap wrapY) override;
+    };
+}
@@ -0,0 +1,50 @@
+/* =============================================================================
+ * TextureConversions
+ * Conversions between Texture settings and their SDL_gpu equivalents
+ * ===========================================================================*/
+#pragma once
+#include "../Texture.h"
+
+#include <Engine/Exceptions/InvalidArgumentException.h>
+#include <Engine/Exceptions/UncaughtCaseException.h>
+
+#include <SDL_gpu.h>
+
+namespace SDG::Conv
+{
+    inline GPU_FilterEnum ToGPUFilter(Texture::Filter mode)
+    {
+        switch (mode)
+        {
+        case Texture::Filter::Linear: return GPU_FILTER_LINEAR;
+        case Texture::Filter::LinearMipMap: return GPU_FILTER_LINEAR_MIPMAP;
+        case Texture::Filter::Nearest: return GPU_FILTER_NEAREST;
+        default:
+            throw InvalidArgumentException("Texture::FilterMode(Filter mode)", "mode");
+        }
+    }
+
+    inline GPU_WrapEnum ToGPUWrap(Texture::Wrap mode)
+    {
+        switch (mode)
+        {
+        case Texture::Wrap::None: return GPU_WRAP_NONE;
+        case Texture::Wrap::Repeat: return GPU_WRAP_REPEAT;
+        case Texture::Wrap::Mirror: return GPU_WRAP_MIRRORED;
+        default:
+            throw InvalidArgumentException("Private ToGPUWrapEnum(Texture::Wrap mode)", "mode");
+        }
+    }
+
+    inline Texture::Wrap ToTextureWrap(GPU_WrapEnum gpuWrap)
+    {
+        switch (gpuWrap)
+        {
+        case GPU_WRAP_NONE: return Texture::Wrap::None;
+        case GPU_WRAP_REPEAT: return Texture::Wrap::Repeat;
+        case GPU_WRAP_MIRRORED: return Texture::Wrap::Mirror;
+        default:
+            throw UncaughtCaseException("missing GPU_WRAP_* enum conversion case");
+        }
+    }
+}
@@ -0,0 +1,20 @@
+#include "RenderBackend.h"
+#include "Private/GpuRenderBackend.h"
+
+namespace SDG
+{
+    static GpuRenderBackend gpuBackend;
+    static RenderBackend *currentBackend = &gpuBackend;
+
+    RenderBackend &
+    RenderBackend::Current()
+    {
+        return *currentBackend;
+    }
+
+    void
+    RenderBackend::Current(RenderBackend *backend)
+    {
+        currentBackend = backend ? backend : &gpuBackend;
+    }
+}
@@ -0,0 +1,93 @@
+/*!
+ * @file RenderBackend.h
+ * @namespace SDG
+ * @class RenderBackend
+ * Low-level calls made by the graphics classes to draw, change render state, and manage images.
+ * The default backend calls into SDL_gpu. Swapping in another one, such as NullRenderBackend, lets the
+ * rendering stack run without a graphics context, e.g. for tests and benchmarks on headless machines.
+ *
+ * Covers the per-frame paths of SpriteBatch, StaticBatch, RenderTarget and Texture pixel uploads.
+ * Window creation, shaders and image file loading still require SDL_gpu.
+ */
+#pragma once
+#include "Color.h"
+#include "Flip.h"
+#include "Texture.h"
+
+#include <Engine/Math/Circle.h>
+#include <Engine/Math/Rectangle.h>
+#include <Engine/Math/Vector2.h>
+
+#include "Private/GPU_Target_Fwd.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SDG
+{
+    class RenderBackend
+    {
+    public:
+        virtual ~RenderBackend() = default;
+
+        /// Gets the backend used by the graphics classes. SDL_gpu by default.
+        static RenderBackend &Current();
+
+        /// Sets the backend used by the graphics classes.
+        /// Only switch while no images or targets created by the last backend are alive.
+        /// @param backend - backend to use, or nullptr to restore the SDL_gpu backend. Not owned.
+        static void Current(RenderBackend *backend);
+
+        // ===== Context & state ==============================================
+
+        /// Makes a window's context current, so that images are created for it
+        virtual void MakeCurrent(class Window *context) = 0;
+
+        virtual GPU_Target *ActiveTarget() = 0;
+        virtual void ActiveTarget(GPU_Target *target) = 0;
+
+        /// Gets the current 4x4 transformation matrix
+        virtual const float *CurrentMatrix() = 0;
+        /// Copies a 4x4 matrix into the current transformation matrix
+        virtual void LoadMatrix(const float *matrix) = 0;
+
+        /// Sets the color that modulates everything drawn to a target
+        virtual void TargetColor(GPU_Target *target, Color color) = 0;
+        /// Stops modulating what is drawn to a target
+        virtual void UnsetTargetColor(GPU_Target *target) = 0;
+
+        virtual void Clear(GPU_Target *target, Color color) = 0;
+        virtual void SwapBuffers(GPU_Target *target) = 0;
+        virtual void FreeTarget(GPU_Target *target) = 0;
+
+        // ===== Drawing ======================================================
+
+        /// Draws part of an image, rotated about an anchor in source pixels
+        virtual void Blit(const GPU_Image *image, const FRectangle &src, GPU_Target *target, const FRectangle &dest,
+            float rotation, const Vector2 &anchor, Flip flip) = 0;
+
+        /// Draws indexed triangles from interleaved vertices of 2D position, texture coordinates and 8-bit color
+        /// (SDL_gpu's GPU_BATCH_XY_ST_RGBA8 layout, 20 bytes per vertex)
+        virtual void TriangleBatch(const GPU_Image *image, GPU_Target *target, const void *vertices,
+            size_t vertexCount, const uint16_t *indices, size_t indexCount) = 0;
+
+        /// Draws the outline of a rectangle
+        virtual void DrawRectangle(GPU_Target *target, const FRectangle &rect, Color color) = 0;
+        /// Draws a filled circle
+        virtual void DrawCircle(GPU_Target *target, const Circle &circle, Color color) = 0;
+
+        // ===== Images =======================================================
+
+        /// Creates an empty 32-bit RGBA image
+        /// @returns the image, or nullptr on failure
+        virtual GPU_Image *CreateImage(uint16_t width, uint16_t height) = 0;
+        /// Copies RGBA pixels into a region of an image
+        virtual void UpdateImage(GPU_Image *image, const Rectangle &rect, const uint8_t *pixels, int bytesPerRow) = 0;
+        /// @returns the copy, or nullptr on failure
+        virtual GPU_Image *CopyImage(const GPU_Image *image) = 0;
+        virtual void FreeImage(GPU_Image *image) = 0;
+
+        virtual void ImageFilter(GPU_Image *image, Texture::Filter filter) = 0;
+        virtual void ImageWrap(GPU_Image *image, Texture::Wrap wrapX, Texture::Wrap wrapY) = 0;
+    };
+}
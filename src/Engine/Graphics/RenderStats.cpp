@@ -0,0 +1,23 @@
+#include "RenderStats.h"
+
+namespace SDG
+{
+    RenderStats::RenderStats() : drawCalls(), sprites(), vertices(), targetChanges(), matrixLoads(),
+        colorChanges(), textureChanges(), batchBreaks(), culled(), sortSeconds(), submitSeconds()
+    {
+
+    }
+
+    void
+    RenderStats::Reset()
+    {
+        *this = RenderStats();
+    }
+
+    RenderStats &
+    RenderStats::Frame()
+    {
+        static RenderStats frame;
+        return frame;
+    }
+}
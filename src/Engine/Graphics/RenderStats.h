@@ -0,0 +1,50 @@
+/*!
+ * @file RenderStats.h
+ * @namespace SDG
+ * @class RenderStats
+ * Counts of the rendering work done in a frame, for tuning batching. Filled by SpriteBatch, StaticBatch,
+ * RenderTarget and Font as they render, and reset by Engine after each frame. Engine::FrameStats gets the
+ * totals of the last completed frame.
+ * Only the rendering thread writes to it.
+ */
+#pragma once
+#include <cstddef>
+
+namespace SDG
+{
+    struct RenderStats
+    {
+        RenderStats();
+
+        /// Calls that draw: blits, triangle batches, shapes and text
+        size_t drawCalls;
+        /// Sprites drawn by SpriteBatch and StaticBatch
+        size_t sprites;
+        /// Vertices submitted by triangle batches, and 4 per blit
+        size_t vertices;
+        /// Active target changes
+        size_t targetChanges;
+        /// Matrix loads
+        size_t matrixLoads;
+        /// Target color sets and unsets
+        size_t colorChanges;
+        /// Texture changes between consecutive batched draw calls
+        size_t textureChanges;
+        /// Triangle batches a SpriteBatch started after the first of each End, due to texture changes or
+        /// full vertex buffers
+        size_t batchBreaks;
+        /// Draws rejected by SpriteBatch culling
+        size_t culled;
+
+        /// CPU time SpriteBatch spent sorting, in seconds
+        double sortSeconds;
+        /// CPU time spent sending batched draws to the RenderBackend, in seconds
+        double submitSeconds;
+
+        /// Sets all counts and times to zero
+        void Reset();
+
+        /// Stats of the frame in progress
+        static RenderStats &Frame();
+    };
+}
@@ -1,8 +1,9 @@
 /// RenderTarget implementation file
 #include "RenderTarget.h"
 
-#include "Private/TranslateFlip.h"
 #include "Private/Conversions.h"
+#include "RenderBackend.h"
+#include "RenderStats.h"
 #include "Texture.h"
 
 #include <Engine/Math/Private/Conversions.h>
@@ -80,7 +81,7 @@ namespace SDG
     {
         if (target)
         {
-            GPU_FreeTarget(target);
+            RenderBackend::Current().FreeTarget(target);
             target = nullptr;
         }
     }
@@ -94,19 +95,20 @@ namespace SDG
     void
     RenderTarget::Clear(SDG::Color color)
     {
-        GPU_ClearColor(target, {color.R(), color.G(), color.B(), color.A()});
+        RenderBackend::Current().Clear(target, color);
     }
 
     void
     RenderTarget::SwapBuffers()
     {
-        GPU_Flip(target);
+        RenderBackend::Current().SwapBuffers(target);
     }
 
     RenderTarget &
     RenderTarget::DrawColor(SDG::Color color)
     {
-        GPU_SetTargetColor(target, Conv::ToSDLColor(color));
+        RenderBackend::Current().TargetColor(target, color);
+        ++RenderStats::Frame().colorChanges;
         return *this;
     }
 
@@ -114,32 +116,29 @@ namespace SDG
     RenderTarget::DrawTexture(Ref<Texture> texture, Rectangle src, FRectangle dest,
                               float rotation, Vector2 anchor, Flip flip)
     {
-        // Create rects
-        GPU_Rect gpuSrc = Conv::ToGPURect(src);
-        GPU_Rect gpuDest = Conv::ToGPURect(dest);
+        RenderBackend::Current().Blit(texture->Image(), (FRectangle)src, target, dest, rotation, anchor, flip);
 
-        // Blit to the current target
-        GPU_BlitRectX((GPU_Image *)texture->Image(), &gpuSrc, target,
-                      &gpuDest, rotation, anchor.X(), anchor.Y(),
-                      TranslateFlip[(int)flip]);
+        RenderStats &stats = RenderStats::Frame();
+        ++stats.drawCalls;
+        stats.vertices += 4;
     }
 
     auto RenderTarget::DrawRectangle(FRectangle rect) -> void
     {
-        GPU_Rectangle2(target,
-                       Conv::ToGPURect(rect),
-                       target->color);
+        RenderBackend::Current().DrawRectangle(target, rect, Conv::ToSDGColor(target->color));
+        ++RenderStats::Frame().drawCalls;
     }
 
     auto RenderTarget::DrawCircle(Circle circle) -> void
     {
-        GPU_CircleFilled(target, circle.X(), circle.Y(), circle.Radius(),
-            target->color);
+        RenderBackend::Current().DrawCircle(target, circle, Conv::ToSDGColor(target->color));
+        ++RenderStats::Frame().drawCalls;
     }
 
     auto RenderTarget::MakeActiveTarget() -> void
     {
-        GPU_SetActiveTarget(target);
+        RenderBackend::Current().ActiveTarget(target);
+        ++RenderStats::Frame().targetChanges;
     }
 
     auto RenderTarget::IsOpen() const -> bool
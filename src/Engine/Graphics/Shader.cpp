@@ -53,9 +53,10 @@ namespace SDG
 
     struct Shader::Impl
     {
-        Impl() : program(), block() { }
+        Impl() : program(), block(), vertexPath(), fragPath() { }
         uint32_t program;
         GPU_ShaderBlock block;
+        Path vertexPath, fragPath; ///< files last compiled from, for Reload
     };
 
     Shader::Shader() : impl(new Impl)
@@ -110,17 +111,47 @@ namespace SDG
         GPU_FreeShader(vertShader);
         GPU_FreeShader(fragShader);
 
-        auto shaderBlock = GPU_LoadShaderBlock(impl->program,
+        auto shaderBlock = GPU_LoadShaderBlock(shaderProgram,
                 "gpu_Vertex",                // position name
                 "gpu_TexCoord",             // texcoord name
                 "gpu_Color",                   // color name
                 "gpu_ModelViewProjectionMatrix"); // modelViewMatrix name
 
+        // Replace the program only once the new one links, so a failed recompile keeps the old one in use
+        Close();
         impl->program = shaderProgram;
         impl->block = shaderBlock;
+        impl->vertexPath = vertexPath;
+        impl->fragPath = fragPath;
         return true;
     }
 
+    bool
+    Shader::Reload()
+    {
+        if (impl->vertexPath.Empty() || impl->fragPath.Empty())
+        {
+            SDG_Core_Err("Shader::Reload: shader was never compiled");
+            return false;
+        }
+
+        // Copies, since Compile reassigns them
+        const Path vertexPath = impl->vertexPath, fragPath = impl->fragPath;
+        return Compile(vertexPath, fragPath);
+    }
+
+    const Path &
+    Shader::VertexPath() const
+    {
+        return impl->vertexPath;
+    }
+
+    const Path &
+    Shader::FragmentPath() const
+    {
+        return impl->fragPath;
+    }
+
     // Set Float Uniform
     Shader &
     Shader::SetUniform(const std::string &varId, float value)
@@ -21,7 +21,15 @@ namespace SDG
         /// EmplaceTarget a vector of floats to a shader uniform value
         Shader &SetUniform(const std::string &varId, std::vector<float> values, int elementsPerValue);
         uint32_t GetVarLocation(const std::string &varId) const;
+        /// Compiles and links the shader program, replacing the current one only if it succeeds
         bool Compile(const Path &vertexPath, const Path &fragPath);
+
+        /// Recompiles from the files last compiled, such as after they changed on disk. The Shader object stays the
+        /// same, so references to it remain valid, and the old program stays in use if compiling fails.
+        bool Reload();
+
+        [[nodiscard]] const Path &VertexPath() const;
+        [[nodiscard]] const Path &FragmentPath() const;
         void Close();
         void Activate();
         static void Deactivate();
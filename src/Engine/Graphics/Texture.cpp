@@ -1,5 +1,7 @@
 #include "Texture.h"
+#include "RenderBackend.h"
 #include "RenderTarget.h"
+#include "Private/TextureConversions.h"
 
 #include <Engine/Debug/Assert.h>
 #include <Engine/Debug/Log.h>
@@ -70,7 +72,7 @@ namespace SDG
         {
             if (image)
             {
-                GPU_FreeImage(image);
+                RenderBackend::Current().FreeImage(image);
                 image = nullptr;
                 path = Path();
             }
@@ -104,7 +106,7 @@ namespace SDG
     {
         if (tex.impl->image)
         {
-            auto image = GPU_CopyImage(tex.impl->image);
+            auto image = RenderBackend::Current().CopyImage(tex.impl->image);
             if (!image)
                 SDG_Core_Err("Failed to copy Texture: {}", GPU_PopErrorCode().details);
             impl->image = image;
@@ -120,7 +122,7 @@ namespace SDG
             Unload();
             if (tex.impl->image)
             {
-                auto image = GPU_CopyImage(tex.impl->image);
+                auto image = RenderBackend::Current().CopyImage(tex.impl->image);
                 if (!image)
                     SDG_Core_Err("Texture copy failed: {}", GPU_PopErrorCode().details);
                 impl->image = image;
@@ -221,17 +223,7 @@ namespace SDG
         if (!impl->image)
             throw NullReferenceException("Access violation on unloaded Texture");
 
-        GPU_FilterEnum gpuMode;
-        switch (mode)
-        {
-        case Filter::Linear: gpuMode = GPU_FILTER_LINEAR; break;
-        case Filter::LinearMipMap: gpuMode = GPU_FILTER_LINEAR_MIPMAP; break;
-        case Filter::Nearest: gpuMode = GPU_FILTER_NEAREST; break;
-        default:
-            throw InvalidArgumentException("Texture::FilterMode(Filter mode)", "mode");
-        }
-
-        GPU_SetImageFilter(impl->image, gpuMode);
+        RenderBackend::Current().ImageFilter(impl->image, mode);
 
         return *this;
     }
@@ -271,39 +263,12 @@ namespace SDG
         return *this;
     }
 
-    static Texture::Wrap ToTextureWrap(GPU_WrapEnum gpuWrap)
-    {
-        switch (gpuWrap)
-        {
-        case GPU_WRAP_NONE: return Texture::Wrap::None;
-        case GPU_WRAP_REPEAT: return Texture::Wrap::Repeat;
-        case GPU_WRAP_MIRRORED: return Texture::Wrap::Mirror;
-        default:
-            throw UncaughtCaseException("missing GPU_WRAP_* enum conversion case");
-        }
-    }
-
-    namespace Conv
-    {
-        static GPU_WrapEnum ToGPUWrap(Texture::Wrap mode)
-        {
-            switch (mode)
-            {
-            case Texture::Wrap::None: return GPU_WRAP_NONE;
-            case Texture::Wrap::Repeat: return GPU_WRAP_REPEAT;
-            case Texture::Wrap::Mirror: return GPU_WRAP_MIRRORED;
-            default:
-                throw InvalidArgumentException("Private ToGPUWrapEnum(Texture::Wrap mode)", "mode");
-            }
-        }
-    }
-
     Texture::Wrap Texture::WrapModeX() const
     {
         if (!impl->image)
             throw NullReferenceException("Access violation on unloaded Texture");
 
-        return ToTextureWrap(impl->image->wrap_mode_x);
+        return Conv::ToTextureWrap(impl->image->wrap_mode_x);
     }
 
     Texture::Wrap Texture::WrapModeY() const
@@ -311,7 +276,7 @@ namespace SDG
         if (!impl->image)
             throw NullReferenceException("Access violation on unloaded Texture");
 
-        return ToTextureWrap(impl->image->wrap_mode_y);
+        return Conv::ToTextureWrap(impl->image->wrap_mode_y);
     }
 
     Texture &Texture::WrapMode(Texture::Wrap x, Texture::Wrap y)
@@ -319,7 +284,7 @@ namespace SDG
         if (!impl->image)
             throw NullReferenceException("Access violation on unloaded Texture");
 
-        GPU_SetWrapMode(impl->image, Conv::ToGPUWrap(x), Conv::ToGPUWrap(y));
+        RenderBackend::Current().ImageWrap(impl->image, x, y);
         return *this;
     }
 
@@ -359,15 +324,15 @@ namespace SDG
     }
 
     bool 
-    Texture::LoadPixels(Window *context, uint32_t width, uint32_t height, const uint8_t *rgbaPixels)
+    Texture::LoadPixels(Window *context, uint32_t width, uint32_t height, const uint8_t *rgbaPixels,
+        const Path &path)
     {
-        if (!context)
-            throw NullReferenceException();
+        RenderBackend &backend = RenderBackend::Current();
 
         Unload();
-        
-        context->MakeCurrent();
-        GPU_Image *img = GPU_CreateImage(width, height, GPU_FORMAT_RGBA);
+
+        backend.MakeCurrent(context);
+        GPU_Image *img = backend.CreateImage((uint16_t)width, (uint16_t)height);
         if (!img)
         {
             throw RuntimeException(String::Format("SpriteBatch: failed to "
@@ -375,11 +340,11 @@ namespace SDG
         }
 
         img->bytes_per_pixel = 4; // one byte per channel
-        
-        GPU_Rect rect{ 0, 0, static_cast<float>(width), static_cast<float>(height) };
-        GPU_UpdateImageBytes(img, &rect, rgbaPixels, 4 * width);
+
+        backend.UpdateImage(img, Rectangle(0, 0, (int)width, (int)height), rgbaPixels, 4 * (int)width);
         
         impl->image = std::move(img);
+        impl->path = path;
         FilterMode(defFilterMode);
         SnapMode(defSnapMode);
         Anchor(defAnchor);
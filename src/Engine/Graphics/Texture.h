@@ -63,7 +63,12 @@ namespace SDG
         /// @param path - path that the surface was loaded from. Made optional since there is not always one.
         bool LoadFromSurface(class Window *context, SDL_Surface *surf, const Path &path = Path());
 
-        bool LoadPixels(class Window *context, uint32_t width, uint32_t height, const uint8_t *rgbaPixels);
+        /// Load an image from 32-bit RGBA pixels.
+        /// @param context - context to create texture with. May be null when the current RenderBackend needs no
+        /// context, such as NullRenderBackend.
+        /// @param path - path that the pixels were loaded from, if any
+        bool LoadPixels(class Window *context, uint32_t width, uint32_t height, const uint8_t *rgbaPixels,
+            const Path &path = Path());
 
         /// Unload the current texture. Affects all other instances of this Texture.
         void Unload();
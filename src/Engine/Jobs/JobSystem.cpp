@@ -0,0 +1,366 @@
+#include "JobSystem.h"
+#include <Engine/Debug/Assert.h>
+#include <Engine/Debug/Log.h>
+#include <Engine/Platform.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SDG
+{
+    /// Job system the calling thread is a worker of, and the index of its deque
+    static thread_local const void *threadSystem = nullptr;
+    static thread_local size_t threadQueue = 0;
+
+    struct JobSystem::Impl
+    {
+        struct Entry
+        {
+            Job job;
+            JobCounter *counter;
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Entry> entries;
+        };
+
+        Impl() : queues(), workers(), sleepMutex(), wake(), queued(0), stopping(false), mainMutex(), mainEntries()
+        {
+            queues.emplace_back(new Queue); // shared by threads that are not workers
+        }
+
+        /// Gets the deque of the calling thread
+        [[nodiscard]] size_t ThisQueue() const { return threadSystem == this ? threadQueue : 0; }
+
+        void Push(size_t queue, Entry entry);
+
+        /// Pops a job from the back of a thread's own deque, or steals one from the front of another's
+        /// @return whether a job was found
+        bool TryPop(size_t self, Entry &entry);
+
+        /// Pops the oldest main-thread job
+        /// @return whether there was one
+        bool TryPopMain(Entry &entry);
+
+        void Execute(Entry &entry);
+
+        /// Uncounts a finished job, and submits the jobs that were waiting on its counter if it was the last
+        void Finish(JobCounter &counter);
+
+        void WorkerMain(size_t index);
+
+        std::vector<std::unique_ptr<Queue>> queues; ///< [0] for threads that are not workers, then one per worker
+        std::vector<std::thread> workers;
+
+        std::mutex sleepMutex;                      ///< guards stopping, and idle workers' sleep
+        std::condition_variable wake;
+        std::atomic<long> queued;                   ///< jobs in all deques, counted just before they are pushed
+        bool stopping;
+
+        std::mutex mainMutex;                       ///< guards mainEntries
+        std::deque<Entry> mainEntries;              ///< jobs for the main thread, oldest first
+    };
+
+    void
+    JobSystem::Impl::Push(size_t queue, Entry entry)
+    {
+        queued.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(queues[queue]->mutex);
+            queues[queue]->entries.emplace_back(std::move(entry));
+        }
+
+        // Taking the lock orders the push before a sleeping worker's check of queued
+        { std::lock_guard lock(sleepMutex); }
+        wake.notify_one();
+    }
+
+    bool
+    JobSystem::Impl::TryPop(size_t self, Entry &entry)
+    {
+        if (queued.load(std::memory_order_relaxed) <= 0)
+            return false;
+
+        {
+            Queue &own = *queues[self];
+            std::lock_guard lock(own.mutex);
+            if (!own.entries.empty())
+            {
+                entry = std::move(own.entries.back());
+                own.entries.pop_back();
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        for (size_t i = 1; i < queues.size(); ++i)
+        {
+            Queue &victim = *queues[(self + i) % queues.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.entries.empty())
+            {
+                entry = std::move(victim.entries.front());
+                victim.entries.pop_front();
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool
+    JobSystem::Impl::TryPopMain(Entry &entry)
+    {
+        std::lock_guard lock(mainMutex);
+        if (mainEntries.empty())
+            return false;
+
+        entry = std::move(mainEntries.front());
+        mainEntries.pop_front();
+        return true;
+    }
+
+    void
+    JobSystem::Impl::Execute(Entry &entry)
+    {
+        try {
+            entry.job();
+        }
+        catch (...)
+        {
+            bool expected = false;
+            if (entry.counter && entry.counter->hasError.compare_exchange_strong(expected, true))
+            {
+                entry.counter->error = std::current_exception();
+            }
+            else if (!entry.counter)
+            {
+                try {
+                    throw;
+                }
+                catch (const std::exception &e)
+                {
+                    SDG_Core_Err("JobSystem: uncaught exception in job: {}", e.what());
+                }
+                catch (...)
+                {
+                    SDG_Core_Err("JobSystem: uncaught exception in job");
+                }
+            }
+        }
+
+        entry.job = nullptr;
+        if (entry.counter)
+            Finish(*entry.counter);
+    }
+
+    void
+    JobSystem::Impl::Finish(JobCounter &counter)
+    {
+        // The counter may be destroyed as soon as it reads done and its lock is free, so it is not touched after
+        std::vector<std::pair<Job, JobCounter *>> ready;
+        {
+            std::lock_guard lock(counter.mutex);
+            if (counter.pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                ready.swap(counter.continuations);
+        }
+
+        for (auto &[job, next] : ready)
+            Push(ThisQueue(), { std::move(job), next });
+    }
+
+    void
+    JobSystem::Impl::WorkerMain(size_t index)
+    {
+        threadSystem = this;
+        threadQueue = index;
+
+        Entry entry;
+        while (true)
+        {
+            if (TryPop(index, entry))
+            {
+                Execute(entry);
+                continue;
+            }
+
+            std::unique_lock lock(sleepMutex);
+            wake.wait(lock, [this]() { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+            if (stopping && queued.load(std::memory_order_relaxed) <= 0)
+                return;
+        }
+    }
+
+    JobSystem::JobSystem() : impl(new Impl), mainThread(std::this_thread::get_id())
+    {
+
+    }
+
+    JobSystem::~JobSystem()
+    {
+        Stop();
+        delete impl;
+    }
+
+    void
+    JobSystem::Start(unsigned workerCount)
+    {
+#if (SDG_TARGET_WEBGL)
+        // No worker threads without pthreads, so jobs run on the threads that wait on them
+        return;
+#endif
+        if (!impl->workers.empty())
+            return;
+
+        if (workerCount == 0)
+            workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+        // Worker deques are only added while no workers run, so the deque list is read without locking
+        for (unsigned i = 0; i < workerCount; ++i)
+            impl->queues.emplace_back(new Impl::Queue);
+        for (unsigned i = 0; i < workerCount; ++i)
+            impl->workers.emplace_back(&Impl::WorkerMain, impl, (size_t)i + 1);
+    }
+
+    void
+    JobSystem::Stop()
+    {
+        {
+            std::lock_guard lock(impl->sleepMutex);
+            impl->stopping = true;
+        }
+        impl->wake.notify_all();
+
+        for (auto &worker : impl->workers)
+            worker.join();
+        impl->workers.clear();
+
+        // Run what is left if there were no workers to
+        const bool onMainThread = IsMainThread();
+        Impl::Entry entry;
+        while (impl->TryPop(0, entry) || (onMainThread && impl->TryPopMain(entry)))
+            impl->Execute(entry);
+
+        impl->queues.resize(1);
+        impl->stopping = false;
+    }
+
+    void
+    JobSystem::Run(Job job, JobCounter *counter)
+    {
+        if (counter)
+            counter->pending.fetch_add(1, std::memory_order_relaxed);
+        impl->Push(impl->ThisQueue(), { std::move(job), counter });
+    }
+
+    void
+    JobSystem::RunAfter(JobCounter &dependency, Job job, JobCounter *counter)
+    {
+        if (counter)
+            counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+        {
+            std::lock_guard lock(dependency.mutex);
+            if (!dependency.IsDone())
+            {
+                dependency.continuations.emplace_back(std::move(job), counter);
+                return;
+            }
+        }
+
+        impl->Push(impl->ThisQueue(), { std::move(job), counter });
+    }
+
+    void
+    JobSystem::RunOnMainThread(Job job, JobCounter *counter)
+    {
+        if (counter)
+            counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard lock(impl->mainMutex);
+        impl->mainEntries.push_back({ std::move(job), counter });
+    }
+
+    void
+    JobSystem::PumpMainThread()
+    {
+        SDG_Assert(IsMainThread());
+
+        // Jobs submitted while pumping wait for the next pump, so a job that resubmits itself cannot stall the frame
+        std::deque<Impl::Entry> entries;
+        {
+            std::lock_guard lock(impl->mainMutex);
+            entries.swap(impl->mainEntries);
+        }
+
+        for (auto &entry : entries)
+            impl->Execute(entry);
+    }
+
+    void
+    JobSystem::ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)> &func)
+    {
+        if (count == 0)
+            return;
+        if (batchSize == 0)
+        {
+            const size_t batches = ((size_t)WorkerCount() + 1) * 4;
+            batchSize = std::max<size_t>((count + batches - 1) / batches, 1);
+        }
+
+        JobCounter counter;
+        for (size_t begin = 0; begin < count; begin += batchSize)
+        {
+            const size_t end = std::min(begin + batchSize, count);
+            Run([&func, begin, end]() { func(begin, end); }, &counter);
+        }
+
+        Wait(counter);
+    }
+
+    void
+    JobSystem::Wait(JobCounter &counter)
+    {
+        const size_t self = impl->ThisQueue();
+        const bool onMainThread = IsMainThread();
+        Impl::Entry entry;
+        while (!counter.IsDone())
+        {
+            if (impl->TryPop(self, entry) || (onMainThread && impl->TryPopMain(entry)))
+                impl->Execute(entry);
+            else
+                std::this_thread::yield();
+        }
+
+        // The job that finished the counter may still hold its lock
+        { std::lock_guard lock(counter.mutex); }
+
+        if (counter.hasError.load(std::memory_order_acquire))
+        {
+            std::exception_ptr error = std::move(counter.error);
+            counter.error = nullptr;
+            counter.hasError.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(error);
+        }
+    }
+
+    unsigned
+    JobSystem::WorkerCount() const
+    {
+        return (unsigned)impl->workers.size();
+    }
+
+    bool
+    JobSystem::IsWorkerThread() const
+    {
+        return threadSystem == impl && threadQueue != 0;
+    }
+}
@@ -0,0 +1,112 @@
+/* ====================================================================================================================
+ * @file JobSystem.h - SDG_Engine
+ *
+ * @class JobSystem
+ * Runs small jobs on a pool of worker threads. Each worker has its own deque of jobs: it pushes and pops jobs at the
+ * back, so jobs it spawns run hot in its cache, and steals from the front of other workers' deques when its own runs
+ * dry. Threads that are not workers, such as the main thread, submit to a deque of their own, and help run jobs while
+ * they wait on a JobCounter.
+ *
+ * Jobs may also run after the jobs of a counter finish, be split over an index range with ParallelFor, or be kept to
+ * the main thread, for work such as GL calls that may not run anywhere else. Main-thread jobs run when the main
+ * thread calls PumpMainThread, which Engine does once per frame, or while it waits on a counter.
+ *
+ * @class JobCounter
+ * Counts the jobs of a batch that have not finished yet, so they can be waited on together, or followed by other jobs.
+ * Wait on a counter before destroying it.
+ * ==================================================================================================================*/
+#pragma once
+#include <Engine/Lib/ClassMacros.h>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace SDG
+{
+    class JobCounter
+    {
+        SDG_NOCOPY(JobCounter);
+    public:
+        JobCounter() : pending(0), error(), hasError(false), mutex(), continuations() { }
+
+        /// Checks whether every job counted has finished
+        [[nodiscard]] bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+        /// Number of jobs counted that have not finished
+        [[nodiscard]] int Pending() const { return pending.load(std::memory_order_acquire); }
+    private:
+        friend class JobSystem;
+        std::atomic<int> pending;
+        std::exception_ptr error; ///< first exception thrown by a counted job, rethrown by JobSystem::Wait
+        std::atomic<bool> hasError;
+
+        std::mutex mutex;                                                      ///< guards continuations
+        std::vector<std::pair<std::function<void()>, JobCounter *>> continuations; ///< jobs to run once done
+    };
+
+    class JobSystem
+    {
+        SDG_NOCOPY(JobSystem);
+        struct Impl;
+    public:
+        using Job = std::function<void()>;
+
+        /// Creates a job system with no workers. Jobs run on threads that Wait, until Start is called.
+        /// The calling thread becomes the main thread.
+        JobSystem();
+        /// Stops the workers, after they finish the jobs that were submitted
+        ~JobSystem();
+
+        /// Starts the worker threads
+        /// @param workerCount - number of workers; 0 for one per hardware thread, less one for the main thread
+        void Start(unsigned workerCount = 0);
+
+        /// Runs every job submitted, then stops and joins the worker threads. Main-thread jobs left are run too, when
+        /// called from the main thread.
+        void Stop();
+
+        /// Submits a job to run on any worker.
+        /// @param counter - optional counter the job is counted by until it finishes. If the job throws, the
+        ///                  exception is rethrown by Wait on this counter; without a counter it is logged.
+        void Run(Job job, JobCounter *counter = nullptr);
+
+        /// Submits a job to run on any worker once every job counted by a dependency has finished, or right away if
+        /// they already have. The dependency must not be destroyed before it is done.
+        /// @param counter - optional counter the job is counted by from now until it finishes
+        void RunAfter(JobCounter &dependency, Job job, JobCounter *counter = nullptr);
+
+        /// Submits a job that only runs on the main thread, from PumpMainThread or Wait.
+        /// @param counter - optional counter the job is counted by until it finishes
+        void RunOnMainThread(Job job, JobCounter *counter = nullptr);
+
+        /// Runs the main-thread jobs submitted so far. Call from the main thread only.
+        void PumpMainThread();
+
+        /// Calls func(begin, end) over batches of the index range [0, count), across the workers and the calling
+        /// thread, and returns once every batch is done. Rethrows the first exception a batch threw.
+        /// @param batchSize - indices per batch; 0 to split the range into a few batches per thread
+        void ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)> &func);
+
+        /// Runs jobs on the calling thread until every job counted by a counter has finished.
+        /// Rethrows the first exception thrown by one of those jobs.
+        void Wait(JobCounter &counter);
+
+        /// Number of worker threads running
+        [[nodiscard]] unsigned WorkerCount() const;
+
+        /// Checks whether the calling thread is one of this job system's workers
+        [[nodiscard]] bool IsWorkerThread() const;
+
+        /// Checks whether the calling thread is the one that created this job system
+        [[nodiscard]] bool IsMainThread() const { return std::this_thread::get_id() == mainThread; }
+    private:
+        Impl *impl;
+        std::thread::id mainThread;
+    };
+}
@@ -2,6 +2,8 @@
 #include <Engine/Lib/RAIterator.h>
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 
 namespace SDG
@@ -32,4 +34,53 @@ namespace SDG
         for (It &it = begin; it != end; ++it)
             func(*it);
     }
+
+    /// Sorts unsigned 64-bit keys in ascending order with a stable least-significant-digit radix sort.
+    /// Byte positions where every key holds the same digit are skipped, so keys with unused high bits
+    /// sort in fewer passes.
+    /// @param keys    - keys to sort, holds the sorted result on return
+    /// @param scratch - buffer with room for at least count keys, used for intermediate passes
+    /// @param count   - number of keys
+    inline void RadixSort(uint64_t *keys, uint64_t *scratch, size_t count)
+    {
+        if (count < 2) return;
+
+        // Count every digit for all eight passes in one read
+        size_t histograms[8][256] = {};
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t key = keys[i];
+            for (int pass = 0; pass < 8; ++pass)
+                ++histograms[pass][(key >> (pass * 8)) & 0xFFu];
+        }
+
+        uint64_t *src = keys, *dest = scratch;
+        for (int pass = 0; pass < 8; ++pass)
+        {
+            size_t *offsets = histograms[pass];
+            int shift = pass * 8;
+
+            // All keys share this digit, nothing would move
+            if (offsets[(src[0] >> shift) & 0xFFu] == count)
+                continue;
+
+            size_t sum = 0;
+            for (size_t &offset : histograms[pass])
+            {
+                size_t digitCount = offset;
+                offset = sum;
+                sum += digitCount;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+                dest[offsets[(src[i] >> shift) & 0xFFu]++] = src[i];
+
+            uint64_t *temp = src;
+            src = dest;
+            dest = temp;
+        }
+
+        if (src != keys)
+            std::memcpy(keys, src, count * sizeof(uint64_t));
+    }
 }
@@ -0,0 +1,55 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace SDG::AllocationCounter
+{
+    static std::atomic<size_t> count;
+
+    size_t
+    Count()
+    {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    void
+    Reset()
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+
+    void
+    Add()
+    {
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+#if (SDG_COUNT_ALLOCATIONS)
+// Replacing the throwing forms is enough: the standard library's array and nothrow forms call them.
+// Over-aligned allocations keep the standard library's operators and are not counted.
+void *
+operator new(std::size_t bytes)
+{
+    void *block = std::malloc(bytes ? bytes : 1);
+    if (!block)
+        throw std::bad_alloc();
+
+    SDG_CountAllocation();
+    return block;
+}
+
+void
+operator delete(void *block) noexcept
+{
+    std::free(block);
+}
+
+void
+operator delete(void *block, std::size_t) noexcept
+{
+    std::free(block);
+}
+#endif
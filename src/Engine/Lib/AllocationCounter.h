@@ -0,0 +1,38 @@
+/* ====================================================================================================================
+ * @file AllocationCounter.h
+ * @namespace SDG::AllocationCounter
+ * Debug counter of heap allocations, for driving steady-state frames to zero allocations. Counts global operator new,
+ * SDG::Malloc, SDG::Calloc, SDG::Realloc and Allocator::Heap. Engine resets it each frame and reports the last frame's
+ * count with Engine::FrameAllocations.
+ *
+ * Enabled when SDG_COUNT_ALLOCATIONS is 1, which defaults to SDG_DEBUG. When disabled, counts stay at zero and the
+ * global operator new is not replaced.
+ * ==================================================================================================================*/
+#pragma once
+#include <Engine/Platform.h>
+#include <cstddef>
+
+#ifndef SDG_COUNT_ALLOCATIONS
+#define SDG_COUNT_ALLOCATIONS SDG_DEBUG
+#endif
+
+namespace SDG::AllocationCounter
+{
+    /// Whether allocations are being counted in this build
+    constexpr bool Enabled = SDG_COUNT_ALLOCATIONS;
+
+    /// Number of heap allocations since the last Reset, from all threads
+    [[nodiscard]] size_t Count();
+
+    /// Sets the count back to zero
+    void Reset();
+
+    /// Adds one allocation to the count. Use SDG_CountAllocation instead, which compiles out when disabled.
+    void Add();
+}
+
+#if (SDG_COUNT_ALLOCATIONS)
+#define SDG_CountAllocation() SDG::AllocationCounter::Add()
+#else
+#define SDG_CountAllocation() ((void)0)
+#endif
@@ -0,0 +1,64 @@
+#include "Allocator.h"
+#include "AllocationCounter.h"
+
+#include <Engine/Debug/Assert.h>
+#include <Engine/Exceptions/Fwd.h>
+#include <Engine/Math/Math.h>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace SDG
+{
+    void *
+    Allocator::Reallocate(void *block, size_t bytes, size_t newBytes, size_t alignment)
+    {
+        void *newBlock = Allocate(newBytes, alignment);
+        if (block)
+        {
+            std::memcpy(newBlock, block, SDG_Min(bytes, newBytes));
+            Deallocate(block, bytes);
+        }
+
+        return newBlock;
+    }
+
+    /// Allocates with malloc, which aligns to max_align_t. Larger alignments are not supported.
+    class HeapAllocator : public Allocator
+    {
+    public:
+        void *Allocate(size_t bytes, size_t alignment) override
+        {
+            SDG_Assert(alignment <= alignof(std::max_align_t));
+            void *block = std::malloc(bytes ? bytes : 1);
+            if (!block)
+                ThrowRuntimeException("SDG::Allocator::Heap: out of memory");
+
+            SDG_CountAllocation();
+            return block;
+        }
+
+        void Deallocate(void *block, size_t bytes) override
+        {
+            std::free(block);
+        }
+
+        void *Reallocate(void *block, size_t bytes, size_t newBytes, size_t alignment) override
+        {
+            SDG_Assert(alignment <= alignof(std::max_align_t));
+            void *newBlock = std::realloc(block, newBytes ? newBytes : 1);
+            if (!newBlock)
+                ThrowRuntimeException("SDG::Allocator::Heap: out of memory");
+
+            SDG_CountAllocation();
+            return newBlock;
+        }
+    };
+
+    Allocator &
+    Allocator::Heap()
+    {
+        static HeapAllocator heap;
+        return heap;
+    }
+}
@@ -0,0 +1,39 @@
+/* ====================================================================================================================
+ * @file Allocator.h
+ * @class SDG::Allocator
+ * Source of memory for containers that can take one, such as Array, String, and std containers through StdAllocator.
+ * Allocator::Heap() is the default, backed by malloc; FrameArena hands out memory that lives until the end of the
+ * frame.
+ * ==================================================================================================================*/
+#pragma once
+#include <cstddef>
+
+namespace SDG
+{
+    class Allocator
+    {
+    public:
+        virtual ~Allocator() = default;
+
+        /// Allocates memory. Throws a RuntimeException when out of memory.
+        /// @param bytes     - size of the block
+        /// @param alignment - power of two the block's address must be a multiple of
+        [[nodiscard]] virtual void *Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) = 0;
+
+        /// Releases memory returned by this Allocator
+        /// @param block - block to release, may be null
+        /// @param bytes - size the block was allocated or last reallocated with
+        virtual void Deallocate(void *block, size_t bytes) = 0;
+
+        /// Resizes a block, keeping its contents up to the smaller size. The block may move.
+        /// The default allocates a new block, copies, and deallocates the old one.
+        /// @param block    - block to resize, or null to allocate
+        /// @param bytes    - size the block was allocated or last reallocated with
+        /// @param newBytes - new size
+        [[nodiscard]] virtual void *Reallocate(void *block, size_t bytes, size_t newBytes,
+            size_t alignment = alignof(std::max_align_t));
+
+        /// Allocator that uses the heap, through malloc, realloc and free
+        [[nodiscard]] static Allocator &Heap();
+    };
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <Engine/Lib/Allocator.h>
 #include <Engine/Lib/RAIterator.h>
 
 #include <cstddef>
@@ -8,6 +9,8 @@
 namespace SDG
 {
     /// Contains a contiguous array of objects. Elements must be copy-constructible and swappable.
+    /// Memory comes from the heap, or from an Allocator passed on construction. Copy construction uses the heap;
+    /// copy assignment keeps the destination's Allocator. Moves and swaps carry the Allocator along with the memory.
     template <typename T>
     class Array
     {
@@ -18,13 +21,17 @@ namespace SDG
     public:
         typedef RAIterator<T> Iterator;
         typedef ConstRAIterator<T> ConstIterator;
-        /// Copy constructor
+        /// Copy constructor. The copy's memory comes from the heap, whatever other's Allocator.
         Array(const Array<T> &other);
         Array(Array<T> &&other) noexcept;
 
         /// Default constructs "size" number of objects of type T
         Array(size_t size = 0);
 
+        /// Default constructs "size" number of objects of type T, in memory from an Allocator
+        /// that must outlive the Array's use of it
+        Array(size_t size, Allocator &allocator);
+
         /// Copies an initializer list into the Array
         Array(const std::initializer_list<T> &list);
 
@@ -39,6 +46,7 @@ namespace SDG
 
         ~Array();
 
+        /// Copies arr's elements into memory from this Array's own Allocator
         Array &operator = (const Array &arr);
         Array &operator = (Array &&arr) noexcept;
 
@@ -83,8 +91,14 @@ namespace SDG
         T &operator[] (unsigned index) { return arr[index]; }
         
     private:
+        /// Gets memory for a number of elements from this Array's allocator
+        T *AllocateElements(size_t count);
+        /// Returns the current elements' memory to this Array's allocator
+        void FreeElements();
+
         T *arr;
         size_t size;
+        Allocator *allocator; ///< null when using the heap
     };
 }
 
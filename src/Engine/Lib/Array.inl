@@ -16,12 +16,30 @@ namespace std
 namespace SDG
 {
     template<typename T>
-    Array<T>::~Array() { Free(arr); }
+    Array<T>::~Array() { FreeElements(); }
+
+    template<typename T>
+    T *Array<T>::AllocateElements(size_t count)
+    {
+        if (count == 0)
+            return nullptr;
+        return allocator ? static_cast<T *>(allocator->Allocate(sizeof(T) * count, alignof(T))) :
+            Calloc<T>(count);
+    }
+
+    template<typename T>
+    void Array<T>::FreeElements()
+    {
+        if (allocator)
+            allocator->Deallocate(arr, sizeof(T) * size);
+        else
+            Free(arr);
+    }
 
     template<typename T>
     Array<T>::Array(const Array<T> &other) :
         arr((other.size > 0) ? Calloc<T>(other.size) : nullptr),
-        size(other.size)
+        size(other.size), allocator()
     {
         if (size > 0)
         {
@@ -39,15 +57,30 @@ namespace SDG
     template<typename T>
     Array<T>::Array(Array<T> &&other) noexcept :
         arr(other.arr),
-        size(other.size)
+        size(other.size), allocator(other.allocator)
     {
         other.arr = nullptr;
         other.size = 0;
+        other.allocator = nullptr;
+    }
+
+    template<typename T>
+    Array<T>::Array(size_t size) : arr((size > 0) ? Calloc<T>(size) : nullptr), size(size), allocator()
+    {
+        if (arr)
+        {
+            memset(arr, 0, sizeof(T) * size);
+            for (T &value : *this)
+            {
+                value = T{};
+            }
+        }
     }
 
     template<typename T>
-    Array<T>::Array(size_t size) : arr((size > 0) ? Calloc<T>(size) : nullptr), size(size)
+    Array<T>::Array(size_t size, Allocator &allocator) : arr(), size(size), allocator(&allocator)
     {
+        arr = AllocateElements(size);
         if (arr)
         {
             memset(arr, 0, sizeof(T) * size);
@@ -60,7 +93,7 @@ namespace SDG
 
     template<typename T>
     Array<T>::Array(const std::initializer_list<T> &list) :
-        arr(list.size() > 0 ? Calloc<T>(list.size()) : nullptr), size(list.size())
+        arr(list.size() > 0 ? Calloc<T>(list.size()) : nullptr), size(list.size()), allocator()
     {
         if (arr)
         {
@@ -76,7 +109,7 @@ namespace SDG
 
     template<typename T>
     template <typename It>
-    Array<T>::Array(It pBegin, It pEnd)  : arr(), size()
+    Array<T>::Array(It pBegin, It pEnd)  : arr(), size(), allocator()
     {
         Assign(pBegin, pEnd);
     }
@@ -87,7 +120,7 @@ namespace SDG
     {
         static_assert(std::is_same_v<T, std::decay_t<decltype(*pBegin)>>,
             "ForwardIterator must contain Array's type T");
-        Free(arr);
+        FreeElements();
 
         // Get instances
         size_t count = 0;
@@ -95,7 +128,7 @@ namespace SDG
             ++count;
 
         // Allocate memory
-        arr = (count > 0) ? Calloc<T>(count) : nullptr;
+        arr = AllocateElements(count);
         memset(arr, 0, count * sizeof(T));
         size = count;
 
@@ -113,7 +146,7 @@ namespace SDG
     template<typename T>
     void Array<T>::Clear()
     {
-        Free(arr);
+        FreeElements();
         arr = nullptr;
         size = 0;
     }
@@ -121,11 +154,11 @@ namespace SDG
     template<typename T>
     Array<T> &Array<T>::Assign(ConstIterator pBegin, ConstIterator pEnd)
     {
-        Free(arr); // Free any pre-existing data
+        FreeElements(); // Free any pre-existing data
         
         // Allocate memory
         size_t count = pEnd - pBegin;
-        arr = (count > 0) ? Calloc<T>(count) : nullptr;
+        arr = AllocateElements(count);
         memset(arr, 0, count * sizeof(T));
         size = count;
 
@@ -154,11 +187,13 @@ namespace SDG
         if (&other == this)
             return *this;
 
-        Free(arr);
+        FreeElements();
         arr = other.arr;
         size = other.size;
+        allocator = other.allocator;
         other.arr = nullptr;
         other.size = 0;
+        other.allocator = nullptr;
 
         return *this;
     }
@@ -184,6 +219,7 @@ namespace SDG
     {
         std::swap(arr, other.arr);
         std::swap(size, other.size);
+        std::swap(allocator, other.allocator);
 
         return *this;
     }
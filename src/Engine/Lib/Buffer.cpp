@@ -5,6 +5,7 @@
 #include <Engine/Lib/Memory.h>
 #include <Engine/Platform.h>
 
+#include <algorithm>
 #include <cstring>
 
 namespace SDG
@@ -37,7 +38,7 @@ namespace SDG
     Buffer::Buffer(size_t initCap, Endian endian) :
         buf_(Calloc<uint8_t>(initCap)), head_(buf_), end_(buf_), 
         endian_(endian == Endian::Unknown ? SystemEndian() : endian), 
-        cap_(buf_ + initCap)
+        cap_(buf_ + initCap), owned_(true)
     {
 
     }
@@ -45,15 +46,23 @@ namespace SDG
     /// Gains ownership of data allocated via SDG::Malloc or SDG::Calloc
     Buffer::Buffer(void *data, size_t size, Endian endian) :
         buf_((uint8_t *)data), head_(buf_), end_(buf_ + size),
-        endian_(endian), cap_(buf_ + size)
+        endian_(endian), cap_(buf_ + size), owned_(true)
     {
 
     }
 
+    Buffer
+    Buffer::View(const void *data, size_t size, Endian endian)
+    {
+        Buffer view(const_cast<void *>(data), size, endian);
+        view.owned_ = false;
+        return view;
+    }
+
     Buffer::Buffer(const Buffer &buffer) :
         buf_(Calloc<uint8_t>(buffer.Capacity())), head_(buf_), 
         end_(buf_ + buffer.Size()), endian_(buffer.Endianness()),
-        cap_(buf_ + buffer.Capacity())
+        cap_(buf_ + buffer.Capacity()), owned_(true)
     {
         memcpy(buf_, buffer.buf_, buffer.Size());
     }
@@ -61,7 +70,7 @@ namespace SDG
     Buffer::Buffer(Buffer &&buffer) noexcept :
         buf_(buffer.buf_), head_(buffer.head_),
         end_(buffer.end_), endian_(buffer.endian_),
-        cap_(buffer.cap_)
+        cap_(buffer.cap_), owned_(buffer.owned_)
     {
         memset(&buffer, 0, sizeof(Buffer));
     }
@@ -69,7 +78,7 @@ namespace SDG
     Buffer &
     Buffer::operator = (const Buffer &buffer)
     {
-        if (Capacity() < buffer.Capacity())
+        if (Capacity() < buffer.Capacity() || !owned_)
             Expand(buffer.Capacity());
         head_ = buf_;
         end_ = buf_ + buffer.Size();
@@ -84,12 +93,14 @@ namespace SDG
         if (&buffer == this)
             return *this;
 
-        Free(buf_);
+        if (owned_)
+            Free(buf_);
         buf_ = buffer.buf_;
         head_ = buffer.head_;
         end_ = buffer.end_;
         endian_ = buffer.endian_;
         cap_ = buffer.cap_;
+        owned_ = buffer.owned_;
 
         memset(&buffer, 0, sizeof(Buffer));
         return *this;
@@ -97,7 +108,8 @@ namespace SDG
 
     Buffer::~Buffer()
     {
-        Free(buf_);
+        if (owned_)
+            Free(buf_);
     }
 
     size_t
@@ -187,6 +199,7 @@ namespace SDG
         std::swap(cap_, buf.cap_);
         std::swap(head_, buf.head_);
         std::swap(endian_, buf.endian_);
+        std::swap(owned_, buf.owned_);
     }
 
     uint8_t *
@@ -208,7 +221,22 @@ namespace SDG
     void
     Buffer::Expand(size_t newCap)
     {
-        if (newCap > Capacity())
+        if (!owned_) // copy a view's data before it can be modified
+        {
+            size_t position = Tell();
+            size_t size = Size();
+            newCap = std::max({ newCap, Capacity(), (size_t)1 });
+
+            auto data = Calloc<uint8_t>(newCap);
+            memcpy(data, buf_, size);
+
+            buf_ = data;
+            head_ = buf_ + position;
+            end_ = buf_ + size;
+            cap_ = buf_ + newCap;
+            owned_ = true;
+        }
+        else if (newCap > Capacity())
         {
             // These vals need to be cached before mutating Buffer
             size_t position = Tell();
@@ -225,6 +253,13 @@ namespace SDG
     void
     Buffer::CheckBoundsWrite(uint8_t *ptr)
     {
+        if (!owned_)
+        {
+            ptrdiff_t offset = ptr - buf_;
+            Expand(Capacity());
+            ptr = buf_ + offset;
+        }
+
         if (ptr < buf_)
             throw OutOfRangeException((uintptr_t)ptr - (uintptr_t)buf_ - 1,
                 "Attempted to write data outside of Buffer bounds");
@@ -39,6 +39,11 @@ namespace SDG
 
         ~Buffer();
 
+        /// Creates a read-only view of memory that the Buffer does not own, such as a mapped file.
+        /// The memory must outlive the Buffer. Writing or reserving copies the data into memory
+        /// owned by the Buffer first, so the viewed memory is never modified.
+        static Buffer View(const void *data, size_t size, Endian endian = Endian::Little);
+
         /// Reads a primitive type from the buffer. Other types will result
         /// in undefined behavior due to differences in compiler behavior
         /// for padding/alignment of data in classes and structs.
@@ -119,6 +124,8 @@ namespace SDG
         /// and automatically increased when Size() > Capacity().
         [[nodiscard]] size_t Capacity() const noexcept { return cap_ - buf_; }
         [[nodiscard]] Endian Endianness() const noexcept { return endian_; }
+        /// Whether the Buffer owns its memory, or is a view created with Buffer::View
+        [[nodiscard]] bool IsView() const noexcept { return !owned_; }
 
         /// Moves the Buffer's current read position
         void Seek(int64_t bytes, Origin origin = Start) const;
@@ -147,6 +154,7 @@ namespace SDG
         uint8_t *buf_, *end_, *cap_;
         mutable uint8_t *head_;
         Endian endian_; // endianness of the target data
+        bool owned_;    // false for views, which copy their data on first write
 
         /// Gets pointer position from Position enum and byte position
         /// Parameter "bytes" may be negative or positive.
@@ -0,0 +1,122 @@
+/* ====================================================================================================================
+ * @file DensePool.h - SDG_Engine
+ *
+ * @class DensePool
+ * Pool that keeps its live objects packed together in one array, for pooled objects that are iterated every frame,
+ * such as bullets and particles. Objects are referred to by 32-bit PoolHandles. The bookkeeping lives in arrays
+ * beside the objects rather than around each one: a slot per handle index holds the object's position in the dense
+ * array and the slot's generation. Putting an object back moves the last live object into its place, so object
+ * addresses and positions are only stable until the next PutBack; hold on to handles, not pointers.
+ *     for (Bullet &bullet : bullets)
+ *         bullet.position += bullet.velocity;
+ * ==================================================================================================================*/
+#pragma once
+#include "PoolHandle.h"
+
+#include <Engine/Lib/ClassMacros.h>
+#include <Engine/Lib/Ref.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace SDG
+{
+    template <typename T>
+    class DensePool
+    {
+        static_assert(std::is_move_constructible_v<T> && std::is_move_assignable_v<T>,
+            "Pooled type must be movable");
+        SDG_NOCOPY(DensePool);
+    public:
+        using Iterator = typename std::vector<T>::iterator;
+        using ConstIterator = typename std::vector<T>::const_iterator;
+
+        /// Creates a pool with room for a number of objects before it allocates again
+        explicit DensePool(size_t initSize = 0);
+        DensePool(DensePool &&moved) noexcept;
+        DensePool &operator = (DensePool &&moved) noexcept;
+
+        /// Constructs an object in the pool from args.
+        /// Throws OutOfRangeException if the pool already holds MaxSize objects.
+        /// @returns a handle to the object
+        template <typename...Args>
+        [[nodiscard]]
+        PoolHandle Checkout(Args &&...args);
+
+        /// Destroys the object a handle refers to, moving the last live object into its place.
+        /// Handles that are no longer valid are ignored.
+        void PutBack(PoolHandle handle);
+        /// Destroys every object in the pool. Every handle checked out becomes invalid.
+        void PutBackAll();
+
+        /// Checks whether a handle refers to an object that is checked out
+        [[nodiscard]]
+        bool IDValid(PoolHandle handle) const;
+
+        /// Gets the object a handle refers to, or a null reference if the handle is not valid
+        [[nodiscard]]
+        Ref<T> operator[] (PoolHandle handle);
+        [[nodiscard]]
+        Ref<const T> operator[] (PoolHandle handle) const;
+
+        /// Gets the live object at a position in the dense array, [0, LiveCount())
+        [[nodiscard]] T &At(size_t index) { return objects[index]; }
+        [[nodiscard]] const T &At(size_t index) const { return objects[index]; }
+
+        /// Gets the handle of the live object at a position in the dense array, e.g. to put it back while iterating.
+        /// Iterate backwards to put objects back as you go, since PutBack moves the last object into the gap.
+        [[nodiscard]] PoolHandle HandleAt(size_t index) const { return handles[index]; }
+
+        /// Live objects, packed together
+        [[nodiscard]] T *Data() { return objects.data(); }
+        [[nodiscard]] const T *Data() const { return objects.data(); }
+
+        [[nodiscard]] Iterator begin() { return objects.begin(); }
+        [[nodiscard]] Iterator end() { return objects.end(); }
+        [[nodiscard]] ConstIterator begin() const { return objects.begin(); }
+        [[nodiscard]] ConstIterator end() const { return objects.end(); }
+
+        /// The number of pool objects that are currently checked out
+        [[nodiscard]]
+        size_t LiveCount() const { return objects.size(); }
+
+        /// The number of slots handles index, live, free or retired
+        [[nodiscard]]
+        size_t SlotCount() const { return slots.size(); }
+
+        /// Makes room for a number of objects without allocating again
+        void Reserve(size_t size);
+
+        /// The maximum number of objects the pool can hold at once
+        [[nodiscard]]
+        static constexpr size_t MaxSize() { return PoolHandle::MaxCount; }
+
+        DensePool &Swap(DensePool &other) noexcept;
+
+    private:
+        static constexpr uint32_t NullSlot = ~0u;
+
+        /// Where a handle's object is. A free slot holds the next free slot instead.
+        struct Slot
+        {
+            uint32_t dense;       // index in objects, or of the next free slot
+            uint32_t generation;  // generation of the handle that refers to this slot; past MaxGeneration once retired
+        };
+
+        /// Advances a slot's generation and adds it to the free list, or retires it when its generations run out
+        void FreeSlot(uint32_t index);
+
+        /// Gets the position of a valid handle's object in the dense array, or NullSlot
+        [[nodiscard]]
+        uint32_t DenseIndexOf(PoolHandle handle) const;
+
+        std::vector<T> objects;          ///< live objects
+        std::vector<PoolHandle> handles; ///< handle of each live object, parallel to objects
+        std::vector<Slot> slots;         ///< indexed by handle index
+        uint32_t nextFree;               ///< head of the free slot list
+    };
+}
+
+#include "DensePool.inl"
@@ -0,0 +1,188 @@
+#include "DensePool.h"
+#include <Engine/Exceptions/Fwd.h>
+
+#include <string>
+#include <utility>
+
+namespace std
+{
+    template<typename T>
+    inline void swap(SDG::DensePool<T> &a, SDG::DensePool<T> &b) noexcept { a.Swap(b); }
+}
+
+namespace SDG
+{
+    template<typename T>
+    DensePool<T>::DensePool(size_t initSize) : objects(), handles(), slots(), nextFree(NullSlot)
+    {
+        Reserve(initSize);
+    }
+
+    template<typename T>
+    DensePool<T>::DensePool(DensePool &&moved) noexcept : objects(std::move(moved.objects)),
+        handles(std::move(moved.handles)), slots(std::move(moved.slots)), nextFree(moved.nextFree)
+    {
+        moved.objects.clear();
+        moved.handles.clear();
+        moved.slots.clear();
+        moved.nextFree = NullSlot;
+    }
+
+    template<typename T>
+    DensePool<T> &DensePool<T>::operator = (DensePool &&moved) noexcept
+    {
+        if (&moved == this)
+            return *this;
+
+        objects = std::move(moved.objects);
+        handles = std::move(moved.handles);
+        slots = std::move(moved.slots);
+        nextFree = moved.nextFree;
+
+        moved.objects.clear();
+        moved.handles.clear();
+        moved.slots.clear();
+        moved.nextFree = NullSlot;
+        return *this;
+    }
+
+    template<typename T>
+    template<typename...Args>
+    PoolHandle DensePool<T>::Checkout(Args &&...args)
+    {
+        if (nextFree == NullSlot && slots.size() >= MaxSize())
+            ThrowOutOfRangeException((int)slots.size(), "DensePool has reached its maximum size of " +
+                std::to_string(MaxSize()));
+
+        // Construct first, so a throwing constructor leaves the pool as it was
+        objects.emplace_back(std::forward<Args>(args)...);
+
+        uint32_t index;
+        if (nextFree == NullSlot)
+        {
+            index = (uint32_t)slots.size();
+            slots.push_back(Slot{ 0, 0 });
+        }
+        else
+        {
+            index = nextFree;
+            nextFree = slots[index].dense;
+        }
+
+        Slot &slot = slots[index];
+        slot.dense = (uint32_t)objects.size() - 1;
+
+        PoolHandle handle(index, slot.generation);
+        handles.push_back(handle);
+        return handle;
+    }
+
+    template<typename T>
+    void DensePool<T>::PutBack(PoolHandle handle)
+    {
+        const uint32_t dense = DenseIndexOf(handle);
+        if (dense == NullSlot)
+            return;
+
+        // Fill the gap with the last object, so the live objects stay packed
+        const uint32_t last = (uint32_t)objects.size() - 1;
+        if (dense != last)
+        {
+            objects[dense] = std::move(objects[last]);
+            handles[dense] = handles[last];
+            slots[handles[dense].Index()].dense = dense;
+        }
+        objects.pop_back();
+        handles.pop_back();
+
+        FreeSlot(handle.Index());
+    }
+
+    template<typename T>
+    void DensePool<T>::PutBackAll()
+    {
+        for (PoolHandle handle : handles)
+            FreeSlot(handle.Index());
+
+        objects.clear();
+        handles.clear();
+    }
+
+    template<typename T>
+    bool DensePool<T>::IDValid(PoolHandle handle) const
+    {
+        return DenseIndexOf(handle) != NullSlot;
+    }
+
+    template<typename T>
+    Ref<T> DensePool<T>::operator[] (PoolHandle handle)
+    {
+        const uint32_t dense = DenseIndexOf(handle);
+        return dense == NullSlot ? nullptr : &objects[dense];
+    }
+
+    template<typename T>
+    Ref<const T> DensePool<T>::operator[] (PoolHandle handle) const
+    {
+        const uint32_t dense = DenseIndexOf(handle);
+        return dense == NullSlot ? nullptr : &objects[dense];
+    }
+
+    template<typename T>
+    void DensePool<T>::Reserve(size_t size)
+    {
+        if (size > MaxSize())
+        {
+            ThrowInvalidArgumentException("DensePool::Reserve(size_t size)",
+                "size", "size must be <= DensePool<T>::MaxSize(): " +
+                std::to_string(MaxSize()) + ", but got " + std::to_string(size));
+        }
+
+        objects.reserve(size);
+        handles.reserve(size);
+        slots.reserve(size);
+    }
+
+    template<typename T>
+    DensePool<T> &DensePool<T>::Swap(DensePool &other) noexcept
+    {
+        std::swap(objects, other.objects);
+        std::swap(handles, other.handles);
+        std::swap(slots, other.slots);
+        std::swap(nextFree, other.nextFree);
+        return *this;
+    }
+
+
+    // ========== Helper functions ==========
+
+
+    template<typename T>
+    void DensePool<T>::FreeSlot(uint32_t index)
+    {
+        // Advancing the generation invalidates handles to the slot's old object. Retire the slot once its
+        // generations run out, so no handle can be mistaken for a later object.
+        Slot &slot = slots[index];
+        if (++slot.generation <= PoolHandle::MaxGeneration)
+        {
+            slot.dense = nextFree;
+            nextFree = index;
+        }
+        else
+        {
+            slot.dense = NullSlot;
+        }
+    }
+
+    template<typename T>
+    uint32_t DensePool<T>::DenseIndexOf(PoolHandle handle) const
+    {
+        const uint32_t index = handle.Index();
+        if (handle.IsNull() || index >= slots.size())
+            return NullSlot;
+
+        // A free slot's dense index names another slot, whose object's handle has a different index
+        const uint32_t dense = slots[index].dense;
+        return (dense < handles.size() && handles[dense] == handle) ? dense : NullSlot;
+    }
+}
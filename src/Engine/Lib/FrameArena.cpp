@@ -0,0 +1,141 @@
+#include "FrameArena.h"
+
+#include <Engine/Debug/Assert.h>
+#include <Engine/Math/Math.h>
+
+#include <cstdint>
+
+namespace SDG
+{
+    static size_t
+    AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    FrameArena::FrameArena(size_t capacity) :
+        blocks(), current(0), offset(0), usedBefore(0), peak(0), last(nullptr)
+    {
+        if (capacity > 0)
+            blocks.emplace_back(Block{ (char *)Allocator::Heap().Allocate(capacity), capacity });
+    }
+
+    FrameArena::~FrameArena()
+    {
+        for (Block &block : blocks)
+            Allocator::Heap().Deallocate(block.data, block.size);
+    }
+
+    void *
+    FrameArena::Allocate(size_t bytes, size_t alignment)
+    {
+        SDG_Assert(alignment > 0 && (alignment & (alignment - 1)) == 0); // alignment must be a power of two
+
+        if (!blocks.empty())
+        {
+            Block &block = blocks[current];
+            size_t start = AlignUp((size_t)(uintptr_t)(block.data + offset), alignment) - (uintptr_t)block.data;
+            if (start + bytes <= block.size)
+            {
+                offset = start + bytes;
+                last = block.data + start;
+                peak = SDG_Max(peak, Used());
+                return last;
+            }
+        }
+
+        Grow(bytes, alignment);
+        return Allocate(bytes, alignment);
+    }
+
+    void
+    FrameArena::Deallocate(void *block, size_t bytes)
+    {
+        if (block && block == last)
+        {
+            offset = (size_t)(last - blocks[current].data);
+            last = nullptr;
+        }
+    }
+
+    void *
+    FrameArena::Reallocate(void *block, size_t bytes, size_t newBytes, size_t alignment)
+    {
+        if (block && block == last)
+        {
+            size_t start = (size_t)(last - blocks[current].data);
+            if (start + newBytes <= blocks[current].size)
+            {
+                offset = start + newBytes;
+                peak = SDG_Max(peak, Used());
+                return block;
+            }
+        }
+
+        return Allocator::Reallocate(block, bytes, newBytes, alignment);
+    }
+
+    void
+    FrameArena::Grow(size_t bytes, size_t alignment)
+    {
+        usedBefore += offset;
+        offset = 0;
+        last = nullptr;
+
+        // Room for the allocation at any alignment, and at least double the last block
+        size_t needed = bytes + alignment;
+        size_t size = SDG_Max(needed, blocks.empty() ? DefaultCapacity : blocks[current].size * 2);
+        blocks.emplace_back(Block{ (char *)Allocator::Heap().Allocate(size), size });
+        current = blocks.size() - 1;
+    }
+
+    void
+    FrameArena::Reset()
+    {
+        // Merge overflow blocks into one that fits the busiest frame so far
+        if (blocks.size() > 1)
+        {
+            size_t size = 0;
+            for (Block &block : blocks)
+            {
+                size += block.size;
+                Allocator::Heap().Deallocate(block.data, block.size);
+            }
+
+            blocks.clear();
+            blocks.emplace_back(Block{ (char *)Allocator::Heap().Allocate(size), size });
+        }
+
+        current = 0;
+        offset = 0;
+        usedBefore = 0;
+        last = nullptr;
+    }
+
+    size_t
+    FrameArena::Used() const
+    {
+        return usedBefore + offset;
+    }
+
+    size_t
+    FrameArena::PeakUsed() const
+    {
+        return peak;
+    }
+
+    size_t
+    FrameArena::Capacity() const
+    {
+        size_t capacity = 0;
+        for (const Block &block : blocks)
+            capacity += block.size;
+        return capacity;
+    }
+
+    size_t
+    FrameArena::BlockCount() const
+    {
+        return blocks.size();
+    }
+}
@@ -0,0 +1,75 @@
+/* ====================================================================================================================
+ * @file FrameArena.h
+ * @class SDG::FrameArena
+ * Linear allocator for transient, per-frame memory. Allocation bumps an offset, and everything is released at once by
+ * Reset, which Engine calls at the end of each frame. Memory is kept between frames: if a frame outgrows the arena,
+ * Reset merges its blocks into one block that fits the whole frame, so steady-state frames do not touch the heap.
+ *
+ * Objects placed in the arena are not destroyed on Reset, so use it for trivially destructible data or containers
+ * that are gone by the end of the frame. Not thread-safe; use it from the main thread.
+ * ==================================================================================================================*/
+#pragma once
+#include "Allocator.h"
+#include "ClassMacros.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace SDG
+{
+    class FrameArena : public Allocator
+    {
+        SDG_NOCOPY(FrameArena);
+    public:
+        /// Initial capacity, in bytes
+        static constexpr size_t DefaultCapacity = 256 * 1024;
+
+        /// @param capacity - bytes to reserve up front
+        explicit FrameArena(size_t capacity = DefaultCapacity);
+        ~FrameArena() override;
+
+        [[nodiscard]] void *Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) override;
+
+        /// Releases a block if it was the last one allocated; otherwise its memory is reclaimed on Reset
+        void Deallocate(void *block, size_t bytes) override;
+
+        /// Grows or shrinks in place if the block was the last one allocated
+        [[nodiscard]] void *Reallocate(void *block, size_t bytes, size_t newBytes,
+            size_t alignment = alignof(std::max_align_t)) override;
+
+        /// Allocates uninitialized memory for a number of objects of type T
+        template <typename T>
+        [[nodiscard]] T *AllocateArray(size_t count)
+        {
+            return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /// Releases everything allocated since the last Reset. Invalidates all pointers into the arena.
+        void Reset();
+
+        /// Bytes allocated since the last Reset, including alignment padding
+        [[nodiscard]] size_t Used() const;
+        /// Most bytes used in one frame since the arena was created
+        [[nodiscard]] size_t PeakUsed() const;
+        /// Total bytes reserved
+        [[nodiscard]] size_t Capacity() const;
+        /// Number of memory blocks held. Stays at one when frames fit their arena.
+        [[nodiscard]] size_t BlockCount() const;
+    private:
+        struct Block
+        {
+            char  *data;
+            size_t size;
+        };
+
+        /// Moves to a new block that fits an allocation
+        void Grow(size_t bytes, size_t alignment);
+
+        std::vector<Block> blocks;
+        size_t current;        ///< index of the block being allocated from
+        size_t offset;         ///< bytes used in the current block
+        size_t usedBefore;     ///< bytes used in blocks before the current one
+        size_t peak;
+        char  *last;           ///< last block allocated, which can be resized or released in place
+    };
+}
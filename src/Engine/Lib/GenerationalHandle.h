@@ -0,0 +1,60 @@
+/* ====================================================================================================================
+ * @file GenerationalHandle.h - SDG_Engine
+ *
+ * @struct GenerationalHandle
+ * 32-bit handle that packs the index of a slot in its owner's table with the generation of that slot. When the owner
+ * frees the slot it advances the slot's generation, so old handles to it stop matching instead of referring to
+ * whatever reuses the slot. Owners retire a slot once its generation passes MaxGeneration rather than wrapping, so a
+ * handle can never match again. Tag keeps handles of different owners, such as Entity and PoolHandle, from mixing.
+ * ==================================================================================================================*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace SDG
+{
+    template <typename Tag>
+    struct GenerationalHandle
+    {
+        static constexpr uint32_t IndexBits = 20;
+        static constexpr uint32_t GenerationBits = 32 - IndexBits;
+        static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+        static constexpr uint32_t MaxGeneration = (1u << GenerationBits) - 1;
+        /// Number of slots an owner can hold at once. The last index is reserved for Null.
+        static constexpr uint32_t MaxCount = IndexMask;
+
+        /// Handle that refers to nothing
+        static const GenerationalHandle Null;
+
+        constexpr GenerationalHandle() : id(~0u) { }
+        constexpr GenerationalHandle(uint32_t index, uint32_t generation) :
+            id((generation & MaxGeneration) << IndexBits | (index & IndexMask)) { }
+
+        [[nodiscard]] constexpr uint32_t Index() const { return id & IndexMask; }
+        [[nodiscard]] constexpr uint32_t Generation() const { return id >> IndexBits; }
+
+        /// Gets the packed index and generation
+        [[nodiscard]] constexpr uint32_t ID() const { return id; }
+
+        [[nodiscard]] constexpr bool IsNull() const { return id == ~0u; }
+        constexpr explicit operator bool() const { return !IsNull(); }
+
+        constexpr bool operator==(const GenerationalHandle &other) const { return id == other.id; }
+        constexpr bool operator!=(const GenerationalHandle &other) const { return id != other.id; }
+    private:
+        uint32_t id;
+    };
+
+    template <typename Tag>
+    inline constexpr GenerationalHandle<Tag> GenerationalHandle<Tag>::Null{};
+}
+
+template <typename Tag>
+struct std::hash<SDG::GenerationalHandle<Tag>>
+{
+    size_t operator()(const SDG::GenerationalHandle<Tag> &handle) const noexcept
+    {
+        return std::hash<uint32_t>()(handle.ID());
+    }
+};
@@ -0,0 +1,107 @@
+/* ====================================================================================================================
+ * @file Hash.h
+ * @namespace SDG
+ * 64-bit non-cryptographic hashing of strings and bytes, for identifiers such as Path::Hash and AssetID.
+ * Implements XXH64, so it spreads keys across all 64 bits and agrees with other XXH64 implementations. SDG_ContentPipe
+ * hashes asset content with it too. It is constexpr, so identifiers of string literals can be computed at compile
+ * time and match the ones computed at runtime.
+ * ==================================================================================================================*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace SDG
+{
+    namespace Private::HashImpl
+    {
+        constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t Prime3 = 0x165667B19E3779F9ull;
+        constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+        constexpr uint64_t RotateLeft(uint64_t value, int bits)
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        /// Reads little-endian bytes one at a time, which works in constant expressions.
+        /// Compilers merge these into a single load at runtime.
+        constexpr uint64_t Read64(const char *p)
+        {
+            return (uint64_t)(uint8_t)p[0]       | (uint64_t)(uint8_t)p[1] << 8  |
+                   (uint64_t)(uint8_t)p[2] << 16 | (uint64_t)(uint8_t)p[3] << 24 |
+                   (uint64_t)(uint8_t)p[4] << 32 | (uint64_t)(uint8_t)p[5] << 40 |
+                   (uint64_t)(uint8_t)p[6] << 48 | (uint64_t)(uint8_t)p[7] << 56;
+        }
+
+        constexpr uint64_t Read32(const char *p)
+        {
+            return (uint64_t)(uint8_t)p[0]       | (uint64_t)(uint8_t)p[1] << 8 |
+                   (uint64_t)(uint8_t)p[2] << 16 | (uint64_t)(uint8_t)p[3] << 24;
+        }
+
+        constexpr uint64_t Round(uint64_t acc, uint64_t input)
+        {
+            return RotateLeft(acc + input * Prime2, 31) * Prime1;
+        }
+
+        constexpr uint64_t MergeRound(uint64_t acc, uint64_t value)
+        {
+            return (acc ^ Round(0, value)) * Prime1 + Prime4;
+        }
+    }
+
+    /// Hashes bytes to 64 bits
+    /// @param seed - hashes of the same bytes with different seeds are unrelated
+    constexpr uint64_t Hash64(std::string_view bytes, uint64_t seed = 0)
+    {
+        using namespace Private::HashImpl;
+
+        const char *p = bytes.data();
+        const char *const end = p + bytes.size();
+        uint64_t hash;
+
+        if (bytes.size() >= 32)
+        {
+            uint64_t v1 = seed + Prime1 + Prime2, v2 = seed + Prime2, v3 = seed, v4 = seed - Prime1;
+            for (; end - p >= 32; p += 32)
+            {
+                v1 = Round(v1, Read64(p));
+                v2 = Round(v2, Read64(p + 8));
+                v3 = Round(v3, Read64(p + 16));
+                v4 = Round(v4, Read64(p + 24));
+            }
+
+            hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+            hash = MergeRound(hash, v1);
+            hash = MergeRound(hash, v2);
+            hash = MergeRound(hash, v3);
+            hash = MergeRound(hash, v4);
+        }
+        else
+        {
+            hash = seed + Prime5;
+        }
+
+        hash += (uint64_t)bytes.size();
+
+        for (; end - p >= 8; p += 8)
+            hash = RotateLeft(hash ^ Round(0, Read64(p)), 27) * Prime1 + Prime4;
+        if (end - p >= 4)
+        {
+            hash = RotateLeft(hash ^ (Read32(p) * Prime1), 23) * Prime2 + Prime3;
+            p += 4;
+        }
+        for (; p < end; ++p)
+            hash = RotateLeft(hash ^ ((uint8_t)*p * Prime5), 11) * Prime1;
+
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        hash *= Prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+}
@@ -4,6 +4,7 @@
 ///
 #pragma once
 #include <Engine/Exceptions/Fwd.h>
+#include <Engine/Lib/AllocationCounter.h>
 #include <cstdlib>
 
 namespace SDG
@@ -19,7 +20,8 @@ namespace SDG
         T *temp = (T *)malloc(sizeof(T) * count);
         if (!temp)
             ThrowRuntimeException("SDG::Calloc: Out of memory");
-        
+
+        SDG_CountAllocation();
         return temp;
     }
 
@@ -29,6 +31,7 @@ namespace SDG
         if (!temp)
             ThrowRuntimeException("SDG::Malloc: Out of memory");
 
+        SDG_CountAllocation();
         return temp;
     }
 
@@ -48,6 +51,8 @@ namespace SDG
         if (!temp)
             ThrowRuntimeException("SDG::Realloc: Out of memory or pointer "
                 "access violation.");
+
+        SDG_CountAllocation();
         return temp;
     }
 
@@ -0,0 +1,18 @@
+/* ====================================================================================================================
+ * @file PoolHandle.h - SDG_Engine
+ *
+ * @struct PoolHandle
+ * Handle to an object checked out of a DensePool: a GenerationalHandle whose index is the object's slot. When the
+ * object is put back, its slot's generation advances, so old handles to it stop matching instead of referring to
+ * whatever object reuses the slot.
+ * ==================================================================================================================*/
+#pragma once
+#include "GenerationalHandle.h"
+
+namespace SDG
+{
+    struct PoolHandleTag;
+    using PoolHandle = GenerationalHandle<PoolHandleTag>;
+
+    static_assert(sizeof(PoolHandle) == 4);
+}
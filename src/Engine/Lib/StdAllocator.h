@@ -0,0 +1,53 @@
+/* ====================================================================================================================
+ * @file StdAllocator.h
+ * @class SDG::StdAllocator
+ * Adapts an SDG::Allocator for use with standard library containers, e.g.
+ *     std::vector<int, StdAllocator<int>> values(StdAllocator<int>(*engine.FrameMemory()));
+ * Containers made with a default constructed StdAllocator use Allocator::Heap.
+ * ==================================================================================================================*/
+#pragma once
+#include "Allocator.h"
+#include <cstddef>
+
+namespace SDG
+{
+    template <typename T>
+    class StdAllocator
+    {
+    public:
+        using value_type = T;
+
+        StdAllocator() noexcept : source(&Allocator::Heap()) { }
+        StdAllocator(Allocator &allocator) noexcept : source(&allocator) { }
+
+        template <typename U>
+        StdAllocator(const StdAllocator<U> &other) noexcept : source(other.Source()) { }
+
+        [[nodiscard]] T *allocate(size_t count)
+        {
+            return static_cast<T *>(source->Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        void deallocate(T *block, size_t count) noexcept
+        {
+            source->Deallocate(block, sizeof(T) * count);
+        }
+
+        /// Allocator that memory comes from
+        [[nodiscard]] Allocator *Source() const noexcept { return source; }
+
+        template <typename U>
+        [[nodiscard]] bool operator == (const StdAllocator<U> &other) const noexcept
+        {
+            return source == other.Source();
+        }
+
+        template <typename U>
+        [[nodiscard]] bool operator != (const StdAllocator<U> &other) const noexcept
+        {
+            return source != other.Source();
+        }
+    private:
+        Allocator *source;
+    };
+}
@@ -2,6 +2,8 @@
 #include "String.h"
 #include "StringView.h"
 
+#include "Hash.h"
+
 #include <Engine/Debug.h>
 #include <Engine/Exceptions.h>
 #include <Engine/Math/Math.h>
@@ -11,9 +13,10 @@
 #include <utility>
 
 // ===== C-string function helpers ============================================
-static char *StrMalloc(size_t size);
-static void StrFree(char *str);
-static char *StrRealloc(char *str, size_t size);
+// A null allocator uses the heap
+static char *StrMalloc(SDG::Allocator *allocator, size_t size);
+static void StrFree(SDG::Allocator *allocator, char *str, size_t size);
+static char *StrRealloc(SDG::Allocator *allocator, char *str, size_t size, size_t newSize);
 static bool StringsEqual(const SDG::String &str, const char *cstr, size_t size);
 
 namespace SDG
@@ -27,7 +30,7 @@ namespace SDG
     String::Allocate(const char *str, size_t size)
     {
         size_t cap = std::max(size * 2 + 1, DefaultCap + 1);
-        str_ = StrMalloc(cap);
+        str_ = StrMalloc(alloc_, cap);
         end_ = str_ + size;
         full_ = str_ + cap;
 
@@ -39,7 +42,7 @@ namespace SDG
     String::Allocate(size_t cap)
     {
         cap = std::max(cap + 1, DefaultCap + 1);
-        str_ = StrMalloc(cap);
+        str_ = StrMalloc(alloc_, cap);
         end_ = str_;
         full_ = str_ + cap;
         *end_ = '\0';
@@ -337,7 +340,7 @@ namespace SDG
         if (size > Capacity())
         {
             size_t length = Length();
-            str_ = StrRealloc(str_, size);
+            str_ = StrRealloc(alloc_, str_, full_ - str_, size);
             full_ = str_ + size;
             end_ = str_ + length;
         }
@@ -436,25 +439,14 @@ namespace SDG
         std::swap(str_, other.str_);
         std::swap(end_, other.end_);
         std::swap(full_, other.full_);
+        std::swap(alloc_, other.alloc_);
         return *this;
     }
 
-    // Implementation from:
-    // https://cp-algorithms.com/string/string-hashing.html#calculation-of-the-hash-of-a-string
     uint64_t
     String::Hash() const
     {
-        const uint64_t p = 31;
-        const uint64_t m = 1e9 + 9;
-        uint64_t hash = 0;
-        uint64_t pPow = 1;
-        for (const char *c = str_; c < end_; ++c)
-        {
-            hash = (hash + ((int64_t)*c - 'a' + 1) * pPow) % m;
-            pPow = (pPow * p) % m;
-        }
-
-        return hash;
+        return SDG::Hash64({ str_, (size_t)(end_ - str_) });
     }
 
     const char *
@@ -489,43 +481,59 @@ namespace SDG
 
     // ===== Other functions that make use of implementation ==================
 
-    String::String() : str_(), end_(), full_()
+    String::String() : str_(), end_(), full_(), alloc_()
     {
         Allocate(nullptr, 0);
     }
 
-    String::String(size_t initCap) : str_(), end_(), full_()
+    String::String(size_t initCap) : str_(), end_(), full_(), alloc_()
     {
         Allocate(initCap);
     }
 
     String::String(const std::string &str) :
-            str_(), end_(), full_()
+            str_(), end_(), full_(), alloc_()
     {
         Allocate(str.c_str(), str.length());
     }
 
     String::String(const char *str) :
-            str_(), end_(), full_()
+            str_(), end_(), full_(), alloc_()
     {
         Allocate(str, str ? strlen(str): 0);
     }
 
     String::String(const char *str, size_t count) :
-        str_(), end_(), full_()
+        str_(), end_(), full_(), alloc_()
     {
         Allocate(str, count);
     }
 
     String::String(const StringView &view) :
-        str_(), end_(), full_()
+        str_(), end_(), full_(), alloc_()
     {
         Allocate(view.Data(), view.Length());
     }
 
+    String::String(Allocator &allocator, size_t initCap) : str_(), end_(), full_(), alloc_(&allocator)
+    {
+        Allocate(initCap);
+    }
+
+    String::String(const char *str, Allocator &allocator) : str_(), end_(), full_(), alloc_(&allocator)
+    {
+        Allocate(str, str ? strlen(str) : 0);
+    }
+
+    String::String(const char *str, size_t count, Allocator &allocator) :
+        str_(), end_(), full_(), alloc_(&allocator)
+    {
+        Allocate(str, count);
+    }
+
     String::~String()
     {
-        StrFree(str_);
+        StrFree(alloc_, str_, full_ - str_);
     }
 
     String &
@@ -537,18 +545,19 @@ namespace SDG
     }
 
     String::String(const String &str) :
-            str_(), end_(), full_()
+            str_(), end_(), full_(), alloc_() // copies use the heap
     {
         Allocate(str.Cstr(), str.Length());
     }
 
     String::String(String &&str) noexcept :
-        str_(str.str_), end_(str.end_), full_(str.full_)
+        str_(str.str_), end_(str.end_), full_(str.full_), alloc_(str.alloc_)
     {
         // Mover string is now dead
         str.str_ = nullptr;
         str.end_ = nullptr;
         str.full_ = nullptr;
+        str.alloc_ = nullptr;
     }
 
     String &
@@ -564,15 +573,17 @@ namespace SDG
             return *this;
 
         // Release previously owned data and take new data from moved string
-        StrFree(str_);
+        StrFree(alloc_, str_, full_ - str_);
         str_ = str.str_;
         end_ = str.end_;
         full_ = str.full_;
+        alloc_ = str.alloc_;
         
         // Mover string is now dead
         str.str_ = nullptr;
         str.end_ = nullptr;
         str.full_ = nullptr;
+        str.alloc_ = nullptr;
         return *this;
     }
 
@@ -595,7 +606,7 @@ namespace SDG
 
     String &String::Assign(const char *str, size_t length)
     {
-        StrFree(str_);
+        StrFree(alloc_, str_, full_ - str_);
         Allocate(str, length);
         return *this;
     }
@@ -838,28 +849,39 @@ SDG::operator != (const std::string &str1, const SDG::String &str2)
 
 // ===== Cstring Helper Impl ==================================================
 char *
-StrMalloc(size_t size)
+StrMalloc(SDG::Allocator *allocator, size_t size)
 {
+    if (allocator)
+        return (char *)allocator->Allocate(size, 1);
+
     char *m = (char *)malloc(size);
     if (!m)
         throw SDG::RuntimeException("String allocation failed: out of memory.");
 
+    SDG_CountAllocation();
     return m;
 }
 
 void
-StrFree(char *str)
+StrFree(SDG::Allocator *allocator, char *str, size_t size)
 {
-    free(str);
+    if (allocator)
+        allocator->Deallocate(str, size);
+    else
+        free(str);
 }
 
 char *
-StrRealloc(char *str, size_t size)
+StrRealloc(SDG::Allocator *allocator, char *str, size_t size, size_t newSize)
 {
-    char *m = (char *)realloc(str, size);
+    if (allocator)
+        return (char *)allocator->Reallocate(str, size, newSize, 1);
+
+    char *m = (char *)realloc(str, newSize);
     if (!m)
         throw SDG::RuntimeException("String reallocation failed");
 
+    SDG_CountAllocation();
     return m;
 }
 
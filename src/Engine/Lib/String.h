@@ -6,6 +6,7 @@
  * 
  */
 #pragma once
+#include <Engine/Lib/Allocator.h>
 #include <Engine/Lib/Array.h>
 #include <Engine/Lib/RAIterator.h>
 #include <Engine/Lib/ConstRAIterator.h>
@@ -30,6 +31,12 @@ namespace SDG
         String(const char *str);
         String(const char *str, size_t count);
         String(const class StringView &view);
+
+        /// Creates a String whose memory comes from the allocator, which must outlive it.
+        /// Copies of the String allocate from the heap; moves carry the allocator along.
+        explicit String(Allocator &allocator, size_t initCap = 0);
+        String(const char *str, Allocator &allocator);
+        String(const char *str, size_t count, Allocator &allocator);
         ~String();
 
     public:
@@ -218,7 +225,7 @@ namespace SDG
 
         // ===== Conversion ===========================================================================================
 
-        /// Creates a hash value for quick comparison.
+        /// Creates a 64-bit hash value for quick comparison, using SDG::Hash64.
         /// Please be sure to cache this value, since hash generation
         /// takes more computing than direct String comparison would.
         [[nodiscard]] uint64_t Hash() const;
@@ -227,6 +234,10 @@ namespace SDG
         template <typename...Args>
         [[nodiscard]] static String Format(const char *format, Args ...args);
 
+        /// Creates string using the fmt library, with memory from the allocator
+        template <typename...Args>
+        [[nodiscard]] static String Format(Allocator &allocator, const char *format, Args ...args);
+
         /// Converts a String to a numeric value. 
         /// Prepending and post-pending symbols besides releveant ones are ignored
         template <typename T>
@@ -248,6 +259,8 @@ namespace SDG
 
         /// Internal string ptrs
         char *str_, *end_, *full_;
+        /// Source of the String's memory, heap if null
+        Allocator *alloc_;
     };
 
     std::ostream &operator << (std::ostream &os, const String &str);
@@ -43,6 +43,15 @@ namespace SDG
         return { out.data(), out.size() };
     }
 
+    template<typename...Args>
+    String String::Format(Allocator &allocator, const char *format, Args ...args)
+    {
+        auto out = fmt::memory_buffer();
+        fmt::vformat_to(std::back_inserter(out), std::string_view(format),
+            fmt::make_format_args(args...));
+        return { out.data(), out.size(), allocator };
+    }
+
     template <typename T>
     T String::ToNumber(uint8_t base) const
     {
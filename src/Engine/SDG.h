@@ -4,17 +4,22 @@
 #include "Engine.h"
 #include "Game/AssetMgr.h"
 #include "Game/Component.h"
-#include "Game/ComponentList.h"
 #include "Game/Datatypes/AppConfig.h"
 #include "Game/Entity.h"
+#include "Game/Graphics/Atlas.h"
 #include "Game/Graphics/Camera2D.h"
 #include "Game/Graphics/Frame.h"
 #include "Game/Graphics/Sprite.h"
 #include "Game/Graphics/SpriteBatch.h"
 #include "Game/Graphics/SpriteRenderer.h"
+#include "Game/Graphics/StaticBatch.h"
 #include "Game/Graphics/Tile.h"
 #include "Game/Graphics/Tilemap.h"
 #include "Game/Graphics/Tileset.h"
+#include "Game/HotReload.h"
+#include "Game/Scheduler.h"
+#include "Game/World.h"
+#include "Jobs/JobSystem.h"
 
 
 // Todo: make a Lib super header
@@ -22,6 +27,7 @@
 #include "Lib/Ref.h"
 #include "Lib/String.h"
 #include "Lib/Delegate.h"
+#include "Lib/DensePool.h"
 #include "Lib/FixedPool.h"
 #include "Lib/Pool.h"
 #include "Lib/Memory.h"
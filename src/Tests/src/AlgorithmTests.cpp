@@ -1,6 +1,8 @@
 #include "SDG_Tests.h"
 #include <Engine/Lib/Algorithm.h>
 
+#include <algorithm>
+
 TEST_CASE("Algorithms tests")
 {
     SECTION("foreach: container")
@@ -44,4 +46,24 @@ TEST_CASE("Algorithms tests")
         REQUIRE(result[3] == 3);
         REQUIRE(result[5] == 5);
     }
+
+    SECTION("RadixSort")
+    {
+        std::vector<uint64_t> keys{ 0xFFull << 56, 3, 0, 0x1234ull << 20, 2, 0xFFull << 56 | 1, 1 };
+        std::vector<uint64_t> scratch(keys.size());
+        std::vector<uint64_t> expected(keys);
+        std::sort(expected.begin(), expected.end());
+
+        RadixSort(keys.data(), scratch.data(), keys.size());
+        REQUIRE(keys == expected);
+    }
+
+    SECTION("RadixSort: keys sharing every digit are left untouched")
+    {
+        std::vector<uint64_t> keys{ 7, 7, 7 };
+        std::vector<uint64_t> scratch(keys.size());
+
+        RadixSort(keys.data(), scratch.data(), keys.size());
+        REQUIRE(keys == std::vector<uint64_t>{ 7, 7, 7 });
+    }
 }
@@ -0,0 +1,228 @@
+/*!
+ * @file AssetMgrTests.cpp
+ * Contains tests for asynchronous Texture loading and reloading in SDG::AssetMgr, uploading through a NullRenderBackend
+ */
+#include "SDG_Tests.h"
+#include "ScopedNullBackend.h"
+#include <Engine/Game/AssetMgr.h>
+
+#include <SDL.h>
+
+#include <filesystem>
+#include <string>
+
+/// Writes an image, 8x4 by default, to the temp directory, returning its path
+static std::string WriteTestImage(const char *name, int width = 8, int height = 4)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / name).string();
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface);
+    REQUIRE(SDL_SaveBMP(surface, path.c_str()) == 0);
+    SDL_FreeSurface(surface);
+    return path;
+}
+
+TEST_CASE("AssetMgr async loading", "[AssetMgr]")
+{
+    ScopedNullBackend scope;
+    const std::string imagePath = WriteTestImage("SDG_AssetMgrTests.bmp");
+
+    const Path path(imagePath.c_str());
+    AssetMgr assets;
+
+    SECTION("Wait decodes and uploads the texture")
+    {
+        TextureHandle handle = assets.LoadTextureAsync(path);
+        REQUIRE(!handle.Empty());
+        REQUIRE(assets.Wait(handle));
+        REQUIRE(handle.State() == AssetState::Loaded);
+        REQUIRE(handle.Get().Size() == Point(8, 4));
+        REQUIRE(handle.Get().Filepath() == path);
+        REQUIRE(assets.LoadingCount() == 0);
+    }
+
+    SECTION("Update uploads the texture and invokes callbacks")
+    {
+        int calls = 0;
+        TextureHandle handle = assets.LoadTextureAsync(path, [&calls](const TextureHandle &loaded) {
+            REQUIRE(loaded.IsLoaded());
+            ++calls;
+        });
+
+        while (!handle.IsDone())
+            assets.Update();
+
+        REQUIRE(calls == 1);
+        REQUIRE(handle.IsLoaded());
+        REQUIRE(scope.backend.ImageCount() == 1);
+    }
+
+    SECTION("Requests for the same path share one load")
+    {
+        TextureHandle handle1 = assets.LoadTextureAsync(path);
+        TextureHandle handle2 = assets.LoadTextureAsync(path);
+        REQUIRE(assets.LoadingCount() == 1);
+        REQUIRE(assets.Wait(handle2));
+        REQUIRE(handle1.IsLoaded());
+        REQUIRE(&handle1.Get() == &handle2.Get());
+
+        bool called = false;
+        assets.LoadTextureAsync(path, [&called](const TextureHandle &) { called = true; });
+        REQUIRE(called); // already loaded, so invoked right away
+    }
+
+    SECTION("Missing files fail")
+    {
+        bool failed = false;
+        TextureHandle handle = assets.LoadTextureAsync(Path("SDG_AssetMgrTests_missing.bmp"),
+            [&failed](const TextureHandle &loaded) { failed = loaded.State() == AssetState::Failed; });
+        REQUIRE(!assets.Wait(handle));
+        REQUIRE(failed);
+        REQUIRE(handle.State() == AssetState::Failed);
+        REQUIRE(!handle.Get().IsLoaded());
+    }
+
+    SECTION("Unloading a texture still loading cancels it")
+    {
+        TextureHandle handle = assets.LoadTextureAsync(path);
+        assets.UnloadTexture(path);
+        REQUIRE(!assets.Wait(handle));
+        REQUIRE(scope.backend.ImageCount() == 0);
+    }
+
+    SECTION("Unloading a loaded texture frees it")
+    {
+        TextureHandle handle = assets.LoadTextureAsync(path);
+        REQUIRE(assets.Wait(handle));
+        assets.UnloadTextures();
+        REQUIRE(!handle.Get().IsLoaded());
+        REQUIRE(handle.State() != AssetState::Loaded);
+        REQUIRE(handle.State() == AssetState::Failed);
+        REQUIRE(!assets.Wait(handle));
+        REQUIRE(scope.backend.ImageCount() == 0);
+
+        // Requesting the path again loads a new texture
+        TextureHandle again = assets.LoadTextureAsync(path);
+        REQUIRE(assets.Wait(again));
+        REQUIRE(handle.State() == AssetState::Failed);
+    }
+
+    SECTION("Reloading replaces the texture in place")
+    {
+        REQUIRE(!assets.ReloadTexture(path)); // not loaded yet
+
+        TextureHandle handle = assets.LoadTextureAsync(path);
+        REQUIRE(assets.Wait(handle));
+        const Texture *texture = &handle.Get();
+
+        WriteTestImage("SDG_AssetMgrTests.bmp", 16, 4);
+        REQUIRE(assets.ReloadTexture(path));
+        REQUIRE(!assets.ReloadTexture(path)); // already reloading
+
+        REQUIRE(assets.Wait(handle)); // blocks until the reload is uploaded
+        REQUIRE(handle.IsLoaded());
+        REQUIRE(&handle.Get() == texture);
+        REQUIRE(handle.Get().Size() == Point(16, 4));
+        REQUIRE(assets.MemoryUsage() == 16 * 4 * 4);
+        REQUIRE(scope.backend.ImageCount() == 1);
+        REQUIRE(assets.LoadingCount() == 0);
+    }
+
+    std::filesystem::remove(imagePath);
+}
+
+TEST_CASE("AssetMgr memory budget", "[AssetMgr]")
+{
+    ScopedNullBackend scope;
+    const Path pathA(WriteTestImage("SDG_AssetMgrTests_A.bmp").c_str());
+    const Path pathB(WriteTestImage("SDG_AssetMgrTests_B.bmp").c_str());
+    const Path pathC(WriteTestImage("SDG_AssetMgrTests_C.bmp").c_str());
+    const size_t textureBytes = 8 * 4 * 4;
+
+    AssetMgr assets;
+    auto load = [&assets](const Path &path) {
+        TextureHandle handle = assets.LoadTextureAsync(path);
+        REQUIRE(assets.Wait(handle));
+        return handle;
+    };
+
+    SECTION("Memory usage is tracked")
+    {
+        load(pathA);
+        load(pathB);
+        REQUIRE(assets.MemoryUsage() == 2 * textureBytes);
+
+        assets.UnloadTexture(pathA);
+        REQUIRE(assets.MemoryUsage() == textureBytes);
+        assets.UnloadTextures();
+        REQUIRE(assets.MemoryUsage() == 0);
+    }
+
+    SECTION("No budget keeps every texture")
+    {
+        load(pathA);
+        load(pathB);
+        load(pathC);
+        REQUIRE(assets.MemoryUsage() == 3 * textureBytes);
+        REQUIRE(scope.backend.ImageCount() == 3);
+    }
+
+    SECTION("Least recently used textures are evicted over budget")
+    {
+        assets.MemoryBudget(2 * textureBytes);
+        load(pathA);
+        load(pathB);
+        load(pathA); // A is now more recently used than B
+        load(pathC);
+
+        REQUIRE(assets.MemoryUsage() == 2 * textureBytes);
+        REQUIRE(scope.backend.ImageCount() == 2);
+        REQUIRE(assets.LoadTextureAsync(pathA).IsLoaded());
+        REQUIRE(assets.LoadTextureAsync(pathC).IsLoaded());
+
+        // Evicted textures reload on demand
+        TextureHandle handleB = assets.LoadTextureAsync(pathB);
+        REQUIRE(handleB.State() == AssetState::Loading);
+        REQUIRE(assets.Wait(handleB));
+    }
+
+    SECTION("Textures load and are found by ID")
+    {
+        REQUIRE(assets.FindTexture(AssetID(pathA)).Empty());
+        REQUIRE(assets.LoadTextureAsync(AssetID(pathA)).Empty()); // never requested or registered
+
+        const AssetID idA = assets.Register(pathA);
+        REQUIRE(idA == AssetID(pathA));
+        TextureHandle handle = assets.LoadTextureAsync(idA);
+        REQUIRE(!handle.Empty());
+        REQUIRE(assets.Wait(handle));
+        REQUIRE(assets.FindTexture(idA).IsLoaded());
+        REQUIRE(&assets.FindTexture(idA).Get() == &handle.Get());
+
+        // Evicted textures reload by ID
+        handle = TextureHandle();
+        assets.MemoryBudget(1);
+        REQUIRE(assets.FindTexture(idA).Empty());
+        handle = assets.LoadTextureAsync(idA);
+        REQUIRE(assets.Wait(handle));
+    }
+
+    SECTION("Textures with handles are not evicted")
+    {
+        TextureHandle handleA = load(pathA);
+        TextureHandle handleB = load(pathB);
+        assets.MemoryBudget(textureBytes);
+        REQUIRE(assets.MemoryUsage() == 2 * textureBytes);
+        REQUIRE(handleA.Get().IsLoaded());
+        REQUIRE(handleB.Get().IsLoaded());
+
+        handleA = TextureHandle();
+        assets.Trim();
+        REQUIRE(assets.MemoryUsage() == textureBytes);
+        REQUIRE(handleB.Get().IsLoaded());
+    }
+
+    std::filesystem::remove(pathA.Str().Cstr());
+    std::filesystem::remove(pathB.Str().Cstr());
+    std::filesystem::remove(pathC.Str().Cstr());
+}
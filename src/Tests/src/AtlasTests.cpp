@@ -0,0 +1,309 @@
+/*!
+ * @file AtlasTests.cpp
+ * Contains tests for packing texture atlases with SDG_ContentPipe's AtlasPacker, and for loading the .sdgatlas files
+ * it writes into SDG::Atlas and Sprite, through a NullRenderBackend
+ */
+#include "SDG_Tests.h"
+#include "ScopedNullBackend.h"
+#include <ContentPipe/AtlasPacker.h>
+#include <ContentPipe/MaxRectsBin.h>
+#include <Engine/Game/AssetMgr.h>
+#include <Engine/Game/Graphics/Atlas.h>
+#include <Engine/Game/Graphics/AtlasFormat.h>
+#include <Engine/Game/Graphics/Sprite.h>
+
+#include <lodepng.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace SDG::ContentPipe;
+
+/// Color of an opaque test pixel, which tells where in its source image it came from
+static uint32_t Coord(unsigned x, unsigned y)
+{
+    return (x + 1) << 24 | (y + 1) << 16 | 0x80FFu;
+}
+
+/// Writes an RGBA image whose pixels are color(x, y), as 0xRRGGBBAA, creating its folder
+static void WritePng(const fs::path &path, unsigned width, unsigned height,
+    const std::function<uint32_t(unsigned, unsigned)> &color)
+{
+    std::vector<unsigned char> pixels;
+    for (unsigned y = 0; y < height; ++y)
+    {
+        for (unsigned x = 0; x < width; ++x)
+        {
+            const uint32_t rgba = color(x, y);
+            pixels.insert(pixels.end(), { (unsigned char)(rgba >> 24), (unsigned char)(rgba >> 16),
+                (unsigned char)(rgba >> 8), (unsigned char)rgba });
+        }
+    }
+
+    fs::create_directories(path.parent_path());
+    REQUIRE(lodepng::encode(path.string(), pixels, width, height) == 0);
+}
+
+/// Reads the pixel at (x, y) of a decoded page, as 0xRRGGBBAA
+static uint32_t PixelAt(const std::vector<unsigned char> &page, unsigned pageWidth, unsigned x, unsigned y)
+{
+    const unsigned char *pixel = page.data() + ((size_t)y * pageWidth + x) * 4;
+    return (uint32_t)pixel[0] << 24 | (uint32_t)pixel[1] << 16 | (uint32_t)pixel[2] << 8 | pixel[3];
+}
+
+/// Writes the source images of the test atlas to <dir>/src, in an emptied dir:
+///     bat/fly/2  - 16x10, opaque
+///     bat/fly/10 - 6x15, with 4x12 visible pixels at (1, 2), which only fit under bat/fly/2 turned on their side
+///     bat/idle   - the same pixels as bat/fly/2
+///     coin       - 5x5, fully transparent
+static void WriteTestSources(const fs::path &dir)
+{
+    fs::remove_all(dir);
+    WritePng(dir / "src/bat/fly/2.png", 16, 10, Coord);
+    WritePng(dir / "src/bat/fly/10.png", 6, 15, [](unsigned x, unsigned y) {
+        return (x >= 1 && x < 5 && y >= 2 && y < 14) ? Coord(x, y) : 0;
+    });
+    WritePng(dir / "src/bat/idle.png", 16, 10, Coord);
+    WritePng(dir / "src/coin.png", 5, 5, [](unsigned, unsigned) { return 0u; });
+}
+
+/// Packs the test atlas from <dir>/src into <dir>/out/test.sdgatlas, without padding, in pages of up to maxSize
+static AtlasResult PackTestAtlas(const fs::path &dir, unsigned maxSize = 16, bool unique = true,
+    unsigned padding = 0)
+{
+    AtlasSettings settings;
+    settings.maxSize = maxSize;
+    settings.padding = padding;
+    settings.unique = unique;
+
+    const ContentCache cache;
+    return PackAtlas((dir / "src").string(), (dir / "out/test").string(), settings, cache, "atlases/test", 2);
+}
+
+TEST_CASE("Atlas loading", "[Atlas]")
+{
+    ScopedNullBackend scope;
+    AssetMgr assets;
+    Atlas atlas;
+
+    const fs::path dir = fs::temp_directory_path() / "SDG_AtlasTests";
+    WriteTestSources(dir);
+    REQUIRE(PackTestAtlas(dir).status == AtlasStatus::Packed);
+    const Path path((dir / "out/test.sdgatlas").string().c_str());
+
+    SECTION("Frames come from the metadata, and point to the page texture")
+    {
+        REQUIRE(atlas.Load(path, assets));
+        REQUIRE(atlas.IsLoaded());
+        REQUIRE(atlas.Size() == 4);
+        REQUIRE(atlas.Filepath() == path);
+        REQUIRE(atlas.NameAt(1) == "bat/fly/10"); // numbered frames in number order
+
+        const Frame *large = atlas.Find("bat/fly/2");
+        REQUIRE(large);
+        REQUIRE(large->FrameRect() == Rect_<uint16_t>(0, 0, 16, 10));
+        REQUIRE(large->OffsetPos(false) == Point(0, 0));
+        REQUIRE(large->Angle() == 0);
+        REQUIRE(large->Texture());
+        REQUIRE(large->Texture()->Size() == Point(16, 15));
+
+        // Trimmed to its visible pixels, then turned to fit in the space left under bat/fly/2
+        const Frame *turned = atlas.Find("bat/fly/10");
+        REQUIRE(turned);
+        REQUIRE(turned->FrameRect() == Rect_<uint16_t>(0, 10, 12, 4));
+        REQUIRE(turned->ImageRect() == Rect_<uint16_t>(1, 12, 6, 15));
+        REQUIRE(turned->OffsetPos(false) == Point(1, 2));
+        REQUIRE(turned->Angle() == -90.f);
+        REQUIRE(turned->Texture() == large->Texture());
+
+        REQUIRE(atlas.Find("bat/fly") == nullptr);
+        REQUIRE(atlas.Find("missing") == nullptr);
+    }
+
+    SECTION("Identical images share their pixels")
+    {
+        REQUIRE(atlas.Load(path, assets));
+        REQUIRE(atlas.Find("bat/idle")->FrameRect() == atlas.Find("bat/fly/2")->FrameRect());
+
+        REQUIRE(PackTestAtlas(dir, 64, false).status == AtlasStatus::Packed);
+        REQUIRE(atlas.Load(path, assets));
+        REQUIRE(atlas.Find("bat/idle")->FrameRect() != atlas.Find("bat/fly/2")->FrameRect());
+    }
+
+    SECTION("Fully transparent images keep one pixel")
+    {
+        REQUIRE(atlas.Load(path, assets));
+
+        const Frame *coin = atlas.Find("coin");
+        REQUIRE(coin);
+        REQUIRE(coin->FrameRect().Size() == Vec2_<uint16_t>(1, 1));
+        REQUIRE(coin->ImageRect().Size() == Vec2_<uint16_t>(5, 5));
+        REQUIRE(coin->OffsetPos(false) == Point(0, 0));
+        REQUIRE(coin->Angle() == 0);
+    }
+
+    SECTION("FramesIn gets a folder's frames in name order")
+    {
+        REQUIRE(atlas.Load(path, assets));
+
+        Array<Frame> fly = atlas.FramesIn("bat/fly");
+        REQUIRE(fly.Size() == 2);
+        REQUIRE(fly[0].Angle() == 0);
+        REQUIRE(fly[1].Angle() == -90.f);
+        REQUIRE(atlas.FramesIn("bat").Size() == 3);
+        REQUIRE(atlas.FramesIn("").Size() == 4);
+        REQUIRE(atlas.FramesIn("ba").Size() == 0);
+    }
+
+    SECTION("Sprites load a folder's frames as their reel")
+    {
+        REQUIRE(atlas.Load(path, assets));
+
+        Sprite sprite;
+        REQUIRE(sprite.LoadFromAtlas("fly", atlas, "bat/fly"));
+        REQUIRE(sprite.Name() == "fly");
+        REQUIRE(sprite.Length() == 2);
+        REQUIRE(sprite[1].FrameRect() == atlas.Find("bat/fly/10")->FrameRect());
+        REQUIRE(!sprite.LoadFromAtlas("none", atlas, "missing"));
+    }
+
+    SECTION("Files that are not atlases fail to load")
+    {
+        REQUIRE(!atlas.Load(Path((dir / "out/test0.png").string().c_str()), assets));
+        REQUIRE(!atlas.IsLoaded());
+        REQUIRE(!atlas.Load(Path("SDG_AtlasTests_missing.sdgatlas"), assets));
+    }
+
+    SECTION("Close forgets the frames")
+    {
+        REQUIRE(atlas.Load(path, assets));
+        atlas.Close();
+        REQUIRE(!atlas.IsLoaded());
+        REQUIRE(atlas.Size() == 0);
+        REQUIRE(atlas.Find("coin") == nullptr);
+    }
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Atlas packing", "[Atlas]")
+{
+    const fs::path dir = fs::temp_directory_path() / "SDG_AtlasPackingTests";
+    WriteTestSources(dir);
+
+    SECTION("MaxRects fills a bin without overlapping")
+    {
+        MaxRectsBin bin(16, 16);
+        std::vector<MaxRectsBin::Box> boxes;
+        for (int i = 0; i < 4; ++i)
+        {
+            MaxRectsBin::Box box{};
+            bool rotated = true;
+            REQUIRE(bin.Insert(8, 8, true, &box, &rotated));
+            REQUIRE(!rotated);
+            REQUIRE((box.width == 8 && box.height == 8 && box.x + 8 <= 16 && box.y + 8 <= 16));
+            for (const MaxRectsBin::Box &other : boxes)
+                REQUIRE((box.x >= other.x + 8 || other.x >= box.x + 8 || box.y >= other.y + 8 || other.y >= box.y + 8));
+            boxes.push_back(box);
+        }
+
+        MaxRectsBin::Box box{};
+        bool rotated = false;
+        REQUIRE(!bin.Insert(1, 1, true, &box, &rotated));
+    }
+
+    SECTION("MaxRects turns rectangles that only fit on their side")
+    {
+        MaxRectsBin::Box box{};
+        bool rotated = false;
+
+        MaxRectsBin fixed(16, 16);
+        REQUIRE(fixed.Insert(16, 10, false, &box, &rotated));
+        REQUIRE(!fixed.Insert(4, 12, false, &box, &rotated));
+
+        MaxRectsBin turning(16, 16);
+        REQUIRE(turning.Insert(16, 10, true, &box, &rotated));
+        REQUIRE(turning.Insert(4, 12, true, &box, &rotated));
+        REQUIRE(rotated);
+        REQUIRE((box.x == 0 && box.y == 10 && box.width == 12 && box.height == 4));
+    }
+
+    SECTION("Pages hold the trimmed pixels, turned clockwise when rotated")
+    {
+        const AtlasResult result = PackTestAtlas(dir);
+        REQUIRE(result.status == AtlasStatus::Packed);
+        REQUIRE(result.imageCount == 4);
+        REQUIRE(result.pageCount == 1);
+        REQUIRE(result.sources.size() == 4);
+
+        std::vector<unsigned char> page;
+        unsigned width, height;
+        REQUIRE(lodepng::decode(page, width, height, (dir / "out/test0.png").string()) == 0);
+        REQUIRE((width == 16 && height == 15));
+
+        for (unsigned y = 0; y < 10; ++y)
+        {
+            for (unsigned x = 0; x < 16; ++x)
+                REQUIRE(PixelAt(page, width, x, y) == Coord(x, y));
+        }
+
+        // bat/fly/10's 4x12 visible pixels are at (0, 10) on their side: its top-left goes to the top-right
+        REQUIRE(PixelAt(page, width, 11, 10) == Coord(1, 2));
+        REQUIRE(PixelAt(page, width, 0, 10) == Coord(1, 13));
+        for (unsigned v = 0; v < 4; ++v)
+        {
+            for (unsigned u = 0; u < 12; ++u)
+                REQUIRE(PixelAt(page, width, u, 10 + v) == Coord(1 + v, 2 + 11 - u));
+        }
+    }
+
+    SECTION("Unchanged atlases are left alone")
+    {
+        REQUIRE(PackTestAtlas(dir).status == AtlasStatus::Packed);
+        const auto writeTime = fs::last_write_time(dir / "out/test.sdgatlas");
+
+        const AtlasResult same = PackTestAtlas(dir);
+        REQUIRE(same.status == AtlasStatus::UpToDate);
+        REQUIRE(same.pageCount == 1);
+        REQUIRE(fs::last_write_time(dir / "out/test.sdgatlas") == writeTime);
+
+        // Other settings, or other pixels, pack again
+        REQUIRE(PackTestAtlas(dir, 16, true, 1).status == AtlasStatus::Packed);
+        REQUIRE(PackTestAtlas(dir, 16, true, 1).status == AtlasStatus::UpToDate);
+        WritePng(dir / "src/coin.png", 5, 5, Coord);
+        REQUIRE(PackTestAtlas(dir, 16, true, 1).status == AtlasStatus::Packed);
+
+        // A missing page packs again
+        fs::remove(dir / "out/test0.png");
+        REQUIRE(PackTestAtlas(dir, 16, true, 1).status == AtlasStatus::Packed);
+        REQUIRE(fs::exists(dir / "out/test0.png"));
+    }
+
+    SECTION("Pages a new pack does not need are removed")
+    {
+        // Without sharing pixels, bat/fly/2 and bat/idle do not fit on one page
+        REQUIRE(PackTestAtlas(dir, 16, false).pageCount == 2);
+        REQUIRE(fs::exists(dir / "out/test1.png"));
+        REQUIRE(AtlasFiles((dir / "out/test").string()).size() == 3);
+
+        REQUIRE(PackTestAtlas(dir, 64, false).pageCount == 1);
+        REQUIRE(fs::exists(dir / "out/test0.png"));
+        REQUIRE(!fs::exists(dir / "out/test1.png"));
+        REQUIRE(AtlasFiles((dir / "out/test").string()).size() == 2);
+    }
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Atlas names sort numbered frames by number", "[Atlas]")
+{
+    REQUIRE(AtlasFormat::NameLess("walk/2", "walk/10"));
+    REQUIRE(!AtlasFormat::NameLess("walk/10", "walk/2"));
+    REQUIRE(AtlasFormat::NameLess("walk/9", "walk/09a"));
+    REQUIRE(AtlasFormat::NameLess("idle", "walk"));
+    REQUIRE(!AtlasFormat::NameLess("walk", "walk"));
+}
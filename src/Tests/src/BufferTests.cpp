@@ -262,4 +262,45 @@ TEST_CASE("Buffer tests", "[Buffer]")
 
         REQUIRE(buf1.Data() == orig2);
     }
+
+    SECTION("View")
+    {
+        const uint8_t data[] = { 1, 2, 3, 4 };
+
+        SECTION("Reads viewed memory without copying")
+        {
+            Buffer buf = Buffer::View(data, sizeof(data));
+            REQUIRE(buf.IsView());
+            REQUIRE(buf.Data() == data);
+            REQUIRE(buf.Size() == 4);
+
+            uint8_t b;
+            buf.Seek(2);
+            buf.Read(b);
+            REQUIRE(b == 3);
+        }
+
+        SECTION("Writing copies the data first")
+        {
+            Buffer buf = Buffer::View(data, sizeof(data));
+            buf.Seek(1);
+            buf.Write((uint8_t)9);
+
+            REQUIRE(!buf.IsView());
+            REQUIRE(buf.Data() != data);
+            REQUIRE(buf.Tell() == 2);
+            REQUIRE(buf.Data()[0] == 1);
+            REQUIRE(buf.Data()[1] == 9);
+            REQUIRE(buf.Data()[3] == 4);
+            REQUIRE(data[1] == 2);
+        }
+
+        SECTION("Move keeps the view")
+        {
+            Buffer buf1 = Buffer::View(data, sizeof(data));
+            Buffer buf2 = std::move(buf1);
+            REQUIRE(buf2.IsView());
+            REQUIRE(buf2.Data() == data);
+        }
+    }
 }
@@ -101,6 +101,21 @@ TEST_CASE("Camera2D tests", "[Camera2D]")
         REQUIRE(camera.ViewportSize() == Point(450, 180));
     }
 
+    SECTION("WorldBounds")
+    {
+        REQUIRE(camera.WorldBounds() == FRectangle(0, 0, 640, 480));
+        camera.Position(100, 50);
+        REQUIRE(camera.WorldBounds() == FRectangle(100, 50, 640, 480));
+        camera.Zoom(2.f);
+        REQUIRE(camera.WorldBounds() == FRectangle(100, 50, 320, 240));
+
+        // Rotating a quarter turn swaps the bounding box's width and height
+        camera.Position(0, 0).Scale(1.f).Angle(90);
+        FRectangle bounds = camera.WorldBounds();
+        REQUIRE(RoundF(bounds.Width()) == 480);
+        REQUIRE(RoundF(bounds.Height()) == 640);
+    }
+
     SECTION("Matrix")
     {
         REQUIRE(*camera.Matrix() == Matrix4x4::Identity());
@@ -0,0 +1,150 @@
+/*!
+ * @file CipherTests.cpp
+ * Contains tests and benchmarks for SDG::IO::Cipher, checked against the original per-byte .sdgc loops
+ */
+#include "SDG_Tests.h"
+#include <Engine/Filesys/Private/Cipher.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+static const char *CipherTestKey = "john316";
+
+// The original loop from IO::ReadEncryptedFile, one byte at a time
+static void
+ReferenceDecrypt(const uint8_t *src, uint8_t *dst, size_t size, int position = 0)
+{
+    const size_t keyLength = std::strlen(CipherTestKey);
+    for (size_t i = 0; i < size; ++i, ++position)
+    {
+        unsigned char add = CipherTestKey[position % keyLength];
+        dst[i] = (unsigned char)(src[i] - add + position);
+        dst[i] ^= ~add;
+    }
+}
+
+// The original loop from IO::WriteEncryptedFile, one byte at a time
+static void
+ReferenceEncrypt(const uint8_t *src, uint8_t *dst, size_t size, int position = 0)
+{
+    const size_t keyLength = std::strlen(CipherTestKey);
+    for (size_t i = 0; i < size; ++i, ++position)
+    {
+        uint8_t c = src[i];
+        uint8_t add = (uint8_t)CipherTestKey[position % keyLength];
+        c ^= ~add;
+        dst[i] = (unsigned char)(c + add - position);
+    }
+}
+
+static std::vector<uint8_t>
+RandomBytes(size_t size)
+{
+    std::mt19937 rng(316);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    std::vector<uint8_t> bytes(size);
+    for (auto &b : bytes)
+        b = (uint8_t)dist(rng);
+    return bytes;
+}
+
+TEST_CASE("Cipher tests", "[Cipher]")
+{
+    IO::Cipher cipher(CipherTestKey);
+
+    SECTION("Key stream period covers the key and the position byte")
+    {
+        REQUIRE(cipher.Period() == 7 * 256);
+        REQUIRE(IO::Cipher("abcd").Period() == 256);
+    }
+
+    SECTION("Matches the original per-byte scheme")
+    {
+        // Sizes around the vector widths and the key stream period
+        const size_t size = GENERATE(0, 1, 15, 16, 17, 31, 33, 1791, 1792, 1793, 5000, 65537);
+        auto plain = RandomBytes(size);
+        std::vector<uint8_t> expected(size), actual(size);
+
+        ReferenceEncrypt(plain.data(), expected.data(), size);
+        cipher.Encrypt(plain.data(), actual.data(), size);
+        REQUIRE(actual == expected);
+
+        auto encrypted = expected;
+        ReferenceDecrypt(encrypted.data(), expected.data(), size);
+        cipher.Decrypt(encrypted.data(), actual.data(), size);
+        REQUIRE(actual == expected);
+        REQUIRE(actual == plain);
+    }
+
+    SECTION("Starting position within the file")
+    {
+        const size_t position = GENERATE(1, 7, 255, 1000, 1792, 100000);
+        auto plain = RandomBytes(3000);
+        std::vector<uint8_t> expected(plain.size()), actual(plain.size());
+
+        ReferenceEncrypt(plain.data(), expected.data(), plain.size(), (int)position);
+        cipher.Encrypt(plain.data(), actual.data(), plain.size(), position);
+        REQUIRE(actual == expected);
+    }
+
+    SECTION("Decrypts in place")
+    {
+        auto plain = RandomBytes(4096);
+        auto data = plain;
+        cipher.Encrypt(data.data(), data.data(), data.size());
+        REQUIRE(data != plain);
+
+        cipher.Decrypt(data.data(), data.data(), data.size());
+        REQUIRE(data == plain);
+    }
+
+    SECTION("Encrypting in chunks matches encrypting at once")
+    {
+        auto plain = RandomBytes(10000);
+        std::vector<uint8_t> whole(plain.size()), chunked(plain.size());
+        cipher.Encrypt(plain.data(), whole.data(), plain.size());
+
+        for (size_t position = 0; position < plain.size(); position += 1000)
+            cipher.Encrypt(plain.data() + position, chunked.data() + position, 1000, position);
+        REQUIRE(chunked == whole);
+    }
+}
+
+// Throughput in MB/s is 4 divided by the mean time in seconds
+TEST_CASE("Cipher benchmarks", "[Cipher][!benchmark]")
+{
+    const size_t Size = 4 * 1024 * 1024; // a large atlas
+    IO::Cipher cipher(CipherTestKey);
+    auto data = RandomBytes(Size);
+    std::vector<uint8_t> out(Size);
+
+    BENCHMARK("Per-byte decrypt loop: 4 MB")
+    {
+        ReferenceDecrypt(data.data(), out.data(), Size);
+        return out[Size - 1];
+    };
+
+    BENCHMARK("Cipher::Decrypt: 4 MB")
+    {
+        cipher.Decrypt(data.data(), out.data(), Size);
+        return out[Size - 1];
+    };
+
+    BENCHMARK("Per-byte encrypt loop: 4 MB")
+    {
+        ReferenceEncrypt(data.data(), out.data(), Size);
+        return out[Size - 1];
+    };
+
+    BENCHMARK("Cipher::Encrypt: 4 MB")
+    {
+        cipher.Encrypt(data.data(), out.data(), Size);
+        return out[Size - 1];
+    };
+}
@@ -0,0 +1,163 @@
+#include "SDG_Tests.h"
+#include <Engine/Lib/DensePool.h>
+
+#include <string>
+#include <vector>
+
+TEST_CASE("DensePool tests", "[DensePool]")
+{
+    SECTION("Handles are 32 bits")
+    {
+        REQUIRE(sizeof(PoolHandle) == 4);
+        REQUIRE(PoolHandle::Null.IsNull());
+        REQUIRE(!PoolHandle(0, 0).IsNull());
+    }
+
+    SECTION("Constructor creates an empty pool")
+    {
+        DensePool<int> pool(64);
+
+        REQUIRE(pool.LiveCount() == 0);
+        REQUIRE(pool.SlotCount() == 0);
+        REQUIRE(pool.begin() == pool.end());
+    }
+
+    SECTION("Checkout")
+    {
+        DensePool<std::string> pool;
+        PoolHandle handle = pool.Checkout("hello");
+
+        REQUIRE(pool.LiveCount() == 1);
+        REQUIRE(pool.IDValid(handle));
+        REQUIRE(*pool[handle] == "hello");
+    }
+
+    SECTION("PutBack")
+    {
+        DensePool<int> pool;
+        PoolHandle handle = pool.Checkout(10);
+        pool.PutBack(handle);
+
+        REQUIRE(!pool.IDValid(handle));
+        REQUIRE(!pool[handle]);
+        REQUIRE(pool.LiveCount() == 0);
+
+        // Putting back a stale handle does nothing
+        PoolHandle other = pool.Checkout(20);
+        pool.PutBack(handle);
+        REQUIRE(pool.IDValid(other));
+        REQUIRE(pool.LiveCount() == 1);
+    }
+
+    SECTION("Slots are reused with a new generation")
+    {
+        DensePool<int> pool;
+        PoolHandle first = pool.Checkout(1);
+        pool.PutBack(first);
+        PoolHandle second = pool.Checkout(2);
+
+        REQUIRE(second.Index() == first.Index());
+        REQUIRE(second.Generation() != first.Generation());
+        REQUIRE(!pool.IDValid(first));
+        REQUIRE(*pool[second] == 2);
+        REQUIRE(pool.SlotCount() == 1);
+    }
+
+    SECTION("Slots are retired when their generations run out")
+    {
+        DensePool<int> pool;
+        PoolHandle first = pool.Checkout(0);
+        pool.PutBack(first);
+        for (uint32_t i = 0; i < PoolHandle::MaxGeneration; ++i)
+            pool.PutBack(pool.Checkout(1));
+
+        // The slot has been through its last generation, so it is not reused
+        PoolHandle next = pool.Checkout(2);
+        REQUIRE(next.Index() != first.Index());
+        REQUIRE(next.Generation() == 0);
+        REQUIRE(!pool.IDValid(first));
+        REQUIRE(pool.SlotCount() == 2);
+    }
+
+    SECTION("PutBack keeps live objects packed")
+    {
+        DensePool<int> pool;
+        std::vector<PoolHandle> handles;
+        for (int i = 0; i < 10; ++i)
+            handles.emplace_back(pool.Checkout(i));
+
+        pool.PutBack(handles[2]);
+        pool.PutBack(handles[5]);
+
+        REQUIRE(pool.LiveCount() == 8);
+        REQUIRE(pool.end() - pool.begin() == 8);
+
+        int sum = 0;
+        for (int value : pool)
+            sum += value;
+        REQUIRE(sum == 45 - 2 - 5);
+
+        // Handles still find the objects that were moved
+        for (int i = 0; i < 10; ++i)
+        {
+            if (i == 2 || i == 5)
+                REQUIRE(!pool.IDValid(handles[i]));
+            else
+                REQUIRE(*pool[handles[i]] == i);
+        }
+
+        for (size_t i = 0; i < pool.LiveCount(); ++i)
+            REQUIRE(*pool[pool.HandleAt(i)] == pool.At(i));
+    }
+
+    SECTION("Objects can be put back while iterating backwards")
+    {
+        DensePool<int> pool;
+        for (int i = 0; i < 100; ++i)
+            (void)pool.Checkout(i);
+
+        for (size_t i = pool.LiveCount(); i-- > 0; )
+        {
+            if (pool.At(i) % 2 == 0)
+                pool.PutBack(pool.HandleAt(i));
+        }
+
+        REQUIRE(pool.LiveCount() == 50);
+        for (int value : pool)
+            REQUIRE(value % 2 == 1);
+    }
+
+    SECTION("PutBackAll")
+    {
+        DensePool<int> pool;
+        std::vector<PoolHandle> handles;
+        for (int i = 0; i < 17; ++i)
+            handles.emplace_back(pool.Checkout(i));
+
+        pool.PutBackAll();
+        REQUIRE(pool.LiveCount() == 0);
+        for (PoolHandle handle : handles)
+            REQUIRE(!pool.IDValid(handle));
+
+        // Slots are reused rather than added
+        for (int i = 0; i < 17; ++i)
+            REQUIRE(pool.IDValid(pool.Checkout(i)));
+        REQUIRE(pool.SlotCount() == 17);
+    }
+
+    SECTION("Move and swap")
+    {
+        DensePool<int> a;
+        PoolHandle handle = a.Checkout(7);
+
+        DensePool<int> b(std::move(a));
+        REQUIRE(a.LiveCount() == 0);
+        REQUIRE(!a.IDValid(handle));
+        REQUIRE(*b[handle] == 7);
+
+        DensePool<int> c;
+        std::swap(b, c);
+        REQUIRE(b.LiveCount() == 0);
+        REQUIRE(*c[handle] == 7);
+    }
+}
@@ -0,0 +1,116 @@
+/*!
+ * @file FileWatcherTests.cpp
+ * Contains tests for SDG::FileWatcher, and for SDG::HotReload dispatching the changes it reports
+ */
+#include "SDG_Tests.h"
+#include <Engine/Filesys/FileWatcher.h>
+#include <Engine/Game/HotReload.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static void WriteTextFile(const fs::path &path, const char *text)
+{
+    std::ofstream file(path, std::ios::trunc | std::ios::binary);
+    REQUIRE(file.is_open());
+    file << text;
+}
+
+TEST_CASE("FileWatcher tests", "[FileWatcher]")
+{
+    if (!FileWatcher::IsSupported())
+        return; // nothing to test on this platform
+
+    const fs::path dir = fs::temp_directory_path() / "SDG_FileWatcherTests";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "sub");
+    const Path dirPath(dir.string().c_str());
+
+    FileWatcher watcher;
+    REQUIRE(watcher.Watch(dirPath));
+    REQUIRE(watcher.Count() == 2);
+
+    std::vector<Path> changed;
+    auto poll = [&watcher, &changed]() {
+        changed.clear();
+        return watcher.Poll([&changed](const Path &path) { changed.emplace_back(path); });
+    };
+
+    SECTION("Nothing is reported before a change")
+    {
+        REQUIRE(poll() == 0);
+    }
+
+    SECTION("Written files are reported once, with the directory's base")
+    {
+        WriteTextFile(dir / "a.txt", "1");
+        WriteTextFile(dir / "a.txt", "2");
+        WriteTextFile(dir / "sub" / "b.txt", "3");
+
+        REQUIRE(poll() == 2);
+        REQUIRE(changed[0] == dirPath + "a.txt");
+        REQUIRE(changed[0].Hash() == Path((dir / "a.txt").string().c_str()).Hash());
+        REQUIRE(changed[1] == dirPath + "sub/b.txt");
+        REQUIRE(poll() == 0);
+    }
+
+    SECTION("Files moved in are reported")
+    {
+        const fs::path outside = fs::temp_directory_path() / "SDG_FileWatcherTests_moved.txt";
+        WriteTextFile(outside, "moved");
+        fs::rename(outside, dir / "moved.txt");
+
+        REQUIRE(poll() == 1);
+        REQUIRE(changed[0] == dirPath + "moved.txt");
+    }
+
+    SECTION("New subdirectories are watched")
+    {
+        fs::create_directory(dir / "new");
+        REQUIRE(poll() == 0);
+        REQUIRE(watcher.Count() == 3);
+
+        WriteTextFile(dir / "new" / "c.txt", "4");
+        REQUIRE(poll() == 1);
+        REQUIRE(changed[0] == dirPath + "new/c.txt");
+    }
+
+    SECTION("Closing stops reporting")
+    {
+        watcher.Close();
+        WriteTextFile(dir / "a.txt", "5");
+        REQUIRE(poll() == 0);
+        REQUIRE(watcher.Count() == 0);
+    }
+
+    SECTION("HotReload invokes reloaders of changed content")
+    {
+        HotReload reload;
+        REQUIRE(reload.WatchContent(dirPath));
+
+        int reloadsA = 0, reloadsB = 0;
+        int owner;
+        reload.Add(dirPath + "a.txt", [&reloadsA](const Path &) { ++reloadsA; }, &owner);
+        reload.Add(dirPath + "sub/b.txt", [&reloadsB](const Path &) { ++reloadsB; });
+
+        WriteTextFile(dir / "a.txt", "6");
+        reload.Update();
+        REQUIRE(reloadsA == 1);
+        REQUIRE(reloadsB == 0);
+
+        reload.Remove(&owner);
+        WriteTextFile(dir / "a.txt", "7");
+        WriteTextFile(dir / "sub" / "b.txt", "8");
+        reload.Update();
+        REQUIRE(reloadsA == 1);
+        REQUIRE(reloadsB == 1);
+        REQUIRE(reload.PipelineCount() == 0);
+    }
+
+    watcher.Close();
+    fs::remove_all(dir);
+}
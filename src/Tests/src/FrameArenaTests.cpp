@@ -0,0 +1,135 @@
+#include "SDG_Tests.h"
+#include <Engine/Lib/AllocationCounter.h>
+#include <Engine/Lib/Array.h>
+#include <Engine/Lib/FrameArena.h>
+#include <Engine/Lib/StdAllocator.h>
+#include <Engine/Lib/String.h>
+
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("FrameArena tests", "[FrameArena]")
+{
+    FrameArena arena(1024);
+
+    SECTION("Allocations are aligned")
+    {
+        void *a = arena.Allocate(1, 1);
+        void *b = arena.Allocate(8, 64);
+        double *c = arena.AllocateArray<double>(4);
+
+        REQUIRE(a != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(b) % 64 == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(c) % alignof(double) == 0);
+        REQUIRE(arena.Used() >= 1 + 8 + sizeof(double) * 4);
+    }
+
+    SECTION("Reset releases everything and reuses memory")
+    {
+        void *first = arena.Allocate(100);
+        arena.Allocate(200);
+        arena.Reset();
+
+        REQUIRE(arena.Used() == 0);
+        REQUIRE(arena.Allocate(100) == first);
+    }
+
+    SECTION("Reset merges an outgrown frame into one block")
+    {
+        for (int i = 0; i < 10; ++i)
+            arena.Allocate(512);
+        REQUIRE(arena.BlockCount() > 1);
+
+        size_t used = arena.Used();
+        arena.Reset();
+        REQUIRE(arena.BlockCount() == 1);
+        REQUIRE(arena.Capacity() >= used);
+        REQUIRE(arena.PeakUsed() == used);
+
+        // The same frame now fits without growing
+        for (int i = 0; i < 10; ++i)
+            arena.Allocate(512);
+        REQUIRE(arena.BlockCount() == 1);
+    }
+
+    SECTION("Last allocation resizes and releases in place")
+    {
+        arena.Allocate(16);
+        void *block = arena.Allocate(32);
+        size_t used = arena.Used();
+
+        REQUIRE(arena.Reallocate(block, 32, 128) == block);
+        REQUIRE(arena.Used() == used + 96);
+
+        arena.Deallocate(block, 128);
+        REQUIRE(arena.Used() == used - 32);
+    }
+
+    SECTION("Reallocating an earlier allocation copies it")
+    {
+        auto first = static_cast<char *>(arena.Allocate(4));
+        memcpy(first, "abc", 4);
+        arena.Allocate(4);
+
+        auto moved = static_cast<char *>(arena.Reallocate(first, 4, 64));
+        REQUIRE(moved != first);
+        REQUIRE(strcmp(moved, "abc") == 0);
+    }
+
+    SECTION("Array with the arena")
+    {
+        Array<int> arr(8, arena);
+        for (size_t i = 0; i < arr.Size(); ++i)
+            arr[i] = (int)i;
+
+        REQUIRE(arena.Used() >= sizeof(int) * 8);
+        REQUIRE(arr[7] == 7);
+
+        Array<int> moved(std::move(arr));
+        REQUIRE(moved[7] == 7);
+
+        // Copies live on the heap, and stay valid after the frame
+        Array<int> copied(moved);
+        arena.Reset();
+        REQUIRE(copied[7] == 7);
+    }
+
+    SECTION("String with the arena")
+    {
+        String str("Hello", arena);
+        size_t used = arena.Used();
+        REQUIRE(used > 0);
+
+        str += ", world! This is long enough to make the String grow.";
+        REQUIRE(str == "Hello, world! This is long enough to make the String grow.");
+
+        String formatted = String::Format(arena, "{} + {} = {}", 1, 2, 3);
+        REQUIRE(formatted == "1 + 2 = 3");
+        REQUIRE(arena.Used() > used);
+    }
+
+    SECTION("std::vector with StdAllocator")
+    {
+        std::vector<int, StdAllocator<int>> values{ StdAllocator<int>(arena) };
+        for (int i = 0; i < 100; ++i)
+            values.push_back(i);
+
+        REQUIRE(values.size() == 100);
+        REQUIRE(values[99] == 99);
+        REQUIRE(arena.Used() >= sizeof(int) * 100);
+    }
+
+    SECTION("Arena allocations are not counted as heap allocations")
+    {
+        AllocationCounter::Reset();
+        arena.Allocate(128);
+        String str("frame text", arena);
+        REQUIRE(AllocationCounter::Count() == 0);
+
+        if constexpr (AllocationCounter::Enabled)
+        {
+            String heapStr("heap text");
+            REQUIRE(AllocationCounter::Count() > 0);
+        }
+    }
+}
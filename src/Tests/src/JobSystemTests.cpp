@@ -0,0 +1,202 @@
+/*!
+ * @file JobSystemTests.cpp
+ * Contains tests for SDG::JobSystem
+ */
+#include "SDG_Tests.h"
+#include <Engine/Jobs/JobSystem.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST_CASE("JobSystem", "[JobSystem]")
+{
+    JobSystem jobs;
+
+    SECTION("Jobs run on the waiting thread when there are no workers")
+    {
+        REQUIRE(jobs.WorkerCount() == 0);
+
+        JobCounter counter;
+        int sum = 0;
+        for (int i = 1; i <= 10; ++i)
+            jobs.Run([&sum, i]() { sum += i; }, &counter);
+
+        REQUIRE(counter.Pending() == 10);
+        jobs.Wait(counter);
+        REQUIRE(counter.IsDone());
+        REQUIRE(sum == 55);
+    }
+
+    SECTION("Workers run jobs, and the jobs they spawn")
+    {
+        jobs.Start(4);
+        REQUIRE(jobs.WorkerCount() == 4);
+        REQUIRE(!jobs.IsWorkerThread());
+
+        // Without a Wait on this thread, only a worker can run the job
+        std::atomic<bool> onWorker(false), done(false);
+        jobs.Run([&]() {
+            onWorker = jobs.IsWorkerThread();
+            done = true;
+        });
+        while (!done)
+            std::this_thread::yield();
+        REQUIRE(onWorker);
+
+        JobCounter counter;
+        std::atomic<int> count(0);
+        for (int i = 0; i < 100; ++i)
+        {
+            jobs.Run([&]() {
+                for (int j = 0; j < 10; ++j)
+                    jobs.Run([&]() { ++count; }, &counter);
+            }, &counter);
+        }
+
+        jobs.Wait(counter);
+        REQUIRE(count == 1000);
+    }
+
+    SECTION("Jobs may wait on jobs of their own")
+    {
+        jobs.Start(2);
+
+        JobCounter outer;
+        std::atomic<int> count(0);
+        for (int i = 0; i < 8; ++i)
+        {
+            jobs.Run([&]() {
+                JobCounter inner;
+                for (int j = 0; j < 8; ++j)
+                    jobs.Run([&]() { ++count; }, &inner);
+                jobs.Wait(inner);
+            }, &outer);
+        }
+
+        jobs.Wait(outer);
+        REQUIRE(count == 64);
+    }
+
+    SECTION("Wait rethrows the first exception a counted job threw")
+    {
+        jobs.Start(2);
+
+        JobCounter counter;
+        std::atomic<int> ran(0);
+        jobs.Run([]() { throw std::runtime_error("job failed"); }, &counter);
+        for (int i = 0; i < 10; ++i)
+            jobs.Run([&]() { ++ran; }, &counter);
+
+        bool threw = false;
+        try {
+            jobs.Wait(counter);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+
+        REQUIRE(threw);
+        REQUIRE(ran == 10);
+
+        // The counter can be reused
+        jobs.Run([&]() { ++ran; }, &counter);
+        jobs.Wait(counter);
+        REQUIRE(ran == 11);
+    }
+
+    SECTION("Jobs run after the jobs of a counter finish")
+    {
+        jobs.Start(3);
+
+        JobCounter first, second;
+        std::atomic<int> firstDone(0);
+        std::atomic<bool> ranEarly(false);
+        for (int i = 0; i < 20; ++i)
+            jobs.Run([&]() { std::this_thread::yield(); ++firstDone; }, &first);
+        for (int i = 0; i < 5; ++i)
+            jobs.RunAfter(first, [&]() { if (firstDone != 20) ranEarly = true; }, &second);
+
+        jobs.Wait(second);
+        REQUIRE(!ranEarly);
+        jobs.Wait(first);
+
+        // A dependency that is already done does not hold the job back
+        jobs.RunAfter(first, [&]() { ++firstDone; }, &second);
+        jobs.Wait(second);
+        REQUIRE(firstDone == 21);
+    }
+
+    SECTION("ParallelFor covers the whole range once")
+    {
+        jobs.Start(3);
+
+        std::vector<int> hits(10007, 0);
+        jobs.ParallelFor(hits.size(), 0, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                ++hits[i];
+        });
+        REQUIRE(std::count(hits.begin(), hits.end(), 1) == (long)hits.size());
+
+        // Catch assertions are not thread-safe, so batches are checked back on this thread
+        std::mutex batchMutex;
+        std::vector<std::pair<size_t, size_t>> batches;
+        jobs.ParallelFor(100, 30, [&](size_t begin, size_t end) {
+            std::lock_guard lock(batchMutex);
+            batches.emplace_back(begin, end);
+        });
+
+        std::sort(batches.begin(), batches.end());
+        REQUIRE(batches == std::vector<std::pair<size_t, size_t>>{ {0, 30}, {30, 60}, {60, 90}, {90, 100} });
+    }
+
+    SECTION("Main-thread jobs only run on the main thread")
+    {
+        jobs.Start(2);
+        REQUIRE(jobs.IsMainThread());
+
+        JobCounter counter;
+        std::atomic<int> onMain(0);
+        for (int i = 0; i < 10; ++i)
+        {
+            jobs.Run([&]() {
+                jobs.RunOnMainThread([&]() {
+                    if (jobs.IsMainThread())
+                        ++onMain;
+                }, &counter);
+            }, &counter);
+        }
+
+        // Wait pumps main-thread jobs when called from the main thread
+        jobs.Wait(counter);
+        REQUIRE(onMain == 10);
+
+        jobs.RunOnMainThread([&]() { ++onMain; });
+        REQUIRE(onMain == 10);
+        jobs.PumpMainThread();
+        REQUIRE(onMain == 11);
+    }
+
+    SECTION("Stop runs the jobs left, and the system can start again")
+    {
+        jobs.Start(2);
+        std::atomic<int> count(0);
+        for (int i = 0; i < 50; ++i)
+            jobs.Run([&]() { ++count; });
+
+        jobs.Stop();
+        REQUIRE(count == 50);
+        REQUIRE(jobs.WorkerCount() == 0);
+
+        jobs.Start(1);
+        JobCounter counter;
+        jobs.Run([&]() { ++count; }, &counter);
+        jobs.Wait(counter);
+        REQUIRE(count == 51);
+    }
+}
@@ -0,0 +1,305 @@
+/*!
+ * @file NullRenderBackendTests.cpp
+ * Contains tests for class SDG::NullRenderBackend, RenderStats counting on top of it, and headless rendering
+ * benchmarks
+ */
+#include "SDG_Tests.h"
+#include "ScopedNullBackend.h"
+#include <Engine/Game/Graphics/SpriteBatch.h>
+#include <Engine/Game/Graphics/StaticBatch.h>
+#include <Engine/Graphics/NullRenderBackend.h>
+#include <Engine/Graphics/RenderStats.h>
+#include <Engine/Graphics/RenderTarget.h>
+#include <Engine/Graphics/Texture.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+using Type = RenderCommand::Type;
+
+TEST_CASE("NullRenderBackend tests", "[NullRenderBackend]")
+{
+    ScopedNullBackend scope;
+    NullRenderBackend &backend = scope.backend;
+    RenderLog &log = backend.Log();
+
+    const uint8_t pixels[4 * 4 * 4]{};
+
+    SECTION("Textures load without a context")
+    {
+        {
+            Texture texture;
+            REQUIRE(texture.LoadPixels(nullptr, 4, 4, pixels));
+            REQUIRE(texture.Size() == Point(4, 4));
+            REQUIRE(backend.ImageCount() == 1);
+            REQUIRE(log.Count(Type::CreateImage) == 1);
+            REQUIRE(log.BytesUploaded() == 4 * 4 * 4);
+
+            texture.FilterMode(Texture::Filter::Nearest);
+            REQUIRE(texture.FilterMode() == Texture::Filter::Nearest);
+        }
+
+        REQUIRE(backend.ImageCount() == 0);
+        REQUIRE(log.Count(Type::FreeImage) == 1);
+    }
+
+    SECTION("RenderTarget calls are recorded")
+    {
+        RenderTarget target(backend.CreateTarget(320, 240));
+        REQUIRE(target.Size() == Point(320, 240));
+
+        target.Clear();
+        target.DrawColor(Color::Red());
+        REQUIRE(target.DrawColor() == Color::Red());
+        target.DrawRectangle({0, 0, 10, 10});
+        target.SwapBuffers();
+
+        REQUIRE(log.Count(Type::Clear) == 1);
+        REQUIRE(log.Count(Type::TargetColor) == 1);
+        REQUIRE(log.DrawCalls() == 1);
+        REQUIRE(log.Count(Type::SwapBuffers) == 1);
+        REQUIRE(log.Commands().back().type == Type::SwapBuffers);
+    }
+
+    SECTION("SpriteBatch submissions are recorded")
+    {
+        RenderTarget target(backend.CreateTarget(320, 240));
+        Texture textureA, textureB;
+        REQUIRE(textureA.LoadPixels(nullptr, 4, 4, pixels));
+        REQUIRE(textureB.LoadPixels(nullptr, 4, 4, pixels));
+
+        SpriteBatch batch;
+        REQUIRE(batch.Initialize(nullptr));
+
+        auto drawInterleaved = [&](SortMode sortMode, SubmitMode submitMode) {
+            log.Clear();
+            batch.Begin(target, nullptr, sortMode, submitMode);
+            for (int i = 0; i < 10; ++i)
+                batch.DrawTexture(i % 2 ? &textureA : &textureB, {(float)i, 0});
+            batch.End();
+        };
+
+        SECTION("Blit mode: one blit and color change per draw")
+        {
+            drawInterleaved(SortMode::None, SubmitMode::Blit);
+            REQUIRE(log.Count(Type::Blit) == 10);
+            REQUIRE(log.Count(Type::TargetColor) == 10);
+            REQUIRE(log.TextureSwitches() == 9);
+            REQUIRE(log.Count(Type::ActiveTarget) == 2); // set, then restored
+        }
+
+        SECTION("Geometry mode: one triangle batch per texture run")
+        {
+            drawInterleaved(SortMode::None, SubmitMode::Geometry);
+            REQUIRE(log.Count(Type::TriangleBatch) == 10);
+
+            drawInterleaved(SortMode::Texture, SubmitMode::Geometry);
+            REQUIRE(log.Count(Type::TriangleBatch) == 2);
+            REQUIRE(log.TextureSwitches() == 1);
+            REQUIRE(log.Vertices() == 40);
+            REQUIRE(log.Indices() == 60);
+        }
+
+        SECTION("Shapes share triangle batches, and are grouped between blits")
+        {
+            const Vector2 points[3] = { {0, 0}, {10, 0}, {10, 10} };
+            auto drawShapes = [&](SubmitMode submitMode) {
+                log.Clear();
+                batch.Begin(target, nullptr, SortMode::None, submitMode);
+                batch.DrawRectangle({0, 0, 4, 4}, {0, 0}, Color::White());
+                batch.DrawLines(points, 3, 1.f, Color::White(), 0);
+                batch.DrawCircle({20, 20, 5}, Color::White(), 0, 8);
+                batch.End();
+            };
+
+            drawShapes(SubmitMode::Geometry);
+            REQUIRE(log.Count(Type::TriangleBatch) == 1);
+            REQUIRE(log.Vertices() == 4 + 6 + 9);
+
+            drawShapes(SubmitMode::Blit);
+            REQUIRE(log.Count(Type::Blit) == 1);
+            REQUIRE(log.Count(Type::TriangleBatch) == 1);
+            REQUIRE(log.Vertices() == 6 + 9);
+        }
+
+        SECTION("StaticBatch replays its baked runs")
+        {
+            SpriteBatch::Recorder recorder(batch);
+            for (int i = 0; i < 10; ++i)
+                recorder.DrawTexture(i % 2 ? &textureA : &textureB, {(float)i, 0});
+
+            StaticBatch staticBatch;
+            staticBatch.Build(recorder, SortMode::Texture);
+
+            log.Clear();
+            staticBatch.Draw(target);
+            REQUIRE(log.Count(Type::TriangleBatch) == 2);
+        }
+    }
+
+    SECTION("Commands can be left out, keeping totals")
+    {
+        log.RecordCommands(false);
+        Texture texture;
+        REQUIRE(texture.LoadPixels(nullptr, 4, 4, pixels));
+        REQUIRE(log.Commands().empty());
+        REQUIRE(log.Count(Type::CreateImage) == 1);
+    }
+}
+
+TEST_CASE("RenderStats tests", "[RenderStats]")
+{
+    ScopedNullBackend scope;
+    NullRenderBackend &backend = scope.backend;
+    RenderStats &stats = RenderStats::Frame();
+    stats.Reset();
+
+    const uint8_t pixels[4 * 4 * 4]{};
+    RenderTarget target(backend.CreateTarget(320, 240));
+    Texture textureA, textureB;
+    REQUIRE(textureA.LoadPixels(nullptr, 4, 4, pixels));
+    REQUIRE(textureB.LoadPixels(nullptr, 4, 4, pixels));
+
+    SpriteBatch batch;
+    REQUIRE(batch.Initialize(nullptr));
+
+    auto drawInterleaved = [&](SortMode sortMode, SubmitMode submitMode) {
+        stats.Reset();
+        batch.Begin(target, nullptr, sortMode, submitMode);
+        for (int i = 0; i < 10; ++i)
+            batch.DrawTexture(i % 2 ? &textureA : &textureB, {(float)i, 0});
+        batch.End();
+    };
+
+    SECTION("Reset zeroes everything")
+    {
+        stats.drawCalls = 3;
+        stats.sortSeconds = 1.0;
+        stats.Reset();
+        REQUIRE(stats.drawCalls == 0);
+        REQUIRE(stats.sortSeconds == 0);
+    }
+
+    SECTION("RenderTarget draws are counted")
+    {
+        target.DrawColor(Color::Red());
+        target.DrawTexture(&textureA, {0, 0, 4, 4}, {0, 0, 4, 4}, 0, {}, Flip::None);
+        target.DrawRectangle({0, 0, 10, 10});
+        target.DrawCircle({{5, 5}, 5});
+
+        REQUIRE(stats.drawCalls == 3);
+        REQUIRE(stats.vertices == 4);
+        REQUIRE(stats.colorChanges == 1);
+    }
+
+    SECTION("SpriteBatch blits count one draw call per sprite")
+    {
+        drawInterleaved(SortMode::None, SubmitMode::Blit);
+        REQUIRE(stats.sprites == 10);
+        REQUIRE(stats.drawCalls == 10);
+        REQUIRE(stats.colorChanges == 10);
+        REQUIRE(stats.textureChanges == 9);
+        REQUIRE(stats.targetChanges == 2); // set, then restored
+        REQUIRE(stats.batchBreaks == 0);
+        REQUIRE(stats.sortSeconds >= 0);
+        REQUIRE(stats.submitSeconds >= 0);
+    }
+
+    SECTION("SpriteBatch geometry counts batch breaks")
+    {
+        drawInterleaved(SortMode::None, SubmitMode::Geometry);
+        REQUIRE(stats.drawCalls == 10);
+        REQUIRE(stats.batchBreaks == 9);
+        REQUIRE(stats.textureChanges == 9);
+        REQUIRE(stats.vertices == 40);
+
+        drawInterleaved(SortMode::Texture, SubmitMode::Geometry);
+        REQUIRE(stats.drawCalls == 2);
+        REQUIRE(stats.batchBreaks == 1);
+        REQUIRE(stats.textureChanges == 1);
+        REQUIRE(stats.colorChanges == 1);
+    }
+
+    SECTION("Culled draws are counted")
+    {
+        stats.Reset();
+        batch.Begin(target);
+        batch.CullRect({0, 0, 10, 10});
+        batch.DrawTexture(&textureA, {0, 0});
+        batch.DrawTexture(&textureA, {100, 100});
+        batch.End();
+
+        REQUIRE(stats.sprites == 1);
+        REQUIRE(stats.culled == 1);
+    }
+
+    SECTION("StaticBatch draws are counted")
+    {
+        SpriteBatch::Recorder recorder(batch);
+        for (int i = 0; i < 10; ++i)
+            recorder.DrawTexture(i % 2 ? &textureA : &textureB, {(float)i, 0});
+
+        StaticBatch staticBatch;
+        staticBatch.Build(recorder, SortMode::Texture);
+
+        stats.Reset();
+        staticBatch.Draw(target);
+        REQUIRE(stats.sprites == 10);
+        REQUIRE(stats.drawCalls == 2);
+        REQUIRE(stats.textureChanges == 1);
+        REQUIRE(stats.vertices == 40);
+    }
+
+    stats.Reset();
+}
+
+TEST_CASE("Headless render benchmarks", "[NullRenderBackend][!benchmark]")
+{
+    const int SpriteCount = 20000;
+
+    ScopedNullBackend scope;
+    RenderLog &log = scope.backend.Log();
+    log.RecordCommands(false);
+
+    RenderTarget target(scope.backend.CreateTarget(640, 480));
+
+    const uint8_t pixels[16 * 16 * 4]{};
+    Texture textures[4];
+    for (auto &texture : textures)
+        REQUIRE(texture.LoadPixels(nullptr, 16, 16, pixels));
+
+    SpriteBatch batch;
+    REQUIRE(batch.Initialize(nullptr));
+
+    auto drawFrame = [&](SortMode sortMode, SubmitMode submitMode) {
+        batch.Begin(target, nullptr, sortMode, submitMode);
+        for (int i = 0; i < SpriteCount; ++i)
+            batch.DrawTexture(&textures[i % 4], {(float)(i % 640), (float)(i % 480)}, {1.f, 1.f}, {.5f, .5f},
+                (float)i, (float)(i % 8));
+        batch.End();
+    };
+
+    BENCHMARK("Blit, front to back: 20000 sprites")
+    {
+        drawFrame(SortMode::FrontToBack, SubmitMode::Blit);
+    };
+
+    BENCHMARK("Geometry, front to back: 20000 sprites")
+    {
+        drawFrame(SortMode::FrontToBack, SubmitMode::Geometry);
+    };
+
+    BENCHMARK("Geometry, texture sorted: 20000 sprites")
+    {
+        drawFrame(SortMode::Texture, SubmitMode::Geometry);
+    };
+
+    // Per-frame totals, printed with WARN in every build so regressions in batching show up next to the timings
+    for (SubmitMode submitMode : { SubmitMode::Blit, SubmitMode::Geometry })
+    {
+        log.Clear();
+        drawFrame(SortMode::Texture, submitMode);
+        WARN((submitMode == SubmitMode::Blit ? "Blit" : "Geometry") << " mode: draw calls: " << log.DrawCalls()
+            << ", state changes: " << log.StateChanges() << ", texture switches: " << log.TextureSwitches());
+        CHECK(log.DrawCalls() > 0);
+    }
+}
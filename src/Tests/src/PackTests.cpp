@@ -0,0 +1,183 @@
+#include "SDG_Tests.h"
+#include <ContentPipe/PackWriter.h>
+#include <Engine/Filesys/Pack.h>
+#include <Engine/Filesys/PackFormat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// Writes a plaintext pack laid out the way SDG_ContentPipe writes them
+    void WriteTestPack(const std::string &path, std::vector<std::pair<std::string, std::string>> files)
+    {
+        using namespace SDG::PackFormat;
+
+        std::sort(files.begin(), files.end(), [](const auto &a, const auto &b) {
+            return HashPath(a.first) < HashPath(b.first);
+        });
+
+        std::vector<TocEntry> toc(files.size());
+        std::string names;
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            toc[i].pathHash = HashPath(files[i].first);
+            toc[i].nameOffset = (uint32_t)names.size();
+            toc[i].nameLength = (uint16_t)files[i].first.size();
+            names += files[i].first;
+        }
+
+        Header header{};
+        std::memcpy(header.magic, Magic, sizeof(header.magic));
+        header.version = Version;
+        header.entryCount = (uint32_t)toc.size();
+        header.alignment = Alignment;
+        header.namesOffset = sizeof(Header) + toc.size() * sizeof(TocEntry);
+        header.namesSize = names.size();
+
+        uint64_t offset = Align(header.namesOffset + header.namesSize);
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            toc[i].offset = offset;
+            toc[i].size = files[i].second.size();
+            offset = Align(offset + toc[i].size + 1);
+        }
+
+        std::string data((size_t)offset, '\0');
+        std::memcpy(data.data(), &header, sizeof(Header));
+        std::memcpy(data.data() + sizeof(Header), toc.data(), toc.size() * sizeof(TocEntry));
+        std::memcpy(data.data() + header.namesOffset, names.data(), names.size());
+        for (size_t i = 0; i < files.size(); ++i)
+            std::memcpy(data.data() + toc[i].offset, files[i].second.data(), files[i].second.size());
+
+        std::ofstream(path, std::ios::binary).write(data.data(), (std::streamsize)data.size());
+    }
+}
+
+TEST_CASE("Pack tests", "[Pack]")
+{
+    const std::string packPath = (std::filesystem::temp_directory_path() / "SDG_PackTests.sdgpack").string();
+    WriteTestPack(packPath, {
+        { "data.sdgc", "{ \"a\": 1 }" },
+        { "fonts/font.sdgc", "font data" },
+        { "img/a.sdgc", std::string(100, 'x') },
+    });
+
+    SECTION("Opens and finds files")
+    {
+        Pack pack(Path(packPath.c_str(), Path::BaseDir::None));
+        REQUIRE(pack.IsOpen());
+        REQUIRE(pack.EntryCount() == 3);
+
+        Pack::Entry entry;
+        REQUIRE(pack.Find("fonts/font.sdgc", &entry));
+        REQUIRE(entry.size == 9);
+        REQUIRE(std::memcmp(entry.data, "font data", 9) == 0);
+        REQUIRE(entry.data[entry.size] == '\0');
+        REQUIRE(!entry.encrypted);
+        REQUIRE((uintptr_t)entry.data % PackFormat::Alignment == 0);
+
+        REQUIRE(pack.Find("img/a.sdgc", &entry));
+        REQUIRE(entry.size == 100);
+
+        REQUIRE(!pack.Find("fonts/missing.sdgc", &entry));
+        REQUIRE(!pack.Find("fonts", &entry));
+    }
+
+    SECTION("Rejects files that are not packs")
+    {
+        const std::string junkPath = packPath + ".junk";
+        std::ofstream(junkPath, std::ios::binary) << std::string(64, 'j');
+
+        Pack pack(Path(junkPath.c_str(), Path::BaseDir::None));
+        REQUIRE(!pack.IsOpen());
+        REQUIRE(pack.EntryCount() == 0);
+        REQUIRE(!pack.Find("data.sdgc", nullptr));
+
+        std::filesystem::remove(junkPath);
+    }
+
+    SECTION("Rejects offsets and sizes that would wrap around")
+    {
+        std::string data;
+        {
+            std::ifstream file(packPath, std::ios::binary);
+            data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        auto rejects = [&packPath](const std::string &damaged) {
+            const std::string damagedPath = packPath + ".damaged";
+            std::ofstream(damagedPath, std::ios::binary).write(damaged.data(), (std::streamsize)damaged.size());
+            bool rejected = !Pack(Path(damagedPath.c_str(), Path::BaseDir::None)).IsOpen();
+            std::filesystem::remove(damagedPath);
+            return rejected;
+        };
+
+        // namesOffset + namesSize wraps to 0
+        PackFormat::Header header;
+        std::memcpy(&header, data.data(), sizeof(header));
+        std::string damaged = data;
+        header.namesSize = ~header.namesOffset + 1;
+        std::memcpy(damaged.data(), &header, sizeof(header));
+        REQUIRE(rejects(damaged));
+
+        // offset + size + 1 wraps to a small number
+        PackFormat::TocEntry entry;
+        damaged = data;
+        std::memcpy(&entry, damaged.data() + sizeof(PackFormat::Header), sizeof(entry));
+        entry.offset = UINT64_MAX - 4;
+        entry.size = 8;
+        std::memcpy(damaged.data() + sizeof(PackFormat::Header), &entry, sizeof(entry));
+        REQUIRE(rejects(damaged));
+    }
+
+    SECTION("Opens packs written by SDG_ContentPipe")
+    {
+        const std::string sourcePath = packPath + ".source";
+        const std::string writtenPath = packPath + ".written";
+        std::ofstream(sourcePath, std::ios::binary) << "written";
+
+        ContentPipe::PackWriter writer;
+        writer.Add("img/written.sdgc", sourcePath, 1);
+        std::string error;
+        REQUIRE(writer.Write(writtenPath, "", &error));
+        REQUIRE(writer.IsCurrent(writtenPath, ""));
+        REQUIRE(!writer.IsCurrent(writtenPath, "key"));
+
+        {
+            Pack pack(Path(writtenPath.c_str(), Path::BaseDir::None));
+            REQUIRE(pack.EntryCount() == 1);
+
+            Pack::Entry entry;
+            REQUIRE(pack.Find("img/written.sdgc", &entry));
+            REQUIRE(entry.size == 7);
+            REQUIRE(std::memcmp(entry.data, "written", 7) == 0);
+            REQUIRE(!entry.encrypted);
+        }
+
+        std::filesystem::remove(sourcePath);
+        std::filesystem::remove(writtenPath);
+    }
+
+    SECTION("Mounted packs are found under their mount point")
+    {
+        Pack pack(Path(packPath.c_str(), Path::BaseDir::None));
+        Pack::Mount(pack, Path("assets", Path::BaseDir::None));
+
+        Pack::Entry entry;
+        REQUIRE(Pack::FindMounted(Path("assets/data.sdgc", Path::BaseDir::None), &entry));
+        REQUIRE(entry.size == 10);
+        REQUIRE(!Pack::FindMounted(Path("assetsdata.sdgc", Path::BaseDir::None), &entry));
+        REQUIRE(!Pack::FindMounted(Path("other/data.sdgc", Path::BaseDir::None), &entry));
+
+        Pack::Unmount(pack);
+        REQUIRE(!Pack::FindMounted(Path("assets/data.sdgc", Path::BaseDir::None), &entry));
+    }
+
+    std::filesystem::remove(packPath);
+}
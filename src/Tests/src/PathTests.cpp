@@ -469,6 +469,40 @@ TEST_CASE("Path", "[path]")
         REQUIRE(prefPath1 == prefPath3);
     }
 
+    SECTION("Hash")
+    {
+        SECTION("Equal paths have equal hashes")
+        {
+            REQUIRE(BasePath("img/player.png").Hash() == BasePath("/img/player.png/").Hash());
+            REQUIRE(Path().Hash() == Path("").Hash());
+        }
+
+        SECTION("Base directory is part of the hash")
+        {
+            REQUIRE(BasePath("img/player.png").Hash() != PrefPath("img/player.png").Hash());
+            REQUIRE(BasePath("img/player.png").Hash() != BasePath("img/player.pnG").Hash());
+        }
+
+        SECTION("Appending updates the hash")
+        {
+            Path path = BasePath("img");
+            path += "player.png";
+            REQUIRE(path.Hash() == BasePath("img/player.png").Hash());
+        }
+
+        SECTION("AssetID literals match Path hashes")
+        {
+            using namespace SDG::Literals;
+            constexpr AssetID id = "img/player.png"_asset;
+            static_assert(id == AssetID("img/player.png"));
+            static_assert(id != "img/enemy.png"_asset);
+
+            REQUIRE(id == AssetID(BasePath("img/player.png")));
+            REQUIRE(id.Value() == BasePath("img/player.png").Hash());
+            REQUIRE(AssetID("a.txt", Path::BaseDir::None) == AssetID(Path("a.txt")));
+        }
+    }
+
     SECTION("Cleanup")
     {
         Path::PopFileSys();
@@ -0,0 +1,132 @@
+/*!
+ * @file SchedulerTests.cpp
+ * Contains tests for SDG::Scheduler, and World::ParallelEach
+ */
+#include "SDG_Tests.h"
+#include <Engine/Game/Scheduler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Position { float x, y; };
+    struct Velocity { float x, y; };
+    struct Health { int value; };
+}
+
+TEST_CASE("SystemAccess conflicts", "[Scheduler]")
+{
+    const auto readPosition = SystemAccess::Of<const Position>();
+    const auto writePosition = SystemAccess::Of<Position, const Velocity>();
+    const auto writeVelocity = SystemAccess().Write<Velocity>();
+    const auto writeHealth = SystemAccess::Of<Health>();
+
+    REQUIRE(!readPosition.ConflictsWith(readPosition));
+    REQUIRE(readPosition.ConflictsWith(writePosition));
+    REQUIRE(writePosition.ConflictsWith(readPosition));
+    REQUIRE(writePosition.ConflictsWith(writeVelocity));
+    REQUIRE(!writeHealth.ConflictsWith(writePosition));
+    REQUIRE(SystemAccess().Exclusive().ConflictsWith(SystemAccess()));
+}
+
+TEST_CASE("Scheduler", "[Scheduler]")
+{
+    World world;
+    JobSystem jobs;
+    jobs.Start(4);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        Entity e = world.CreateEntity();
+        world.Add<Position>(e, 0.f, 0.f);
+        world.Add<Velocity>(e, 1.f, (float)i);
+        if (i % 2 == 0)
+            world.Add<Health>(e, 10);
+    }
+
+    SECTION("Systems run after the earlier systems they conflict with")
+    {
+        Scheduler scheduler;
+        std::mutex mutex;
+        std::vector<std::string> order;
+        auto record = [&](const char *name) {
+            std::lock_guard lock(mutex);
+            order.emplace_back(name);
+        };
+
+        scheduler.Add("move", SystemAccess::Of<Position, const Velocity>(), [&](World &) { record("move"); });
+        scheduler.Add("accelerate", SystemAccess::Of<Velocity>(), [&](World &) { record("accelerate"); });
+        scheduler.Add("heal", SystemAccess::Of<Health>(), [&](World &) { record("heal"); });
+        scheduler.Add("draw", SystemAccess::Of<const Position>(), [&](World &) { record("draw"); });
+
+        REQUIRE(scheduler.DependenciesOf(0).empty());
+        REQUIRE(scheduler.DependenciesOf(1) == std::vector<size_t>{ 0 });
+        REQUIRE(scheduler.DependenciesOf(2).empty());
+        REQUIRE(scheduler.DependenciesOf(3) == std::vector<size_t>{ 0 });
+
+        for (int run = 0; run < 20; ++run)
+        {
+            order.clear();
+            scheduler.Run(world, jobs);
+            REQUIRE(order.size() == 4);
+
+            auto at = [&](const char *name) { return std::find(order.begin(), order.end(), name) - order.begin(); };
+            REQUIRE(at("move") < at("accelerate"));
+            REQUIRE(at("move") < at("draw"));
+        }
+    }
+
+    SECTION("Query systems update every entity, split across workers")
+    {
+        Scheduler scheduler;
+        scheduler.AddEach<Position, const Velocity>("move", [](Position &p, const Velocity &v) {
+            p.x += v.x;
+            p.y += v.y;
+        });
+        scheduler.AddEach<Velocity>("stop", [](Velocity &v) { v.x = 0; });
+        scheduler.AddEach<Health>("hurt", [](Entity, Health &h) { --h.value; });
+
+        scheduler.Run(world, jobs);
+        scheduler.Run(world, jobs);
+
+        size_t count = 0;
+        world.Each<const Position, const Velocity>([&](const Position &p, const Velocity &v) {
+            REQUIRE(p.x == 1.f);     // moved once, then stopped
+            REQUIRE(p.y == v.y * 2);
+            ++count;
+        });
+        REQUIRE(count == 20000);
+        world.Each<const Health>([](const Health &h) { REQUIRE(h.value == 8); });
+    }
+
+    SECTION("Exclusive systems may change the world's structure")
+    {
+        Scheduler scheduler;
+        std::atomic<int> visited(0);
+        scheduler.AddEach<const Position>("count", [&](const Position &) { ++visited; });
+        scheduler.Add("spawn", SystemAccess().Exclusive(), [](World &world) {
+            world.Add<Position>(world.CreateEntity(), 0.f, 0.f);
+        });
+
+        REQUIRE(scheduler.DependenciesOf(1) == std::vector<size_t>{ 0 });
+        scheduler.Run(world, jobs);
+        scheduler.Run(world, jobs);
+        REQUIRE(visited == 20000 + 20001);
+        REQUIRE(world.EntityCount() == 20002);
+    }
+
+    SECTION("ParallelEach visits every chunk")
+    {
+        std::atomic<int> count(0);
+        world.ParallelEach<const Position, Health>(jobs, [&](Entity, const Position &, Health &h) {
+            h.value = 1;
+            ++count;
+        });
+        REQUIRE(count == 10000);
+        REQUIRE(world.Count<Health>() == 10000);
+    }
+}
@@ -0,0 +1,15 @@
+/// Test helper that renders headlessly through a NullRenderBackend
+#pragma once
+#include <Engine/Graphics/NullRenderBackend.h>
+
+namespace SDG::Tests
+{
+    /// Installs a NullRenderBackend for the lifetime of a test
+    struct ScopedNullBackend
+    {
+        ScopedNullBackend() { RenderBackend::Current(&backend); }
+        ~ScopedNullBackend() { RenderBackend::Current(nullptr); }
+
+        NullRenderBackend backend;
+    };
+}
@@ -0,0 +1,677 @@
+/*!
+ * @file SpriteBatchTests.cpp
+ * Contains tests for SDG::BatchGeometry, SDG::BatchSortKey, SDG::BatchRecords, SDG::BatchShapes,
+ * SDG::SpriteBatch::Recorder, and SDG::SpriteBatch benchmarks
+ */
+#include "SDG_Tests.h"
+#include "ScopedNullBackend.h"
+#include <Engine/Game/Graphics/BatchGeometry.h>
+#include <Engine/Game/Graphics/BatchSortKey.h>
+#include <Engine/Game/Graphics/SpriteBatch.h>
+#include <Engine/Game/Graphics/Private/BatchRecords.h>
+#include <Engine/Game/Graphics/Private/BatchShapes.h>
+#include <Engine/Game/Graphics/Private/BatchSorter.h>
+#include <Engine/Graphics/RenderTarget.h>
+#include <Engine/Graphics/Texture.h>
+#include <Engine/Graphics/Window.h>
+
+#include <Engine/Lib/Algorithm.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <SDL_gpu.h>
+#include <SDL_video.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("BatchGeometry tests", "[BatchGeometry]")
+{
+    BatchGeometry geometry;
+    const Vector2 texSize(64.f, 32.f);
+
+    SECTION("Default state is empty")
+    {
+        REQUIRE(geometry.Empty());
+        REQUIRE(geometry.VertexCount() == 0);
+        REQUIRE(geometry.IndexCount() == 0);
+    }
+
+    SECTION("Unrotated quad covers the destination rectangle")
+    {
+        geometry.PushQuad({0, 0, 16, 16}, {10, 20, 32, 64}, 0, {8, 8}, Flip::None,
+            Color(1, 2, 3, 4), texSize);
+
+        REQUIRE(geometry.QuadCount() == 1);
+        REQUIRE(geometry.VertexCount() == 4);
+        REQUIRE(geometry.IndexCount() == 6);
+
+        const BatchVertex *v = geometry.Vertices();
+        REQUIRE((v[0].x == 10 && v[0].y == 20));
+        REQUIRE((v[1].x == 42 && v[1].y == 20));
+        REQUIRE((v[2].x == 42 && v[2].y == 84));
+        REQUIRE((v[3].x == 10 && v[3].y == 84));
+
+        REQUIRE((v[2].r == 1 && v[2].g == 2 && v[2].b == 3 && v[2].a == 4));
+    }
+
+    SECTION("Texture coordinates are normalized by the texture size")
+    {
+        geometry.PushQuad({16, 8, 16, 8}, {0, 0, 16, 8}, 0, {0, 0}, Flip::None,
+            Color::White(), texSize);
+
+        const BatchVertex *v = geometry.Vertices();
+        REQUIRE((v[0].s == .25f && v[0].t == .25f));
+        REQUIRE((v[2].s == .5f && v[2].t == .5f));
+    }
+
+    SECTION("Flip swaps texture coordinates, not positions")
+    {
+        geometry.PushQuad({0, 0, 32, 16}, {0, 0, 32, 16}, 0, {0, 0}, Flip::Both,
+            Color::White(), texSize);
+
+        const BatchVertex *v = geometry.Vertices();
+        REQUIRE((v[0].x == 0 && v[0].y == 0));
+        REQUIRE((v[0].s == .5f && v[0].t == .5f));
+        REQUIRE((v[2].s == 0 && v[2].t == 0));
+    }
+
+    SECTION("Rotation is applied about the scaled anchor")
+    {
+        // 2x scale, so the anchor at source {4, 4} pivots at world {18, 28}
+        geometry.PushQuad({0, 0, 8, 8}, {10, 20, 16, 16}, 90.f, {4, 4}, Flip::None,
+            Color::White(), texSize);
+
+        const BatchVertex *v = geometry.Vertices();
+        REQUIRE(RoundF(v[0].x) == 26.f);
+        REQUIRE(RoundF(v[0].y) == 20.f);
+        REQUIRE(RoundF(v[2].x) == 10.f);
+        REQUIRE(RoundF(v[2].y) == 36.f);
+    }
+
+    SECTION("Indices are offset for each quad")
+    {
+        geometry.PushQuad({0, 0, 1, 1}, {0, 0, 1, 1}, 0, {0, 0}, Flip::None, Color::White(), texSize);
+        geometry.PushQuad({0, 0, 1, 1}, {0, 0, 1, 1}, 0, {0, 0}, Flip::None, Color::White(), texSize);
+
+        REQUIRE(geometry.IndexCount() == 12);
+        REQUIRE(geometry.Indices()[6] == 4);
+        REQUIRE(geometry.Indices()[10] == 7);
+    }
+
+    SECTION("Clear empties the buffer")
+    {
+        geometry.PushQuad({0, 0, 1, 1}, {0, 0, 1, 1}, 0, {0, 0}, Flip::None, Color::White(), texSize);
+        geometry.Clear();
+        REQUIRE(geometry.Empty());
+        REQUIRE(geometry.IndexCount() == 0);
+    }
+}
+
+TEST_CASE("BatchSortKey tests", "[BatchSortKey]")
+{
+    SECTION("QuantizeDepth preserves ordering across signs")
+    {
+        float depths[] = { -1000.f, -1.5f, -1.f, 0, 1.f, 1.5f, 1000.f };
+        for (size_t i = 1; i < std::size(depths); ++i)
+        {
+            REQUIRE(BatchSortKey::QuantizeDepth(depths[i - 1]) < BatchSortKey::QuantizeDepth(depths[i]));
+            REQUIRE(BatchSortKey::QuantizeDepth(depths[i - 1], true) > BatchSortKey::QuantizeDepth(depths[i], true));
+        }
+    }
+
+    SECTION("Negative zero sorts with zero")
+    {
+        REQUIRE(BatchSortKey::QuantizeDepth(-0.f) == BatchSortKey::QuantizeDepth(0.f));
+    }
+
+    SECTION("Depth takes priority over texture, and texture over order")
+    {
+        auto lowDepth = BatchSortKey::Make(BatchSortKey::QuantizeDepth(0), 9, 9);
+        auto highDepth = BatchSortKey::Make(BatchSortKey::QuantizeDepth(1.f), 0, 0);
+        auto lowTexture = BatchSortKey::Make(BatchSortKey::QuantizeDepth(0), 1, 10);
+        auto highTexture = BatchSortKey::Make(BatchSortKey::QuantizeDepth(0), 2, 0);
+
+        REQUIRE(lowDepth < highDepth);
+        REQUIRE(lowTexture < highTexture);
+    }
+
+    SECTION("Order and texture id round trip")
+    {
+        auto key = BatchSortKey::Make(BatchSortKey::QuantizeDepth(5.f), 1234, 56789);
+        REQUIRE(BatchSortKey::Order(key) == 56789);
+        REQUIRE(BatchSortKey::TextureId(key) == 1234);
+    }
+}
+
+TEST_CASE("BatchRecords tests", "[BatchRecords]")
+{
+    BatchRecords records;
+    auto tex1 = (const GPU_Image *)(uintptr_t)0x10;
+    auto tex2 = (const GPU_Image *)(uintptr_t)0x20;
+
+    records.Push(tex1, {0, 0, 1, 1}, {0, 0, 8, 8}, 0, {0, 0}, Flip::None, Color::Red(), 2.f);
+    records.Push(tex2, {1, 1, 1, 1}, {8, 8, 8, 8}, 45.f, {4, 4}, Flip::Both, Color::Blue(), 1.f);
+
+    SECTION("Push fills every array")
+    {
+        REQUIRE(records.Size() == 2);
+        REQUIRE(records.srcs.size() == 2);
+        REQUIRE(records.dests.size() == 2);
+        REQUIRE(records.transforms.size() == 2);
+        REQUIRE(records.colors.size() == 2);
+        REQUIRE(records.depths.size() == 2);
+        REQUIRE(records.transforms[1].flip == Flip::Both);
+    }
+
+    SECTION("Gather reorders by sort key")
+    {
+        uint64_t keys[2] = {
+            BatchSortKey::Make(BatchSortKey::QuantizeDepth(1.f), 0, 1),
+            BatchSortKey::Make(BatchSortKey::QuantizeDepth(2.f), 0, 0)
+        };
+
+        BatchRecords sorted;
+        sorted.Gather(records, keys, 2);
+        REQUIRE(sorted.Size() == 2);
+        REQUIRE(sorted.textures[0] == tex2);
+        REQUIRE(sorted.dests[0] == FRectangle(8, 8, 8, 8));
+        REQUIRE(sorted.colors[0] == Color::Blue());
+        REQUIRE(sorted.depths[1] == 2.f);
+    }
+
+    SECTION("Append adds records after existing ones")
+    {
+        BatchRecords other;
+        other.Push(tex2, {2, 2, 1, 1}, {16, 16, 8, 8}, 0, {0, 0}, Flip::None, Color::Green(), 3.f);
+
+        records.Append(other);
+        REQUIRE(records.Size() == 3);
+        REQUIRE(records.textures[0] == tex1);
+        REQUIRE(records.colors[2] == Color::Green());
+        REQUIRE(records.depths[2] == 3.f);
+    }
+
+    SECTION("Clear keeps capacity")
+    {
+        size_t capacity = records.Capacity();
+        records.Clear();
+        REQUIRE(records.Empty());
+        REQUIRE(records.Capacity() == capacity);
+    }
+
+    SECTION("Append offsets shape references")
+    {
+        BatchShapes::Circle(records, tex1, Circle(0, 0, 4.f), 8, Color::White(), 0);
+
+        BatchRecords other;
+        BatchShapes::Circle(other, tex1, Circle(0, 0, 4.f), 6, Color::White(), 0);
+        other.Push(tex2, {0, 0, 1, 1}, {0, 0, 1, 1}, 0, {0, 0}, Flip::None, Color::Green(), 0);
+
+        records.Append(other);
+        REQUIRE(records.Size() == 5);
+        REQUIRE(records.shapes[0] == BatchRecords::NoShape);
+        REQUIRE(records.shapes[2] == 0);
+        REQUIRE(records.shapes[3] == 1);
+        REQUIRE(records.shapes[4] == BatchRecords::NoShape);
+        REQUIRE(records.shapeRanges[1].firstVertex == 9);
+        REQUIRE(records.shapeRanges[1].vertexCount == 7);
+        REQUIRE(records.shapeRanges[1].firstIndex == 24);
+        REQUIRE(records.shapeVertices.size() == 16);
+    }
+
+    SECTION("Sorting moves shape draws and leaves their geometry in place")
+    {
+        BatchShapes::Circle(records, tex1, Circle(0, 0, 4.f), 8, Color::White(), 0);
+
+        BatchSorter sorter;
+        sorter.Sort(records, SortMode::FrontToBack);
+        REQUIRE(records.Size() == 3);
+        REQUIRE(records.shapes[0] == 0);
+        REQUIRE(records.depths[0] == 0);
+        REQUIRE(records.shapes[1] == BatchRecords::NoShape);
+        REQUIRE(records.shapeRanges.size() == 1);
+        REQUIRE(records.shapeVertices.size() == 9);
+    }
+}
+
+TEST_CASE("BatchShapes tests", "[BatchShapes]")
+{
+    BatchRecords records;
+    auto pixel = (const GPU_Image *)(uintptr_t)0x10;
+
+    auto near = [](float a, float b) { return std::abs(a - b) < 1e-4f; };
+    auto vertex = [&records](size_t shape, size_t i) -> const BatchVertex & {
+        return records.shapeVertices[records.shapeRanges[shape].firstVertex + i];
+    };
+
+    SECTION("Polylines make two vertices per point and two triangles per segment")
+    {
+        const Vector2 points[3] = { {0, 0}, {10, 0}, {20, 0} };
+        FRectangle bounds = BatchShapes::PolylineBounds(points, 3, 2.f);
+        BatchShapes::Polyline(records, pixel, points, 3, 2.f, false, Color::White(), 0, bounds);
+        BatchShapes::Polyline(records, pixel, points, 3, 2.f, true, Color::White(), 0, bounds);
+
+        REQUIRE(records.Size() == 2);
+        REQUIRE(records.shapeRanges[0].vertexCount == 6);
+        REQUIRE(records.shapeRanges[0].indexCount == 12);
+        REQUIRE(records.shapeRanges[1].indexCount == 18);
+        REQUIRE(records.dests[0] == bounds);
+    }
+
+    SECTION("Straight joins keep the line's thickness")
+    {
+        const Vector2 points[3] = { {0, 0}, {10, 0}, {20, 0} };
+        BatchShapes::Polyline(records, pixel, points, 3, 2.f, false, Color::White(), 0, {});
+
+        REQUIRE(near(vertex(0, 2).x, 10.f));
+        REQUIRE(near(vertex(0, 2).y, 1.f));
+        REQUIRE(near(vertex(0, 3).y, -1.f));
+    }
+
+    SECTION("Right angle joins are mitered")
+    {
+        const Vector2 points[3] = { {0, 0}, {10, 0}, {10, 10} };
+        BatchShapes::Polyline(records, pixel, points, 3, 2.f, false, Color::White(), 0, {});
+
+        REQUIRE(near(vertex(0, 2).x, 9.f));
+        REQUIRE(near(vertex(0, 2).y, 1.f));
+        REQUIRE(near(vertex(0, 3).x, 11.f));
+        REQUIRE(near(vertex(0, 3).y, -1.f));
+    }
+
+    SECTION("Repeated points do not break the line")
+    {
+        const Vector2 points[3] = { {0, 0}, {0, 0}, {10, 0} };
+        BatchShapes::Polyline(records, pixel, points, 3, 2.f, false, Color::White(), 0, {});
+
+        for (int i = 0; i < 6; ++i)
+        {
+            REQUIRE(!std::isnan(vertex(0, i).x));
+            REQUIRE(near(std::abs(vertex(0, i).y), 1.f));
+        }
+    }
+
+    SECTION("Filled circles fan out from their center")
+    {
+        BatchShapes::Circle(records, pixel, Circle(5.f, 5.f, 10.f), 8, Color::Red(), 2.f);
+
+        REQUIRE(records.shapeRanges[0].vertexCount == 9);
+        REQUIRE(records.shapeRanges[0].indexCount == 24);
+        REQUIRE(vertex(0, 0).x == 5.f);
+        REQUIRE(near(vertex(0, 1).x, 15.f));
+        REQUIRE(near(vertex(0, 3).y, 15.f));
+        REQUIRE(records.shapeIndices.back() == 1); // last triangle closes the fan
+        REQUIRE(records.dests[0] == FRectangle(-5.f, -5.f, 20.f, 20.f));
+        REQUIRE(records.colors[0] == Color::Red());
+        REQUIRE(records.depths[0] == 2.f);
+    }
+
+    SECTION("Circle outlines span their thickness about the edge")
+    {
+        BatchShapes::CircleOutline(records, pixel, Circle(0, 0, 10.f), 16, 2.f, Color::White(), 0);
+
+        REQUIRE(records.shapeRanges[0].vertexCount == 32);
+        REQUIRE(records.shapeRanges[0].indexCount == 96);
+        REQUIRE(near(vertex(0, 0).x, 11.f));
+        REQUIRE(near(vertex(0, 1).x, 9.f));
+    }
+
+    SECTION("Convex polygons fan out from their first point")
+    {
+        const Vector2 points[4] = { {0, 0}, {10, 0}, {10, 10}, {0, 10} };
+        BatchShapes::ConvexPolygon(records, pixel, points, 4, Color::White(), 0, BatchShapes::Bounds(points, 4, 0));
+
+        REQUIRE(records.shapeRanges[0].vertexCount == 4);
+        REQUIRE(records.shapeRanges[0].indexCount == 6);
+        REQUIRE(records.shapeIndices[3] == 0);
+        REQUIRE(records.shapeIndices[5] == 3);
+        REQUIRE(records.dests[0] == FRectangle(0, 0, 10, 10));
+    }
+
+    SECTION("Circle segments grow with radius, within limits")
+    {
+        REQUIRE(BatchShapes::CircleSegments(0) == 8);
+        REQUIRE(BatchShapes::CircleSegments(10.f) < BatchShapes::CircleSegments(100.f));
+        REQUIRE(BatchShapes::CircleSegments(1e6f) == BatchShapes::MaxCircleSegments);
+    }
+
+    SECTION("Geometry runs combine quads and shapes of one texture")
+    {
+        GPU_Image image{};
+        image.texture_w = 2;
+        image.texture_h = 2;
+
+        records.Push(&image, {0, 0, 1, 1}, {0, 0, 1, 1}, 0, {0, 0}, Flip::None, Color::White(), 0);
+        BatchShapes::Circle(records, &image, Circle(0, 0, 4.f), 8, Color::White(), 0);
+        records.Push(&image, {0, 0, 1, 1}, {0, 0, 1, 1}, 0, {0, 0}, Flip::None, Color::White(), 0);
+
+        BatchGeometry geometry;
+        REQUIRE(geometry.PushTextureRun(records, 0) == 3);
+        REQUIRE(geometry.VertexCount() == 4 + 9 + 4);
+        REQUIRE(geometry.IndexCount() == 6 + 24 + 6);
+        REQUIRE(geometry.Indices()[6] == 4); // shape indices follow the first quad
+        REQUIRE(geometry.Vertices()[4].s == .25f); // pixel center, normalized
+
+        geometry.Clear();
+        REQUIRE(geometry.PushShapeRun(records, 1) == 2);
+        REQUIRE(geometry.VertexCount() == 9);
+    }
+}
+
+TEST_CASE("SpriteBatch::Recorder tests", "[SpriteBatch]")
+{
+    ScopedNullBackend scope;
+    SpriteBatch batch;
+    REQUIRE(batch.Initialize(nullptr));
+
+    SECTION("Draws are recorded and cleared")
+    {
+        SpriteBatch::Recorder recorder(batch);
+        recorder.DrawRectangle({0, 0, 8, 8}, {0, 0}, Color::White());
+        recorder.DrawLine({0, 0}, {8, 8}, 1.f, Color::White(), 0);
+        REQUIRE(recorder.Size() == 2);
+
+        recorder.Clear();
+        REQUIRE(recorder.Size() == 0);
+    }
+
+    SECTION("Lines of fewer than two points draw nothing")
+    {
+        SpriteBatch::Recorder recorder(batch);
+        recorder.DrawLines({}, 1.f, Color::White(), 0);
+        recorder.DrawLines({{0, 0}}, 1.f, Color::White(), 0);
+        REQUIRE(recorder.Size() == 0);
+    }
+
+    SECTION("Recorders fill independently on worker threads")
+    {
+        const int ThreadCount = 4, DrawsPerThread = 1000;
+
+        std::vector<SpriteBatch::Recorder> recorders;
+        for (int i = 0; i < ThreadCount; ++i)
+            recorders.emplace_back(batch);
+
+        std::vector<std::thread> threads;
+        for (auto &recorder : recorders)
+        {
+            threads.emplace_back([&recorder] {
+                for (int i = 0; i < DrawsPerThread; ++i)
+                    recorder.DrawRectangle({(float)i, 0, 1, 1}, {0, 0}, Color::White(), 0, (float)i);
+            });
+        }
+
+        for (auto &thread : threads)
+            thread.join();
+
+        for (auto &recorder : recorders)
+            REQUIRE(recorder.Size() == DrawsPerThread);
+    }
+
+    SECTION("Draws outside of the cull rectangle are rejected")
+    {
+        SpriteBatch::Recorder recorder(batch);
+        recorder.CullRect({0, 0, 100, 100});
+
+        recorder.DrawRectangle({10, 10, 8, 8}, {0, 0}, Color::White());     // inside
+        recorder.DrawRectangle({96, 96, 8, 8}, {0, 0}, Color::White());     // overlapping an edge
+        recorder.DrawRectangle({200, 10, 8, 8}, {0, 0}, Color::White());    // right of view
+        recorder.DrawRectangle({10, -50, 8, 8}, {0, 0}, Color::White());    // above view
+        REQUIRE(recorder.Size() == 2);
+        REQUIRE(recorder.CulledCount() == 2);
+
+        recorder.ClearCullRect();
+        recorder.DrawRectangle({200, 10, 8, 8}, {0, 0}, Color::White());
+        REQUIRE(recorder.Size() == 3);
+
+        recorder.Clear();
+        REQUIRE(recorder.CulledCount() == 0);
+    }
+
+    SECTION("Rotated draws are culled by their bounds about the pivot")
+    {
+        SpriteBatch::Recorder recorder(batch);
+        recorder.CullRect({0, 0, 100, 100});
+
+        // A long bar just left of view, that swings into it when rotated about its left end
+        recorder.DrawRectangle({-60, 40, 50, 4}, {1.f, .5f}, Color::White(), 0);
+        recorder.DrawRectangle({-60, 40, 50, 4}, {1.f, .5f}, Color::White(), 180.f);
+        REQUIRE(recorder.Size() == 1);
+        REQUIRE(recorder.CulledCount() == 1);
+    }
+
+    SECTION("Shapes record one draw each")
+    {
+        SpriteBatch::Recorder recorder(batch);
+        const Vector2 points[4] = { {0, 0}, {10, 0}, {10, 10}, {0, 10} };
+
+        recorder.DrawLines(points, 4, 1.f, Color::White(), 0);
+        recorder.DrawPolygon(points, 4, Color::White());
+        recorder.DrawPolygonOutline(points, 4, 1.f, Color::White());
+        recorder.DrawCircle({5, 5, 5}, Color::White());
+        recorder.DrawCircleOutline({5, 5, 5}, 1.f, Color::White());
+        REQUIRE(recorder.Size() == 5);
+
+        recorder.DrawPolygon(points, 2, Color::White());
+        REQUIRE(recorder.Size() == 5);
+    }
+
+    SECTION("Shapes outside of the cull rectangle are rejected")
+    {
+        SpriteBatch::Recorder recorder(batch);
+        recorder.CullRect({0, 0, 100, 100});
+
+        const Vector2 inside[2] = { {10, 10}, {20, 20} }, outside[2] = { {200, 10}, {300, 10} };
+        recorder.DrawLines(inside, 2, 1.f, Color::White(), 0);
+        recorder.DrawLines(outside, 2, 1.f, Color::White(), 0);
+        recorder.DrawCircle({-20, 50, 10}, Color::White());        // left of view
+        recorder.DrawCircleOutline({-10, 50, 10}, 4.f, Color::White()); // outline reaches into view
+        REQUIRE(recorder.Size() == 2);
+        REQUIRE(recorder.CulledCount() == 2);
+    }
+
+    SECTION("Long open lines are split, long closed lines throw")
+    {
+        SpriteBatch::Recorder recorder(batch);
+        std::vector<Vector2> points(BatchShapes::MaxPolylinePoints + 10);
+        for (size_t i = 0; i < points.size(); ++i)
+            points[i] = Vector2((float)i, 0);
+
+        recorder.DrawLines(points, 1.f, Color::White(), 0);
+        REQUIRE(recorder.Size() == 2);
+        REQUIRE_THROWS(recorder.DrawLines(points.data(), points.size(), 1.f, Color::White(), 0, true));
+    }
+
+    SECTION("Submit outside of Begin and End throws")
+    {
+        SpriteBatch::Recorder recorder(batch);
+        REQUIRE_THROWS(batch.Submit(recorder));
+    }
+}
+
+// Stand-in for the array-of-structs draw record SpriteBatch used to stable_sort
+struct BenchDrawRecord
+{
+    const void *texture;
+    float src[4];
+    float dest[4];
+    float rotation;
+    float anchor[2];
+    uint8_t color[4];
+    int flip;
+    float depth;
+};
+
+TEST_CASE("SpriteBatch sort benchmarks", "[SpriteBatch][!benchmark]")
+{
+    const size_t count = GENERATE(1000, 10000, 100000);
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> depthDist(-64, 64);
+    std::uniform_int_distribution<int> textureDist(0, 7);
+
+    std::vector<BenchDrawRecord> records(count);
+    for (auto &r : records)
+    {
+        r.texture = (const void *)(uintptr_t)(textureDist(rng) * 64 + 64);
+        r.depth = (float)depthDist(rng);
+    }
+
+    BENCHMARK("stable_sort records by depth then texture: " + std::to_string(count))
+    {
+        auto sorted = records;
+        std::stable_sort(sorted.begin(), sorted.end(),
+            [](const BenchDrawRecord &a, const BenchDrawRecord &b) {
+                return a.depth < b.depth || (a.depth == b.depth && a.texture < b.texture);
+            });
+        return sorted.size();
+    };
+
+    BatchRecords soaRecords, soaSorted;
+    for (const auto &r : records)
+    {
+        soaRecords.Push((const GPU_Image *)r.texture, {}, {}, 0, {}, Flip::None, Color::White(), r.depth);
+    }
+    std::vector<uint64_t> keys(count), scratch(count);
+
+    BENCHMARK("radix sort keys by depth then texture, then gather arrays: " + std::to_string(count))
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            keys[i] = BatchSortKey::Make(BatchSortKey::QuantizeDepth(soaRecords.depths[i]),
+                (uint32_t)((uintptr_t)soaRecords.textures[i] >> 6), (uint32_t)i);
+        }
+
+        RadixSort(keys.data(), scratch.data(), count);
+
+        soaSorted.Gather(soaRecords, keys.data(), count);
+        return soaSorted.Size();
+    };
+}
+
+// Debug overlay workload: many small collision outlines, submitted headlessly in geometry mode
+TEST_CASE("SpriteBatch shape benchmarks", "[SpriteBatch][!benchmark]")
+{
+    const int ShapeCount = 2000, PointCount = 10;
+
+    ScopedNullBackend scope;
+    scope.backend.Log().RecordCommands(false);
+    RenderTarget target(scope.backend.CreateTarget(640, 480));
+
+    SpriteBatch batch;
+    REQUIRE(batch.Initialize(nullptr));
+    batch.Reserve(ShapeCount * PointCount);
+
+    std::vector<Vector2> points(ShapeCount * PointCount);
+    for (size_t i = 0; i < points.size(); ++i)
+        points[i] = Vector2((float)(i % 640), (float)((i * 7) % 480));
+
+    BENCHMARK("2000 polylines of 10 points as line quads")
+    {
+        batch.Begin(target, nullptr, SortMode::None, SubmitMode::Geometry);
+        for (int shape = 0; shape < ShapeCount; ++shape)
+        {
+            const Vector2 *line = points.data() + shape * PointCount;
+            for (int i = 0; i + 1 < PointCount; ++i)
+                batch.DrawLine(line[i], line[i + 1], 1.f, Color::White(), 0);
+        }
+        batch.End();
+        return batch.SubmittedCount();
+    };
+
+    BENCHMARK("2000 polylines of 10 points as shapes")
+    {
+        batch.Begin(target, nullptr, SortMode::None, SubmitMode::Geometry);
+        for (int shape = 0; shape < ShapeCount; ++shape)
+            batch.DrawLines(points.data() + shape * PointCount, PointCount, 1.f, Color::White(), 0);
+        batch.End();
+        return batch.SubmittedCount();
+    };
+
+    BENCHMARK("2000 circle outlines")
+    {
+        batch.Begin(target, nullptr, SortMode::None, SubmitMode::Geometry);
+        for (int shape = 0; shape < ShapeCount; ++shape)
+            batch.DrawCircleOutline({points[shape], 8.f}, 1.f, Color::White());
+        batch.End();
+        return batch.SubmittedCount();
+    };
+}
+
+// Throughput in sprites/ms is SpriteCount divided by the mean time in ms
+TEST_CASE("SpriteBatch benchmarks", "[SpriteBatch][!benchmark]")
+{
+    const int SpriteCount = 20000;
+
+    BENCHMARK("BatchGeometry: 20000 rotated quads")
+    {
+        static BatchGeometry geometry;
+        geometry.Clear();
+        for (int i = 0; i < SpriteCount; ++i)
+        {
+            geometry.PushQuad({0, 0, 16, 16}, {(float)(i % 640), (float)(i % 480), 16, 16}, (float)i,
+                {8, 8}, Flip::None, Color::White(), {16.f, 16.f});
+            if (geometry.Full())
+                geometry.Clear();
+        }
+        return geometry.VertexCount();
+    };
+
+    Window::StandaloneMode(true);
+    Window window;
+    REQUIRE(window.Initialize(640, 480, "SpriteBatch Benchmark", SDL_WINDOW_HIDDEN));
+
+    const uint8_t pixels[16 * 16 * 4]{};
+    Texture texture;
+    REQUIRE(texture.LoadPixels(&window, 16, 16, pixels));
+
+    SpriteBatch batch;
+    REQUIRE(batch.Initialize(window));
+
+    auto drawAll = [&](SubmitMode mode) {
+        batch.Begin(nullptr, nullptr, SortMode::None, mode);
+        for (int i = 0; i < SpriteCount; ++i)
+            batch.DrawTexture(&texture, {(float)(i % 640), (float)(i % 480)}, {1.f, 1.f}, {.5f, .5f}, (float)i);
+        batch.End();
+    };
+
+    BENCHMARK("SpriteBatch Blit: 20000 sprites")
+    {
+        drawAll(SubmitMode::Blit);
+    };
+
+    BENCHMARK("SpriteBatch Geometry: 20000 sprites")
+    {
+        drawAll(SubmitMode::Geometry);
+    };
+
+    const int ThreadCount = 4;
+    std::vector<SpriteBatch::Recorder> recorders;
+    for (int i = 0; i < ThreadCount; ++i)
+        recorders.emplace_back(batch);
+
+    BENCHMARK("SpriteBatch Geometry, 4 recording threads: 20000 sprites")
+    {
+        batch.Begin(nullptr, nullptr, SortMode::None, SubmitMode::Geometry);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < ThreadCount; ++t)
+        {
+            threads.emplace_back([&, t] {
+                for (int i = t; i < SpriteCount; i += ThreadCount)
+                    recorders[t].DrawTexture(&texture, {(float)(i % 640), (float)(i % 480)}, {1.f, 1.f}, {.5f, .5f}, (float)i);
+            });
+        }
+
+        for (int t = 0; t < ThreadCount; ++t)
+        {
+            threads[t].join();
+            batch.Submit(recorders[t]);
+        }
+
+        batch.End();
+    };
+}
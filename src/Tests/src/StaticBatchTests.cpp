@@ -0,0 +1,108 @@
+/*!
+ * @file StaticBatchTests.cpp
+ * Contains tests for class SDG::StaticBatch
+ */
+#include "SDG_Tests.h"
+#include <Engine/Game/Graphics/StaticBatch.h>
+#include <Engine/Graphics/Texture.h>
+#include <Engine/Graphics/Window.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <SDL_video.h>
+
+TEST_CASE("StaticBatch tests", "[StaticBatch]")
+{
+    Window::StandaloneMode(true);
+    Window window;
+    REQUIRE(window.Initialize(320, 240, "StaticBatch Test", SDL_WINDOW_HIDDEN));
+
+    const uint8_t pixels[8 * 8 * 4]{};
+    Texture textureA, textureB;
+    REQUIRE(textureA.LoadPixels(&window, 8, 8, pixels));
+    REQUIRE(textureB.LoadPixels(&window, 8, 8, pixels));
+
+    SpriteBatch spriteBatch;
+    REQUIRE(spriteBatch.Initialize(window));
+
+    SpriteBatch::Recorder recorder(spriteBatch);
+    StaticBatch batch;
+
+    SECTION("Default state is empty")
+    {
+        REQUIRE(batch.Empty());
+        REQUIRE(batch.DrawCount() == 0);
+        REQUIRE(batch.DrawCallCount() == 0);
+        REQUIRE_NOTHROW(batch.Draw());
+    }
+
+    SECTION("Build bakes one draw call per texture run")
+    {
+        // Interleaved textures at equal depth are grouped by texture sorting
+        for (int i = 0; i < 10; ++i)
+            recorder.DrawTexture(i % 2 ? &textureA : &textureB, {(float)i * 8, 0});
+
+        batch.Build(recorder, SortMode::Texture);
+        REQUIRE(batch.DrawCount() == 10);
+        REQUIRE(batch.DrawCallCount() == 2);
+        REQUIRE(recorder.Size() == 10); // recorder is left untouched
+        REQUIRE_NOTHROW(batch.Draw());
+    }
+
+    SECTION("Rebuilding replaces contents")
+    {
+        recorder.DrawRectangle({0, 0, 8, 8}, {0, 0}, Color::White());
+        batch.Build(recorder);
+        recorder.Clear();
+
+        recorder.DrawRectangle({0, 0, 8, 8}, {0, 0}, Color::White());
+        recorder.DrawRectangle({8, 0, 8, 8}, {0, 0}, Color::White());
+        batch.Build(recorder);
+        REQUIRE(batch.DrawCount() == 2);
+        REQUIRE(batch.DrawCallCount() == 1);
+    }
+
+    SECTION("Clear empties the batch")
+    {
+        recorder.DrawRectangle({0, 0, 8, 8}, {0, 0}, Color::White());
+        batch.Build(recorder);
+        batch.Clear();
+        REQUIRE(batch.Empty());
+        REQUIRE(batch.DrawCount() == 0);
+    }
+}
+
+TEST_CASE("StaticBatch benchmarks", "[StaticBatch][!benchmark]")
+{
+    const int SpriteCount = 20000;
+
+    Window::StandaloneMode(true);
+    Window window;
+    REQUIRE(window.Initialize(640, 480, "StaticBatch Benchmark", SDL_WINDOW_HIDDEN));
+
+    const uint8_t pixels[16 * 16 * 4]{};
+    Texture texture;
+    REQUIRE(texture.LoadPixels(&window, 16, 16, pixels));
+
+    SpriteBatch spriteBatch;
+    REQUIRE(spriteBatch.Initialize(window));
+
+    SpriteBatch::Recorder recorder(spriteBatch);
+    for (int i = 0; i < SpriteCount; ++i)
+        recorder.DrawTexture(&texture, {(float)(i % 640), (float)(i % 480)}, {1.f, 1.f}, {.5f, .5f}, (float)i, (float)(i % 16));
+
+    BENCHMARK("SpriteBatch resubmitting 20000 sprites")
+    {
+        spriteBatch.Begin(nullptr, nullptr, SortMode::FrontToBack, SubmitMode::Geometry);
+        for (int i = 0; i < SpriteCount; ++i)
+            spriteBatch.DrawTexture(&texture, {(float)(i % 640), (float)(i % 480)}, {1.f, 1.f}, {.5f, .5f}, (float)i, (float)(i % 16));
+        spriteBatch.End();
+    };
+
+    StaticBatch batch;
+    batch.Build(recorder);
+
+    BENCHMARK("StaticBatch replaying 20000 sprites")
+    {
+        batch.Draw();
+    };
+}
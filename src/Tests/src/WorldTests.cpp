@@ -0,0 +1,339 @@
+/*!
+ * @file WorldTests.cpp
+ * Contains tests for SDG::World, the Archetype and sparse set storage under it, and Entity handles
+ */
+#include "SDG_Tests.h"
+#include <Engine/Game/World.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Position { float x, y; };
+struct Velocity { float x, y; };
+struct Name { std::string value; };
+struct Stunned { static constexpr bool SparseStorage = true; float time; };
+struct Poisoned { static constexpr bool SparseStorage = true; int damage; };
+
+/// Counts live instances, to check that components are destroyed exactly once
+struct Tracked
+{
+    static inline int live = 0;
+    explicit Tracked(int value = 0) : value(std::make_unique<int>(value)) { ++live; }
+    Tracked(Tracked &&other) noexcept : value(std::move(other.value)) { ++live; }
+    Tracked &operator=(Tracked &&other) noexcept { value = std::move(other.value); return *this; }
+    ~Tracked() { --live; }
+    std::unique_ptr<int> value;
+};
+
+TEST_CASE("World components", "[World]")
+{
+    World world;
+
+    SECTION("Add, get, and remove components")
+    {
+        Entity e = world.CreateEntity();
+        REQUIRE(world.IsAlive(e));
+        REQUIRE(world.Get<Position>(e) == nullptr);
+
+        world.Add<Position>(e, 1.f, 2.f);
+        world.Add<Name>(e, "bat");
+        REQUIRE(world.Has<Position>(e));
+        REQUIRE(world.Get<Position>(e)->y == 2.f);
+        REQUIRE(world.Get<Name>(e)->value == "bat");
+        REQUIRE(!world.Has<Velocity>(e));
+
+        REQUIRE(world.Remove<Position>(e));
+        REQUIRE(!world.Remove<Position>(e));
+        REQUIRE(!world.Has<Position>(e));
+        REQUIRE(world.Get<Name>(e)->value == "bat");
+    }
+
+    SECTION("Adding a component an entity has replaces it")
+    {
+        Entity e = world.CreateEntity();
+        world.Add<Name>(e, "a");
+        world.Add<Name>(e, "b");
+        REQUIRE(world.Get<Name>(e)->value == "b");
+        REQUIRE(world.Count<Name>() == 1);
+    }
+
+    SECTION("Entities with the same components share an archetype")
+    {
+        const size_t before = world.ArchetypeCount();
+        for (int i = 0; i < 10; ++i)
+        {
+            Entity e = world.CreateEntity();
+            world.Add<Position>(e);
+            world.Add<Velocity>(e);
+        }
+
+        // {Position}, {Position, Velocity}
+        REQUIRE(world.ArchetypeCount() == before + 2);
+
+        Entity e = world.CreateEntity();
+        world.Add<Velocity>(e);
+        world.Add<Position>(e);
+        REQUIRE(world.ArchetypeCount() == before + 3);
+    }
+
+    SECTION("Destroying an entity keeps the others' components")
+    {
+        std::vector<Entity> entities;
+        for (int i = 0; i < 5; ++i)
+        {
+            entities.push_back(world.CreateEntity());
+            world.Add<Name>(entities.back(), std::to_string(i));
+        }
+
+        world.DestroyEntity(entities[1]);
+        REQUIRE(!world.IsAlive(entities[1]));
+        REQUIRE(world.Get<Name>(entities[1]) == nullptr);
+        REQUIRE(world.EntityCount() == 4);
+        for (int i : { 0, 2, 3, 4 })
+            REQUIRE(world.Get<Name>(entities[i])->value == std::to_string(i));
+
+        Entity reused = world.CreateEntity();
+        REQUIRE(world.IsAlive(reused));
+        REQUIRE(!world.Has<Name>(reused));
+    }
+
+    SECTION("Handles to destroyed entities stay invalid when their slot is reused")
+    {
+        Entity first = world.CreateEntity();
+        world.Add<Name>(first, "first");
+        world.DestroyEntity(first);
+
+        Entity second = world.CreateEntity();
+        REQUIRE(second.Index() == first.Index());
+        REQUIRE(second.Generation() == first.Generation() + 1);
+        REQUIRE(second != first);
+        REQUIRE(!world.IsAlive(first));
+        REQUIRE(world.IsAlive(second));
+
+        world.Add<Name>(second, "second");
+        REQUIRE(world.Get<Name>(first) == nullptr);
+        REQUIRE(!world.Remove<Name>(first));
+        world.DestroyEntity(first);
+        REQUIRE(world.Get<Name>(second)->value == "second");
+
+        bool threw = false;
+        try {
+            world.Add<Position>(first);
+        }
+        catch (const InvalidArgumentException &)
+        {
+            threw = true;
+        }
+        REQUIRE(threw);
+        REQUIRE(!world.IsAlive(Entity::Null));
+    }
+
+    SECTION("Clear invalidates every handle")
+    {
+        Entity e = world.CreateEntity();
+        world.Add<Stunned>(e, 1.f);
+        world.Clear();
+        REQUIRE(world.EntityCount() == 0);
+        REQUIRE(!world.IsAlive(e));
+
+        Entity next = world.CreateEntity();
+        REQUIRE(next != e);
+        REQUIRE(!world.Has<Stunned>(next));
+    }
+
+    SECTION("Sparse components are added and removed without changing archetype")
+    {
+        Entity e = world.CreateEntity();
+        world.Add<Position>(e, 3.f, 4.f);
+        const size_t archetypes = world.ArchetypeCount();
+        Position *position = world.Get<Position>(e);
+
+        world.Add<Stunned>(e, 2.f);
+        REQUIRE(world.Has<Stunned>(e));
+        REQUIRE(world.Get<Stunned>(e)->time == 2.f);
+        REQUIRE(world.ArchetypeCount() == archetypes);
+        REQUIRE(world.Get<Position>(e) == position);
+
+        world.Add<Stunned>(e, 5.f);
+        REQUIRE(world.Get<Stunned>(e)->time == 5.f);
+        REQUIRE(world.Remove<Stunned>(e));
+        REQUIRE(!world.Remove<Stunned>(e));
+        REQUIRE(!world.Has<Stunned>(e));
+        REQUIRE(world.Get<Position>(e) == position);
+    }
+
+    SECTION("Destroying an entity removes its sparse components")
+    {
+        Entity a = world.CreateEntity(), b = world.CreateEntity();
+        world.Add<Stunned>(a, 1.f);
+        world.Add<Stunned>(b, 2.f);
+        world.DestroyEntity(a);
+        REQUIRE(world.Count<Stunned>() == 1);
+        REQUIRE(world.Get<Stunned>(b)->time == 2.f);
+
+        Entity reused = world.CreateEntity();
+        REQUIRE(reused.Index() == a.Index());
+        REQUIRE(!world.Has<Stunned>(reused));
+    }
+
+    SECTION("Components are destroyed once, as entities move between archetypes and are destroyed")
+    {
+        Tracked::live = 0;
+        {
+            World tracked;
+            std::vector<Entity> entities;
+            for (int i = 0; i < 100; ++i)
+            {
+                entities.push_back(tracked.CreateEntity());
+                tracked.Add<Tracked>(entities.back(), i);
+            }
+            REQUIRE(Tracked::live == 100);
+
+            for (int i = 0; i < 100; i += 2)
+                tracked.Add<Position>(entities[i]);
+            for (int i = 0; i < 100; i += 3)
+                tracked.DestroyEntity(entities[i]);
+            REQUIRE(Tracked::live == 66);
+
+            for (int i = 1; i < 100; ++i)
+            {
+                if (i % 3 != 0)
+                    REQUIRE(*tracked.Get<Tracked>(entities[i])->value == i);
+            }
+
+            tracked.Remove<Tracked>(entities[1]);
+            REQUIRE(Tracked::live == 65);
+        }
+        REQUIRE(Tracked::live == 0);
+    }
+}
+
+TEST_CASE("World queries", "[World]")
+{
+    World world;
+
+    // More entities than fit in one chunk
+    std::vector<Entity> entities;
+    for (int i = 0; i < 3000; ++i)
+    {
+        Entity e = world.CreateEntity();
+        world.Add<Position>(e, (float)i, 0.f);
+        if (i % 2 == 0)
+            world.Add<Velocity>(e, 1.f, 2.f);
+        if (i % 3 == 0)
+            world.Add<Name>(e, "named");
+        entities.push_back(e);
+    }
+
+    SECTION("Each visits every entity that has all of the query's components")
+    {
+        REQUIRE(world.Count<Position>() == 3000);
+        REQUIRE(world.Count<Position, Velocity>() == 1500);
+        REQUIRE(world.Count<Velocity, Name>() == 500);
+
+        world.Each<Position, const Velocity>([](Position &position, const Velocity &velocity) {
+            position.x += velocity.x;
+            position.y += velocity.y;
+        });
+
+        for (int i = 0; i < 3000; ++i)
+        {
+            const Position *position = world.Get<Position>(entities[i]);
+            REQUIRE(position->x == (float)i + (i % 2 == 0 ? 1.f : 0.f));
+            REQUIRE(position->y == (i % 2 == 0 ? 2.f : 0.f));
+        }
+    }
+
+    SECTION("Each can take the entity")
+    {
+        size_t count = 0;
+        world.Each<const Name>([&](Entity entity, const Name &) {
+            REQUIRE(world.Get<Position>(entity)->x == (float)entity.Index());
+            ++count;
+        });
+        REQUIRE(count == 1000);
+    }
+
+    SECTION("EachChunk visits contiguous arrays of components")
+    {
+        size_t count = 0, chunks = 0;
+        world.EachChunk<const Position, Velocity>([&](size_t size, const Entity *ids, const Position *positions,
+            Velocity *velocities) {
+            for (size_t i = 0; i < size; ++i)
+            {
+                REQUIRE(positions[i].x == (float)ids[i].Index());
+                velocities[i].x = 0;
+            }
+            count += size;
+            ++chunks;
+        });
+
+        REQUIRE(count == 1500);
+        REQUIRE(chunks > 1);
+        world.Each<const Velocity>([](const Velocity &velocity) { REQUIRE(velocity.x == 0); });
+    }
+
+    SECTION("Queries mix archetype and sparse components")
+    {
+        for (int i = 0; i < 3000; i += 5)
+            world.Add<Stunned>(entities[i], (float)i);
+        for (int i = 0; i < 3000; i += 4)
+            world.Add<Poisoned>(entities[i], 1);
+
+        REQUIRE(world.Count<Stunned>() == 600);
+        REQUIRE(world.Count<Stunned, Poisoned>() == 150);
+        REQUIRE(world.Count<Velocity, Stunned>() == 300);
+
+        size_t count = 0;
+        world.Each<const Position, Stunned>([&](Entity entity, const Position &position, Stunned &stunned) {
+            REQUIRE(position.x == stunned.time);
+            REQUIRE(entity.Index() % 5 == 0);
+            stunned.time = -1;
+            ++count;
+        });
+        REQUIRE(count == 600);
+
+        world.Each<const Stunned, const Poisoned>([&](Entity entity, const Stunned &stunned, const Poisoned &) {
+            REQUIRE(stunned.time == -1);
+            REQUIRE(entity.Index() % 20 == 0);
+        });
+    }
+}
+
+TEST_CASE("SparseSet", "[World]")
+{
+    SparseSet set;
+    ComponentSet<int> numbers;
+
+    SECTION("Entities are found by index and generation")
+    {
+        for (uint32_t i = 0; i < 3000; i += 3)
+            numbers.Emplace(Entity(i, 1), (int)i);
+
+        REQUIRE(numbers.Size() == 1000);
+        REQUIRE(*numbers.Find(Entity(2997, 1)) == 2997);
+        REQUIRE(numbers.Find(Entity(2997, 2)) == nullptr);
+        REQUIRE(numbers.Find(Entity(2998, 1)) == nullptr);
+        REQUIRE(numbers.Find(Entity(100000, 1)) == nullptr);
+        REQUIRE(!set.Contains(Entity(0, 0)));
+    }
+
+    SECTION("Removal keeps the dense arrays packed and parallel")
+    {
+        for (uint32_t i = 0; i < 10; ++i)
+            numbers.Emplace(Entity(i, 0), (int)i);
+
+        REQUIRE(numbers.Remove(Entity(0, 0)));
+        REQUIRE(numbers.Remove(Entity(5, 0)));
+        REQUIRE(!numbers.Remove(Entity(5, 0)));
+        REQUIRE(numbers.Size() == 8);
+
+        for (size_t i = 0; i < numbers.Size(); ++i)
+            REQUIRE(numbers.Components()[i] == (int)numbers.Entities()[i].Index());
+
+        numbers.Clear();
+        REQUIRE(numbers.Empty());
+        REQUIRE(!numbers.Contains(Entity(1, 0)));
+    }
+}